@@ -717,6 +717,29 @@ void example_bfv_performance_custom()
     bfv_performance_test(parms);
 }
 
+/*
+Runs the BFV performance test side by side with the same test for BGV, which supports the same operations on
+batched plaintexts. BGV ciphertexts are kept in NTT form, so multiplication and relinearization avoid the base
+conversions of BFV, while encryption pays for the extra NTTs of the plaintext.
+*/
+void example_bgv_performance_default()
+{
+    print_example_banner("BGV vs. BFV Performance Test with Degrees: 4096, 8192, and 16384");
+
+    for (size_t poly_modulus_degree : { 4096, 8192, 16384 })
+    {
+        for (auto scheme : { scheme_type::bfv, scheme_type::bgv })
+        {
+            EncryptionParameters parms(scheme);
+            parms.set_poly_modulus_degree(poly_modulus_degree);
+            parms.set_coeff_modulus(CoeffModulus::BFVDefault(poly_modulus_degree));
+            parms.set_plain_modulus(786433);
+            bfv_performance_test(parms);
+            cout << endl;
+        }
+    }
+}
+
 void example_ckks_performance_default()
 {
     print_example_banner("CKKS Performance Test with Degrees: 4096, 8192, and 16384");
@@ -778,6 +801,89 @@ void example_ckks_performance_custom()
     ckks_performance_test(parms);
 }
 
+void example_ckks_bootstrapping_performance()
+{
+    print_example_banner("CKKS Bootstrapping Performance Test with Degree: 1024");
+
+    /*
+    Bootstrapping needs a sparse secret key and many levels; with this degree the parameters are not secure, and the
+    test only measures the cost of the homomorphic operations. The first prime is the modulus at the last level, the
+    second one is left for computations after bootstrapping, and the remaining ones are consumed by bootstrapping.
+    */
+    size_t poly_modulus_degree = 1024;
+    size_t hamming_weight = 64;
+    EncryptionParameters parms(scheme_type::ckks);
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    vector<int> bit_sizes{ 60, 40 };
+    bit_sizes.insert(bit_sizes.end(), 14, 60);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, bit_sizes));
+    SEALContext context(parms, true, sec_level_type::none);
+    print_parameters(context);
+    cout << endl;
+
+    CKKSBootstrapper bootstrapper(context, hamming_weight);
+    cout << "Sine approximation degree: " << bootstrapper.sine_degree() << endl;
+    cout << "Levels consumed: " << bootstrapper.depth() << endl;
+
+    cout << "Generating sparse secret key and bootstrapping keys: ";
+    KeyGenerator keygen(context, hamming_weight);
+    PublicKey public_key;
+    keygen.create_public_key(public_key);
+    RelinKeys relin_keys;
+    keygen.create_relin_keys(relin_keys);
+    GaloisKeys gal_keys;
+    keygen.create_galois_keys(bootstrapper.galois_steps(), gal_keys);
+    cout << "Done" << endl;
+
+    Encryptor encryptor(context, public_key);
+    Decryptor decryptor(context, keygen.secret_key());
+    CKKSEncoder ckks_encoder(context);
+    size_t slot_count = ckks_encoder.slot_count();
+
+    vector<double> pod_vector;
+    random_device rd;
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        pod_vector.push_back(static_cast<double>(rd() % 1000) / 1000);
+    }
+    Plaintext plain;
+    double scale = pow(2.0, 40);
+    ckks_encoder.encode(pod_vector, context.last_parms_id(), scale, plain);
+    Ciphertext encrypted;
+    encryptor.encrypt(plain, encrypted);
+
+    cout << "Running tests ";
+    chrono::microseconds time_bootstrap_sum(0);
+    int count = 3;
+    double max_error = 0;
+    for (int i = 0; i < count; i++)
+    {
+        Ciphertext bootstrapped;
+        auto time_start = chrono::high_resolution_clock::now();
+        bootstrapper.bootstrap(encrypted, relin_keys, gal_keys, bootstrapped);
+        auto time_end = chrono::high_resolution_clock::now();
+        time_bootstrap_sum += chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+
+        vector<double> result;
+        decryptor.decrypt(bootstrapped, plain);
+        ckks_encoder.decode(plain, result);
+        for (size_t j = 0; j < slot_count; j++)
+        {
+            max_error = max(max_error, fabs(result[j] - pod_vector[j]));
+        }
+        cout << ".";
+        cout.flush();
+    }
+    cout << " Done" << endl << endl;
+    cout.flush();
+
+    auto avg_bootstrap = time_bootstrap_sum.count() / count;
+    cout << "Average bootstrap: " << avg_bootstrap << " microseconds" << endl;
+    cout << "Average bootstrap per slot: " << static_cast<double>(avg_bootstrap) / static_cast<double>(slot_count)
+         << " microseconds" << endl;
+    cout << "Maximum error: " << max_error << endl;
+}
+
 /*
 Prints a sub-menu to select the performance test.
 */
@@ -793,10 +899,12 @@ void example_performance_test()
         cout << "  2. BFV with a custom degree" << endl;
         cout << "  3. CKKS with default degrees" << endl;
         cout << "  4. CKKS with a custom degree" << endl;
+        cout << "  5. CKKS bootstrapping" << endl;
+        cout << "  6. BGV vs. BFV with default degrees" << endl;
         cout << "  0. Back to main menu" << endl;
 
         int selection = 0;
-        cout << endl << "> Run performance test (1 ~ 4) or go back (0): ";
+        cout << endl << "> Run performance test (1 ~ 6) or go back (0): ";
         if (!(cin >> selection))
         {
             cout << "Invalid option." << endl;
@@ -823,6 +931,14 @@ void example_performance_test()
             example_ckks_performance_custom();
             break;
 
+        case 5:
+            example_ckks_bootstrapping_performance();
+            break;
+
+        case 6:
+            example_bgv_performance_default();
+            break;
+
         case 0:
             cout << endl;
             return;
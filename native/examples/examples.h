@@ -69,6 +69,9 @@ inline void print_parameters(const seal::SEALContext &context)
     case seal::scheme_type::ckks:
         scheme_name = "CKKS";
         break;
+    case seal::scheme_type::bgv:
+        scheme_name = "BGV";
+        break;
     default:
         throw std::invalid_argument("unsupported scheme");
     }
@@ -94,7 +97,8 @@ inline void print_parameters(const seal::SEALContext &context)
     /*
     For the BFV scheme print the plain_modulus parameter.
     */
-    if (context_data.parms().scheme() == seal::scheme_type::bfv)
+    if (context_data.parms().scheme() == seal::scheme_type::bfv ||
+        context_data.parms().scheme() == seal::scheme_type::bgv)
     {
         std::cout << "|   plain_modulus: " << context_data.parms().plain_modulus().value() << std::endl;
     }
@@ -4,16 +4,69 @@
 #include "seal/batchencoder.h"
 #include "seal/valcheck.h"
 #include "seal/util/common.h"
+#include "seal/util/parallel.h"
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <random>
 #include <stdexcept>
 
+#if defined(SEAL_USE_INTRIN) && (SIZE_MAX == UINT64_MAX)
+#if defined(__AVX512F__)
+#define SEAL_BATCH_USE_AVX512
+#endif
+#if defined(__AVX2__)
+#define SEAL_BATCH_USE_AVX2
+#endif
+#endif
+#if defined(SEAL_BATCH_USE_AVX512) || defined(SEAL_BATCH_USE_AVX2)
+#include <immintrin.h>
+#endif
+
 using namespace std;
 using namespace seal::util;
 
 namespace seal
 {
+    namespace
+    {
+        // Sets destination[i] to source[index_map[i]] if index_map[i] is less than source_size and to zero otherwise.
+        // The masked gathers are used only when the compiler targets AVX-512 or AVX2, for example with -mavx2 or
+        // -march=native; default builds use the scalar loop.
+        void gather(
+            const uint64_t *source, size_t source_size, const size_t *index_map, size_t count, uint64_t *destination)
+        {
+            size_t i = 0;
+#ifdef SEAL_BATCH_USE_AVX512
+            __m512i size512 = _mm512_set1_epi64(static_cast<long long>(source_size));
+            for (; i + 8 <= count; i += 8)
+            {
+                __m512i index = _mm512_loadu_si512(index_map + i);
+                __mmask8 mask = _mm512_cmplt_epu64_mask(index, size512);
+                _mm512_storeu_si512(
+                    destination + i, _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), mask, index, source, 8));
+            }
+#endif
+#ifdef SEAL_BATCH_USE_AVX2
+            // Indices are less than 2^63, so the signed comparison works
+            __m256i size256 = _mm256_set1_epi64x(static_cast<long long>(source_size));
+            for (; i + 4 <= count; i += 4)
+            {
+                __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(index_map + i));
+                __m256i mask = _mm256_cmpgt_epi64(size256, index);
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i *>(destination + i),
+                    _mm256_mask_i64gather_epi64(
+                        _mm256_setzero_si256(), reinterpret_cast<const long long *>(source), index, mask, 8));
+            }
+#endif
+            for (; i < count; i++)
+            {
+                destination[i] = (index_map[i] < source_size) ? source[index_map[i]] : 0;
+            }
+        }
+    } // namespace
+
     BatchEncoder::BatchEncoder(const SEALContext &context) : context_(context)
     {
         // Verify parameters
@@ -23,7 +76,7 @@ namespace seal
         }
 
         auto &context_data = *context_.first_context_data();
-        if (context_data.parms().scheme() != scheme_type::bfv)
+        if (context_data.parms().scheme() != scheme_type::bfv && context_data.parms().scheme() != scheme_type::bgv)
         {
             throw invalid_argument("unsupported scheme");
         }
@@ -65,6 +118,7 @@ namespace seal
     {
         int logn = get_power_of_two(slots_);
         matrix_reps_index_map_ = allocate<size_t>(slots_, pool_);
+        matrix_reps_inverse_index_map_ = allocate<size_t>(slots_, pool_);
 
         // Copy from the matrix to the value vectors
         size_t row_size = slots_ >> 1;
@@ -85,6 +139,12 @@ namespace seal
             pos *= gen;
             pos &= (m - 1);
         }
+
+        // Encoding reads the matrix through the inverse map, so that both directions are gathers
+        for (size_t i = 0; i < slots_; i++)
+        {
+            matrix_reps_inverse_index_map_[matrix_reps_index_map_[i]] = i;
+        }
     }
 
     void BatchEncoder::reverse_bits(uint64_t *input)
@@ -107,175 +167,146 @@ namespace seal
         }
     }
 
-    void BatchEncoder::encode(const vector<uint64_t> &values_matrix, Plaintext &destination)
+    const SEALContext::ContextData &BatchEncoder::verify_ntt_parms_id(parms_id_type parms_id) const
     {
-        auto &context_data = *context_.first_context_data();
-
-        // Validate input parameters
-        size_t values_matrix_size = values_matrix.size();
-        if (values_matrix_size > slots_)
+        auto context_data_ptr = context_.get_context_data(parms_id);
+        if (!context_data_ptr)
         {
-            throw logic_error("values_matrix size is too large");
+            throw invalid_argument("parms_id is not valid for encryption parameters");
         }
-#ifdef SEAL_DEBUG
-        uint64_t modulus = context_data.parms().plain_modulus().value();
-        for (auto v : values_matrix)
+        auto &parms = context_data_ptr->parms();
+        if (!product_fits_in(parms.poly_modulus_degree(), parms.coeff_modulus().size()))
         {
-            // Validate the i-th input
-            if (v >= modulus)
-            {
-                throw invalid_argument("input value is larger than plain_modulus");
-            }
+            throw logic_error("invalid parameters");
         }
-#endif
-        // Set destination to full size
-        destination.resize(slots_);
-        destination.parms_id() = parms_id_zero;
+        return *context_data_ptr;
+    }
 
-        // First write the values to destination coefficients.
-        // Read in top row, then bottom row.
-        for (size_t i = 0; i < values_matrix_size; i++)
-        {
-            *(destination.data() + matrix_reps_index_map_[i]) = values_matrix[i];
-        }
-        for (size_t i = values_matrix_size; i < slots_; i++)
-        {
-            *(destination.data() + matrix_reps_index_map_[i]) = 0;
+    void BatchEncoder::lift_to_ntt_inplace(Plaintext &plain, const SEALContext::ContextData &context_data) const
+    {
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_modulus_size = coeff_modulus.size();
+        uint64_t plain_modulus = parms.plain_modulus().value();
+        uint64_t plain_upper_half_threshold = context_data.plain_upper_half_threshold();
+
+        // The coefficients in the upper half represent negative values v - t, so their residues are computed one prime
+        // at a time as (v - t) mod q_i instead of through a multi-precision lift. The first RNS component overlaps
+        // the input coefficients, so the components are filled from last to first.
+        plain.resize(coeff_count * coeff_modulus_size);
+        uint64_t *coeffs = plain.data();
+        for (size_t i = coeff_modulus_size; i-- > 0;)
+        {
+            auto &modulus = coeff_modulus[i];
+            uint64_t plain_modulus_mod_q = barrett_reduce_64(plain_modulus, modulus);
+            uint64_t *component = coeffs + i * coeff_count;
+            for (size_t j = 0; j < coeff_count; j++)
+            {
+                uint64_t value = coeffs[j];
+                uint64_t residue = barrett_reduce_64(value, modulus);
+                component[j] = (value >= plain_upper_half_threshold)
+                                   ? sub_uint_mod(residue, plain_modulus_mod_q, modulus)
+                                   : residue;
+            }
+            ntt_negacyclic_harvey(component, context_data.small_ntt_tables()[i]);
         }
 
-        // Transform destination using inverse of negacyclic NTT
-        // Note: We already performed bit-reversal when reading in the matrix
-        inverse_ntt_negacyclic_harvey(destination.data(), *context_data.plain_ntt_tables());
+        plain.parms_id() = context_data.parms_id();
+        plain.scale() = 1.0;
     }
 
-    void BatchEncoder::encode(const vector<int64_t> &values_matrix, Plaintext &destination)
+    void BatchEncoder::encode_internal(const uint64_t *values, size_t values_size, uint64_t *destination) const
     {
         auto &context_data = *context_.first_context_data();
-        uint64_t modulus = context_data.parms().plain_modulus().value();
-
-        // Validate input parameters
-        size_t values_matrix_size = values_matrix.size();
-        if (values_matrix_size > slots_)
-        {
-            throw logic_error("values_matrix size is too large");
-        }
 #ifdef SEAL_DEBUG
-        uint64_t plain_modulus_div_two = modulus >> 1;
-        for (auto v : values_matrix)
+        uint64_t modulus = context_data.parms().plain_modulus().value();
+        for (size_t i = 0; i < values_size; i++)
         {
             // Validate the i-th input
-            if (unsigned_gt(llabs(v), plain_modulus_div_two))
+            if (values[i] >= modulus)
             {
                 throw invalid_argument("input value is larger than plain_modulus");
             }
         }
 #endif
-        // Set destination to full size
-        destination.resize(slots_);
-        destination.parms_id() = parms_id_zero;
-
-        // First write the values to destination coefficients.
-        // Read in top row, then bottom row.
-        for (size_t i = 0; i < values_matrix_size; i++)
-        {
-            *(destination.data() + matrix_reps_index_map_[i]) =
-                (values_matrix[i] < 0) ? (modulus + static_cast<uint64_t>(values_matrix[i]))
-                                       : static_cast<uint64_t>(values_matrix[i]);
-        }
-        for (size_t i = values_matrix_size; i < slots_; i++)
-        {
-            *(destination.data() + matrix_reps_index_map_[i]) = 0;
-        }
+        // First write the values to destination coefficients; the index map already includes the bit-reversal
+        gather(values, values_size, matrix_reps_inverse_index_map_.get(), slots_, destination);
 
         // Transform destination using inverse of negacyclic NTT
-        // Note: We already performed bit-reversal when reading in the matrix
-        inverse_ntt_negacyclic_harvey(destination.data(), *context_data.plain_ntt_tables());
+        inverse_ntt_negacyclic_harvey(destination, *context_data.plain_ntt_tables());
     }
-#ifdef SEAL_USE_MSGSL
-    void BatchEncoder::encode(gsl::span<const uint64_t> values_matrix, Plaintext &destination)
+
+    void BatchEncoder::encode_internal(const int64_t *values, size_t values_size, uint64_t *destination) const
     {
         auto &context_data = *context_.first_context_data();
-
-        // Validate input parameters
-        size_t values_matrix_size = static_cast<size_t>(values_matrix.size());
-        if (values_matrix_size > slots_)
-        {
-            throw logic_error("values_matrix size is too large");
-        }
-#ifdef SEAL_DEBUG
         uint64_t modulus = context_data.parms().plain_modulus().value();
-        for (auto v : values_matrix)
+#ifdef SEAL_DEBUG
+        uint64_t plain_modulus_div_two = modulus >> 1;
+        for (size_t i = 0; i < values_size; i++)
         {
             // Validate the i-th input
-            if (v >= modulus)
+            if (unsigned_gt(llabs(values[i]), plain_modulus_div_two))
             {
                 throw invalid_argument("input value is larger than plain_modulus");
             }
         }
 #endif
-        // Set destination to full size
-        destination.resize(slots_);
-        destination.parms_id() = parms_id_zero;
+        // First write the values to destination coefficients; the index map already includes the bit-reversal
+        gather(
+            reinterpret_cast<const uint64_t *>(values), values_size, matrix_reps_inverse_index_map_.get(), slots_,
+            destination);
 
-        // First write the values to destination coefficients. Read in top row, then bottom row.
-        for (size_t i = 0; i < values_matrix_size; i++)
-        {
-            *(destination.data() + matrix_reps_index_map_[i]) = values_matrix[i];
-        }
-        for (size_t i = values_matrix_size; i < slots_; i++)
+        // Add the modulus to the negative values
+        for (size_t i = 0; i < slots_; i++)
         {
-            *(destination.data() + matrix_reps_index_map_[i]) = 0;
+            destination[i] += modulus & static_cast<uint64_t>(static_cast<int64_t>(destination[i]) >> 63);
         }
 
         // Transform destination using inverse of negacyclic NTT
-        // Note: We already performed bit-reversal when reading in the matrix
-        inverse_ntt_negacyclic_harvey(destination.data(), *context_data.plain_ntt_tables());
+        inverse_ntt_negacyclic_harvey(destination, *context_data.plain_ntt_tables());
     }
 
-    void BatchEncoder::encode(gsl::span<const int64_t> values_matrix, Plaintext &destination)
+    template <typename T>
+    void BatchEncoder::encode_plain(const T *values, size_t values_size, Plaintext &destination) const
     {
-        auto &context_data = *context_.first_context_data();
-        uint64_t modulus = context_data.parms().plain_modulus().value();
-
         // Validate input parameters
-        size_t values_matrix_size = static_cast<size_t>(values_matrix.size());
-        if (values_matrix_size > slots_)
+        if (values_size > slots_)
         {
             throw logic_error("values_matrix size is too large");
         }
-#ifdef SEAL_DEBUG
-        uint64_t plain_modulus_div_two = modulus >> 1;
-        for (auto v : values_matrix)
-        {
-            // Validate the i-th input
-            if (unsigned_gt(llabs(v), plain_modulus_div_two))
-            {
-                throw invalid_argument("input value is larger than plain_modulus");
-            }
-        }
-#endif
+
         // Set destination to full size
-        destination.resize(slots_);
         destination.parms_id() = parms_id_zero;
+        destination.resize(slots_);
+        encode_internal(values, values_size, destination.data());
+    }
 
-        // First write the values to destination coefficients. Read in top row, then bottom row.
-        for (size_t i = 0; i < values_matrix_size; i++)
+    template <typename T>
+    void BatchEncoder::encode_many_internal(
+        const vector<vector<T>> &values, vector<Plaintext> &destination, size_t thread_count) const
+    {
+        // Validate input parameters
+        if (thread_count == 0)
         {
-            *(destination.data() + matrix_reps_index_map_[i]) =
-                (values_matrix[i] < 0) ? (modulus + static_cast<uint64_t>(values_matrix[i]))
-                                       : static_cast<uint64_t>(values_matrix[i]);
+            throw invalid_argument("thread_count must be positive");
         }
-        for (size_t i = values_matrix_size; i < slots_; i++)
+        for (auto &values_matrix : values)
         {
-            *(destination.data() + matrix_reps_index_map_[i]) = 0;
+            if (values_matrix.size() > slots_)
+            {
+                throw logic_error("values_matrix size is too large");
+            }
         }
 
-        // Transform destination using inverse of negacyclic NTT
-        // Note: We already performed bit-reversal when reading in the matrix
-        inverse_ntt_negacyclic_harvey(destination.data(), *context_data.plain_ntt_tables());
+        size_t count = values.size();
+        destination.resize(count);
+        parallel_for(count, thread_count, pool_, [&](size_t i, MemoryPoolHandle) {
+            encode_plain(values[i].data(), values[i].size(), destination[i]);
+        });
     }
-#endif
-    void BatchEncoder::decode(const Plaintext &plain, vector<uint64_t> &destination, MemoryPoolHandle pool)
+
+    void BatchEncoder::verify_decode_parameters(const Plaintext &plain, const MemoryPoolHandle &pool) const
     {
         if (!is_valid_for(plain, context_))
         {
@@ -289,12 +320,12 @@ namespace seal
         {
             throw invalid_argument("pool is uninitialized");
         }
+    }
 
+    void BatchEncoder::decode_internal(const Plaintext &plain, uint64_t *destination, MemoryPoolHandle pool) const
+    {
         auto &context_data = *context_.first_context_data();
 
-        // Set destination size
-        destination.resize(slots_);
-
         // Never include the leading zero coefficient (if present)
         size_t plain_coeff_count = min(plain.coeff_count(), slots_);
 
@@ -308,141 +339,178 @@ namespace seal
         ntt_negacyclic_harvey(temp_dest.get(), *context_data.plain_ntt_tables());
 
         // Read top row, then bottom row
+        gather(temp_dest.get(), slots_, matrix_reps_index_map_.get(), slots_, destination);
+    }
+
+    void BatchEncoder::decode_internal(const Plaintext &plain, int64_t *destination, MemoryPoolHandle pool) const
+    {
+        decode_internal(plain, reinterpret_cast<uint64_t *>(destination), move(pool));
+
+        // Map the upper half to negative values
+        uint64_t modulus = context_.first_context_data()->parms().plain_modulus().value();
+        uint64_t plain_modulus_div_two = modulus >> 1;
         for (size_t i = 0; i < slots_; i++)
         {
-            destination[i] = temp_dest[matrix_reps_index_map_[i]];
+            uint64_t curr_value = static_cast<uint64_t>(destination[i]);
+            destination[i] = (curr_value > plain_modulus_div_two) ? static_cast<int64_t>(curr_value - modulus)
+                                                                  : static_cast<int64_t>(curr_value);
         }
     }
 
-    void BatchEncoder::decode(const Plaintext &plain, vector<int64_t> &destination, MemoryPoolHandle pool)
+    template <typename T>
+    void BatchEncoder::decode_many_internal(
+        const vector<Plaintext> &plains, vector<vector<T>> &destination, size_t thread_count,
+        MemoryPoolHandle pool) const
     {
-        if (!is_valid_for(plain, context_))
+        if (thread_count == 0)
         {
-            throw invalid_argument("plain is not valid for encryption parameters");
+            throw invalid_argument("thread_count must be positive");
         }
-        if (plain.is_ntt_form())
+        for (auto &plain : plains)
         {
-            throw invalid_argument("plain cannot be in NTT form");
-        }
-        if (!pool)
-        {
-            throw invalid_argument("pool is uninitialized");
+            verify_decode_parameters(plain, pool);
         }
 
-        auto &context_data = *context_.first_context_data();
-        uint64_t modulus = context_data.parms().plain_modulus().value();
+        size_t count = plains.size();
+        destination.resize(count);
+        parallel_for(count, thread_count, move(pool), [&](size_t i, MemoryPoolHandle thread_pool) {
+            destination[i].resize(slots_);
+            decode_internal(plains[i], destination[i].data(), move(thread_pool));
+        });
+    }
 
-        // Set destination size
-        destination.resize(slots_);
+    void BatchEncoder::encode(const vector<uint64_t> &values_matrix, Plaintext &destination)
+    {
+        encode_plain(values_matrix.data(), values_matrix.size(), destination);
+    }
 
-        // Never include the leading zero coefficient (if present)
-        size_t plain_coeff_count = min(plain.coeff_count(), slots_);
+    void BatchEncoder::encode(const vector<int64_t> &values_matrix, Plaintext &destination)
+    {
+        encode_plain(values_matrix.data(), values_matrix.size(), destination);
+    }
 
-        auto temp_dest(allocate_uint(slots_, pool));
+    void BatchEncoder::encode(const vector<uint64_t> &values_matrix, parms_id_type parms_id, Plaintext &destination)
+    {
+        auto &context_data = verify_ntt_parms_id(parms_id);
+        encode(values_matrix, destination);
+        lift_to_ntt_inplace(destination, context_data);
+    }
 
-        // Make a copy of poly
-        set_uint(plain.data(), plain_coeff_count, temp_dest.get());
-        set_zero_uint(slots_ - plain_coeff_count, temp_dest.get() + plain_coeff_count);
+    void BatchEncoder::encode(const vector<int64_t> &values_matrix, parms_id_type parms_id, Plaintext &destination)
+    {
+        auto &context_data = verify_ntt_parms_id(parms_id);
+        encode(values_matrix, destination);
+        lift_to_ntt_inplace(destination, context_data);
+    }
 
-        // Transform destination using negacyclic NTT.
-        ntt_negacyclic_harvey(temp_dest.get(), *context_data.plain_ntt_tables());
+    void BatchEncoder::encode_many(
+        const vector<vector<uint64_t>> &values, vector<Plaintext> &destination, size_t thread_count)
+    {
+        encode_many_internal(values, destination, thread_count);
+    }
 
-        // Read top row, then bottom row
-        uint64_t plain_modulus_div_two = modulus >> 1;
-        for (size_t i = 0; i < slots_; i++)
-        {
-            uint64_t curr_value = temp_dest[matrix_reps_index_map_[i]];
-            destination[i] = (curr_value > plain_modulus_div_two)
-                                 ? (static_cast<int64_t>(curr_value) - static_cast<int64_t>(modulus))
-                                 : static_cast<int64_t>(curr_value);
-        }
+    void BatchEncoder::encode_many(
+        const vector<vector<int64_t>> &values, vector<Plaintext> &destination, size_t thread_count)
+    {
+        encode_many_internal(values, destination, thread_count);
     }
 #ifdef SEAL_USE_MSGSL
-    void BatchEncoder::decode(const Plaintext &plain, gsl::span<uint64_t> destination, MemoryPoolHandle pool)
+    void BatchEncoder::encode(gsl::span<const uint64_t> values_matrix, Plaintext &destination)
     {
-        if (!is_valid_for(plain, context_))
-        {
-            throw invalid_argument("plain is not valid for encryption parameters");
-        }
-        if (plain.is_ntt_form())
-        {
-            throw invalid_argument("plain cannot be in NTT form");
-        }
-        if (!pool)
-        {
-            throw invalid_argument("pool is uninitialized");
-        }
-
-        auto &context_data = *context_.first_context_data();
-
-        if (unsigned_gt(destination.size(), numeric_limits<int>::max()) || unsigned_neq(destination.size(), slots_))
-        {
-            throw invalid_argument("destination has incorrect size");
-        }
-
-        // Never include the leading zero coefficient (if present)
-        size_t plain_coeff_count = min(plain.coeff_count(), slots_);
+        encode_plain(values_matrix.data(), static_cast<size_t>(values_matrix.size()), destination);
+    }
 
-        auto temp_dest(allocate_uint(slots_, pool));
+    void BatchEncoder::encode(gsl::span<const int64_t> values_matrix, Plaintext &destination)
+    {
+        encode_plain(values_matrix.data(), static_cast<size_t>(values_matrix.size()), destination);
+    }
 
-        // Make a copy of poly
-        set_uint(plain.data(), plain_coeff_count, temp_dest.get());
-        set_zero_uint(slots_ - plain_coeff_count, temp_dest.get() + plain_coeff_count);
+    void BatchEncoder::encode(gsl::span<const uint64_t> values_matrix, parms_id_type parms_id, Plaintext &destination)
+    {
+        auto &context_data = verify_ntt_parms_id(parms_id);
+        encode(values_matrix, destination);
+        lift_to_ntt_inplace(destination, context_data);
+    }
 
-        // Transform destination using negacyclic NTT.
-        ntt_negacyclic_harvey(temp_dest.get(), *context_data.plain_ntt_tables());
+    void BatchEncoder::encode(gsl::span<const int64_t> values_matrix, parms_id_type parms_id, Plaintext &destination)
+    {
+        auto &context_data = verify_ntt_parms_id(parms_id);
+        encode(values_matrix, destination);
+        lift_to_ntt_inplace(destination, context_data);
+    }
 
-        // Read top row, then bottom row
-        for (size_t i = 0; i < slots_; i++)
+    void BatchEncoder::encode(gsl::span<const uint64_t> values_matrix, gsl::span<uint64_t> destination)
+    {
+        if (unsigned_gt(values_matrix.size(), slots_))
+        {
+            throw logic_error("values_matrix size is too large");
+        }
+        if (unsigned_neq(destination.size(), slots_))
         {
-            destination[i] = temp_dest[matrix_reps_index_map_[i]];
+            throw invalid_argument("destination has incorrect size");
         }
+        encode_internal(values_matrix.data(), static_cast<size_t>(values_matrix.size()), destination.data());
     }
 
-    void BatchEncoder::decode(const Plaintext &plain, gsl::span<int64_t> destination, MemoryPoolHandle pool)
+    void BatchEncoder::encode(gsl::span<const int64_t> values_matrix, gsl::span<uint64_t> destination)
     {
-        if (!is_valid_for(plain, context_))
-        {
-            throw invalid_argument("plain is not valid for encryption parameters");
-        }
-        if (plain.is_ntt_form())
+        if (unsigned_gt(values_matrix.size(), slots_))
         {
-            throw invalid_argument("plain cannot be in NTT form");
+            throw logic_error("values_matrix size is too large");
         }
-        if (!pool)
+        if (unsigned_neq(destination.size(), slots_))
         {
-            throw invalid_argument("pool is uninitialized");
+            throw invalid_argument("destination has incorrect size");
         }
+        encode_internal(values_matrix.data(), static_cast<size_t>(values_matrix.size()), destination.data());
+    }
+#endif
+    void BatchEncoder::decode(const Plaintext &plain, vector<uint64_t> &destination, MemoryPoolHandle pool)
+    {
+        verify_decode_parameters(plain, pool);
+        destination.resize(slots_);
+        decode_internal(plain, destination.data(), move(pool));
+    }
 
-        auto &context_data = *context_.first_context_data();
-        uint64_t modulus = context_data.parms().plain_modulus().value();
+    void BatchEncoder::decode(const Plaintext &plain, vector<int64_t> &destination, MemoryPoolHandle pool)
+    {
+        verify_decode_parameters(plain, pool);
+        destination.resize(slots_);
+        decode_internal(plain, destination.data(), move(pool));
+    }
+
+    void BatchEncoder::decode_many(
+        const vector<Plaintext> &plains, vector<vector<uint64_t>> &destination, size_t thread_count,
+        MemoryPoolHandle pool)
+    {
+        decode_many_internal(plains, destination, thread_count, move(pool));
+    }
 
+    void BatchEncoder::decode_many(
+        const vector<Plaintext> &plains, vector<vector<int64_t>> &destination, size_t thread_count,
+        MemoryPoolHandle pool)
+    {
+        decode_many_internal(plains, destination, thread_count, move(pool));
+    }
+#ifdef SEAL_USE_MSGSL
+    void BatchEncoder::decode(const Plaintext &plain, gsl::span<uint64_t> destination, MemoryPoolHandle pool)
+    {
+        verify_decode_parameters(plain, pool);
         if (unsigned_gt(destination.size(), numeric_limits<int>::max()) || unsigned_neq(destination.size(), slots_))
         {
             throw invalid_argument("destination has incorrect size");
         }
+        decode_internal(plain, destination.data(), move(pool));
+    }
 
-        // Never include the leading zero coefficient (if present)
-        size_t plain_coeff_count = min(plain.coeff_count(), slots_);
-
-        auto temp_dest(allocate_uint(slots_, pool));
-
-        // Make a copy of poly
-        set_uint(plain.data(), plain_coeff_count, temp_dest.get());
-        set_zero_uint(slots_ - plain_coeff_count, temp_dest.get() + plain_coeff_count);
-
-        // Transform destination using negacyclic NTT.
-        ntt_negacyclic_harvey(temp_dest.get(), *context_data.plain_ntt_tables());
-
-        // Read top row, then bottom row
-        uint64_t plain_modulus_div_two = modulus >> 1;
-        for (size_t i = 0; i < slots_; i++)
+    void BatchEncoder::decode(const Plaintext &plain, gsl::span<int64_t> destination, MemoryPoolHandle pool)
+    {
+        verify_decode_parameters(plain, pool);
+        if (unsigned_gt(destination.size(), numeric_limits<int>::max()) || unsigned_neq(destination.size(), slots_))
         {
-            uint64_t curr_value = temp_dest[matrix_reps_index_map_[i]];
-            destination[i] = (curr_value > plain_modulus_div_two)
-                                 ? (static_cast<int64_t>(curr_value) - static_cast<int64_t>(modulus))
-                                 : static_cast<int64_t>(curr_value);
+            throw invalid_argument("destination has incorrect size");
         }
+        decode_internal(plain, destination.data(), move(pool));
     }
 #endif
 } // namespace seal
@@ -57,7 +57,7 @@ namespace seal
 
         @param[in] context The SEALContext
         @throws std::invalid_argument if the encryption parameters are not valid for batching
-        @throws std::invalid_argument if scheme is not scheme_type::bfv
+        @throws std::invalid_argument if scheme is not scheme_type::bfv or scheme_type::bgv
         */
         BatchEncoder(const SEALContext &context);
 
@@ -96,6 +96,84 @@ namespace seal
         @throws std::invalid_argument if values is too large
         */
         void encode(const std::vector<std::int64_t> &values, Plaintext &destination);
+
+        /**
+        Creates a plaintext from a given matrix in NTT form at the given parms_id. This
+        function "batches" a given matrix of integers modulo the plaintext modulus like
+        encode does, then lifts the plaintext to the coefficient modulus of the given
+        parms_id and transforms it to NTT form, as Evaluator::transform_to_ntt_inplace
+        does. The input vector must have size at most equal to the degree of the
+        polynomial modulus.
+
+        The result can be multiplied with ciphertexts at the same parms_id using
+        Evaluator::multiply_plain_inplace without being transformed again, which saves
+        the NTT transforms when the same plaintext is used in many products. It cannot
+        be decoded.
+
+        If the destination plaintext overlaps the input values in memory, the behavior of
+        this function is undefined.
+
+        @param[in] values The matrix of integers modulo plaintext modulus to batch
+        @param[in] parms_id The parms_id of the ciphertexts the plaintext will be multiplied with
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if values is too large
+        @throws std::invalid_argument if parms_id is not valid for the encryption parameters
+        */
+        void encode(const std::vector<std::uint64_t> &values, parms_id_type parms_id, Plaintext &destination);
+
+        /**
+        Creates a plaintext from a given matrix in NTT form at the given parms_id. This
+        function "batches" a given matrix of integers modulo the plaintext modulus like
+        encode does, then lifts the plaintext to the coefficient modulus of the given
+        parms_id and transforms it to NTT form, as Evaluator::transform_to_ntt_inplace
+        does. The input vector must have size at most equal to the degree of the
+        polynomial modulus.
+
+        The result can be multiplied with ciphertexts at the same parms_id using
+        Evaluator::multiply_plain_inplace without being transformed again, which saves
+        the NTT transforms when the same plaintext is used in many products. It cannot
+        be decoded.
+
+        If the destination plaintext overlaps the input values in memory, the behavior of
+        this function is undefined.
+
+        @param[in] values The matrix of integers modulo plaintext modulus to batch
+        @param[in] parms_id The parms_id of the ciphertexts the plaintext will be multiplied with
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if values is too large
+        @throws std::invalid_argument if parms_id is not valid for the encryption parameters
+        */
+        void encode(const std::vector<std::int64_t> &values, parms_id_type parms_id, Plaintext &destination);
+
+        /**
+        Creates plaintexts from several matrices, one for each matrix, on up to
+        thread_count threads. The result is the same as calling encode on each matrix.
+
+        @param[in] values The matrices of integers modulo plaintext modulus to batch
+        @param[out] destination The plaintext polynomials to overwrite with the results,
+        resized to the number of matrices
+        @param[in] thread_count The maximum number of threads to use
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::logic_error if any matrix in values is too large
+        */
+        void encode_many(
+            const std::vector<std::vector<std::uint64_t>> &values, std::vector<Plaintext> &destination,
+            std::size_t thread_count = 1);
+
+        /**
+        Creates plaintexts from several matrices, one for each matrix, on up to
+        thread_count threads. The result is the same as calling encode on each matrix.
+
+        @param[in] values The matrices of integers modulo plaintext modulus to batch
+        @param[out] destination The plaintext polynomials to overwrite with the results,
+        resized to the number of matrices
+        @param[in] thread_count The maximum number of threads to use
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::logic_error if any matrix in values is too large
+        */
+        void encode_many(
+            const std::vector<std::vector<std::int64_t>> &values, std::vector<Plaintext> &destination,
+            std::size_t thread_count = 1);
 #ifdef SEAL_USE_MSGSL
         /**
         Creates a plaintext from a given matrix. This function "batches" a given matrix
@@ -132,6 +210,88 @@ namespace seal
         @throws std::invalid_argument if values is too large
         */
         void encode(gsl::span<const std::int64_t> values, Plaintext &destination);
+
+        /**
+        Creates a plaintext from a given matrix in NTT form at the given parms_id. This
+        function "batches" a given matrix of integers modulo the plaintext modulus like
+        encode does, then lifts the plaintext to the coefficient modulus of the given
+        parms_id and transforms it to NTT form, as Evaluator::transform_to_ntt_inplace
+        does. The input must have size at most equal to the degree of the
+        polynomial modulus.
+
+        The result can be multiplied with ciphertexts at the same parms_id using
+        Evaluator::multiply_plain_inplace without being transformed again, which saves
+        the NTT transforms when the same plaintext is used in many products. It cannot
+        be decoded.
+
+        If the destination plaintext overlaps the input values in memory, the behavior of
+        this function is undefined.
+
+        @param[in] values The matrix of integers modulo plaintext modulus to batch
+        @param[in] parms_id The parms_id of the ciphertexts the plaintext will be multiplied with
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if values is too large
+        @throws std::invalid_argument if parms_id is not valid for the encryption parameters
+        */
+        void encode(gsl::span<const std::uint64_t> values, parms_id_type parms_id, Plaintext &destination);
+
+        /**
+        Creates a plaintext from a given matrix in NTT form at the given parms_id. This
+        function "batches" a given matrix of integers modulo the plaintext modulus like
+        encode does, then lifts the plaintext to the coefficient modulus of the given
+        parms_id and transforms it to NTT form, as Evaluator::transform_to_ntt_inplace
+        does. The input must have size at most equal to the degree of the
+        polynomial modulus.
+
+        The result can be multiplied with ciphertexts at the same parms_id using
+        Evaluator::multiply_plain_inplace without being transformed again, which saves
+        the NTT transforms when the same plaintext is used in many products. It cannot
+        be decoded.
+
+        If the destination plaintext overlaps the input values in memory, the behavior of
+        this function is undefined.
+
+        @param[in] values The matrix of integers modulo plaintext modulus to batch
+        @param[in] parms_id The parms_id of the ciphertexts the plaintext will be multiplied with
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if values is too large
+        @throws std::invalid_argument if parms_id is not valid for the encryption parameters
+        */
+        void encode(gsl::span<const std::int64_t> values, parms_id_type parms_id, Plaintext &destination);
+
+        /**
+        Creates the coefficients of a plaintext from a given matrix and writes them
+        directly to a given buffer, such as a region of a larger array, instead of to
+        a Plaintext. The result is the same as the coefficients written by encode into
+        a Plaintext. The input must have size at most equal to the degree of the
+        polynomial modulus, and the destination must have size equal to it.
+
+        If the destination overlaps the input values in memory, the behavior of this
+        function is undefined.
+
+        @param[in] values The matrix of integers modulo plaintext modulus to batch
+        @param[out] destination The coefficients to overwrite with the result
+        @throws std::logic_error if values is too large
+        @throws std::invalid_argument if destination has incorrect size
+        */
+        void encode(gsl::span<const std::uint64_t> values, gsl::span<std::uint64_t> destination);
+
+        /**
+        Creates the coefficients of a plaintext from a given matrix and writes them
+        directly to a given buffer, such as a region of a larger array, instead of to
+        a Plaintext. The result is the same as the coefficients written by encode into
+        a Plaintext. The input must have size at most equal to the degree of the
+        polynomial modulus, and the destination must have size equal to it.
+
+        If the destination overlaps the input values in memory, the behavior of this
+        function is undefined.
+
+        @param[in] values The matrix of integers modulo plaintext modulus to batch
+        @param[out] destination The coefficients to overwrite with the result
+        @throws std::logic_error if values is too large
+        @throws std::invalid_argument if destination has incorrect size
+        */
+        void encode(gsl::span<const std::int64_t> values, gsl::span<std::uint64_t> destination);
 #endif
         /**
         Inverse of encode. This function "unbatches" a given plaintext into a matrix
@@ -170,6 +330,48 @@ namespace seal
         void decode(
             const Plaintext &plain, std::vector<std::int64_t> &destination,
             MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Decodes several plaintexts, one matrix for each plaintext, on up to thread_count
+        threads. The result is the same as calling decode on each plaintext. Each thread
+        allocates its temporary memory from its own memory pool.
+
+        @param[in] plains The plaintext polynomials to unbatch
+        @param[out] destination The matrices to be overwritten with the values in the
+        slots, resized to the number of plaintexts
+        @param[in] thread_count The maximum number of threads to use
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool, which is
+        used when only one thread is needed
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::invalid_argument if any plaintext is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if any plaintext is in NTT form
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode_many(
+            const std::vector<Plaintext> &plains, std::vector<std::vector<std::uint64_t>> &destination,
+            std::size_t thread_count = 1, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Decodes several plaintexts, one matrix for each plaintext, on up to thread_count
+        threads. The result is the same as calling decode on each plaintext. Each thread
+        allocates its temporary memory from its own memory pool.
+
+        @param[in] plains The plaintext polynomials to unbatch
+        @param[out] destination The matrices to be overwritten with the values in the
+        slots, resized to the number of plaintexts
+        @param[in] thread_count The maximum number of threads to use
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool, which is
+        used when only one thread is needed
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::invalid_argument if any plaintext is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if any plaintext is in NTT form
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode_many(
+            const std::vector<Plaintext> &plains, std::vector<std::vector<std::int64_t>> &destination,
+            std::size_t thread_count = 1, MemoryPoolHandle pool = MemoryManager::GetPool());
 #ifdef SEAL_USE_MSGSL
         /**
         Inverse of encode. This function "unbatches" a given plaintext into a matrix
@@ -234,6 +436,36 @@ namespace seal
 
         void reverse_bits(std::uint64_t *input);
 
+        // Writes the slots_ coefficients of the plaintext encoding values to destination
+        void encode_internal(const std::uint64_t *values, std::size_t values_size, std::uint64_t *destination) const;
+
+        void encode_internal(const std::int64_t *values, std::size_t values_size, std::uint64_t *destination) const;
+
+        template <typename T>
+        void encode_plain(const T *values, std::size_t values_size, Plaintext &destination) const;
+
+        template <typename T>
+        void encode_many_internal(
+            const std::vector<std::vector<T>> &values, std::vector<Plaintext> &destination,
+            std::size_t thread_count) const;
+
+        void verify_decode_parameters(const Plaintext &plain, const MemoryPoolHandle &pool) const;
+
+        // Writes the slots_ values in the slots of a verified plaintext to destination
+        void decode_internal(const Plaintext &plain, std::uint64_t *destination, MemoryPoolHandle pool) const;
+
+        void decode_internal(const Plaintext &plain, std::int64_t *destination, MemoryPoolHandle pool) const;
+
+        template <typename T>
+        void decode_many_internal(
+            const std::vector<Plaintext> &plains, std::vector<std::vector<T>> &destination, std::size_t thread_count,
+            MemoryPoolHandle pool) const;
+
+        const SEALContext::ContextData &verify_ntt_parms_id(parms_id_type parms_id) const;
+
+        // Lifts a plaintext encoded by encode to the coefficient modulus and transforms it to NTT form in place
+        void lift_to_ntt_inplace(Plaintext &plain, const SEALContext::ContextData &context_data) const;
+
         MemoryPoolHandle pool_ = MemoryManager::GetPool();
 
         SEALContext context_;
@@ -243,5 +475,7 @@ namespace seal
         util::Pointer<std::uint64_t> roots_of_unity_;
 
         util::Pointer<std::size_t> matrix_reps_index_map_;
+
+        util::Pointer<std::size_t> matrix_reps_inverse_index_map_;
     };
 } // namespace seal
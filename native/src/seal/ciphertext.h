@@ -53,6 +53,8 @@ namespace seal
     */
     class Ciphertext
     {
+        friend class KSwitchKeys;
+
     public:
         using ct_coeff_type = std::uint64_t;
 
@@ -280,6 +282,7 @@ namespace seal
             poly_modulus_degree_ = 0;
             coeff_modulus_size_ = 0;
             scale_ = 1.0;
+            correction_factor_ = 1;
             data_.release();
         }
 
@@ -650,6 +653,25 @@ namespace seal
             return scale_;
         }
 
+        /**
+        Returns a reference to the correction factor. This is only needed when
+        using the BGV encryption scheme. The user should have little or no reason
+        to ever change the correction factor by hand.
+        */
+        SEAL_NODISCARD inline auto &correction_factor() noexcept
+        {
+            return correction_factor_;
+        }
+
+        /**
+        Returns a constant reference to the correction factor. This is only
+        needed when using the BGV encryption scheme.
+        */
+        SEAL_NODISCARD inline auto &correction_factor() const noexcept
+        {
+            return correction_factor_;
+        }
+
         /**
         Returns the currently used MemoryPoolHandle.
         */
@@ -692,6 +714,8 @@ namespace seal
 
         double scale_ = 1.0;
 
+        std::uint64_t correction_factor_ = 1;
+
         DynArray<ct_coeff_type> data_;
     };
 } // namespace seal
@@ -2,6 +2,7 @@
 // Licensed under the MIT license.
 
 #include "seal/ckks.h"
+#include "seal/util/fft.h"
 #include <random>
 #include <stdexcept>
 
@@ -26,9 +27,9 @@ namespace seal
 
         size_t coeff_count = context_data.parms().poly_modulus_degree();
         slots_ = coeff_count >> 1;
-        int logn = get_power_of_two(coeff_count);
+        int log_slots = get_power_of_two(slots_);
 
-        matrix_reps_index_map_ = allocate<size_t>(coeff_count, pool_);
+        matrix_reps_index_map_ = allocate<size_t>(slots_, pool_);
 
         // Copy from the matrix to the value vectors
         uint64_t gen = 3;
@@ -36,40 +37,388 @@ namespace seal
         uint64_t m = static_cast<uint64_t>(coeff_count) << 1;
         for (size_t i = 0; i < slots_; i++)
         {
-            // Position in normal bit order
-            uint64_t index1 = (pos - 1) >> 1;
-            uint64_t index2 = (m - pos - 1) >> 1;
+            // Slot i evaluates at the pos-th power of the primitive 2n-th root. The folded polynomial takes the values
+            // at the powers 4 * index + 1, so for odd i, where pos = 3 mod 4, the slot holds the conjugate of the value
+            // at the power m - pos.
+            uint64_t index = (((pos & 3) == 1 ? pos : m - pos) - 1) >> 2;
 
-            // Set the bit-reversed locations
-            matrix_reps_index_map_[i] = safe_cast<size_t>(reverse_bits(index1, logn));
-            matrix_reps_index_map_[slots_ | i] = safe_cast<size_t>(reverse_bits(index2, logn));
+            // Set the bit-reversed location
+            matrix_reps_index_map_[i] = safe_cast<size_t>(reverse_bits(index, log_slots));
 
             // Next primitive root
             pos *= gen;
             pos &= (m - 1);
         }
 
-        // We need 1~(n-1)-th powers of the primitive 2n-th root, m = 2n
-        root_powers_ = allocate<complex<double>>(coeff_count, pool_);
-        inv_root_powers_ = allocate<complex<double>>(coeff_count, pool_);
+        // We need 1~(n/2-1)-th powers of the square of the primitive 2n-th root, and 0~(n/2-1)-th powers of the
+        // primitive 2n-th root itself for the twist, m = 2n; each table holds the real parts followed by the
+        // imaginary parts
+        root_powers_ = allocate<double>(coeff_count, pool_, 0);
+        inv_root_powers_ = allocate<double>(coeff_count, pool_, 0);
+        twist_powers_ = allocate<double>(coeff_count, pool_, 0);
+        twist_powers_[0] = 1.0;
         // Powers of the primitive 2n-th root have 4-fold symmetry
         if (m >= 8)
         {
             complex_roots_ = make_shared<util::ComplexRoots>(util::ComplexRoots(static_cast<size_t>(m), pool_));
-            for (size_t i = 1; i < coeff_count; i++)
+            auto set_split = [&](Pointer<double> &table, size_t i, complex<double> value) {
+                table[i] = value.real();
+                table[i + slots_] = value.imag();
+            };
+            for (size_t i = 1; i < slots_; i++)
             {
-                root_powers_[i] = complex_roots_->get_root(reverse_bits(i, logn));
-                inv_root_powers_[i] = conj(complex_roots_->get_root(reverse_bits(i - 1, logn) + 1));
+                set_split(root_powers_, i, complex_roots_->get_root(reverse_bits(i, log_slots) << 1));
+                set_split(
+                    inv_root_powers_, i, conj(complex_roots_->get_root((reverse_bits(i - 1, log_slots) + 1) << 1)));
+                set_split(twist_powers_, i, complex_roots_->get_root(i));
             }
         }
-        else if (m == 4)
+    }
+
+    void CKKSEncoder::forward_half_transform(double *values) const
+    {
+        // The slots evaluate w at odd powers of the square of root, after twisting w by the inverse powers of root
+        double *values_imag = values + slots_;
+        multiply_split_complex(values, values_imag, twist_powers_.get(), twist_powers_.get() + slots_, slots_, true);
+        int log_slots = get_power_of_two(slots_);
+        if (log_slots > 0)
+        {
+            split_transform_to_rev(values, values_imag, log_slots, root_powers_.get(), root_powers_.get() + slots_);
+        }
+    }
+
+    void CKKSEncoder::inverse_half_transform(double *values, double scalar) const
+    {
+        double *values_imag = values + slots_;
+        int log_slots = get_power_of_two(slots_);
+        if (log_slots > 0)
+        {
+            split_transform_from_rev(
+                values, values_imag, log_slots, inv_root_powers_.get(), inv_root_powers_.get() + slots_, scalar);
+            multiply_split_complex(
+                values, values_imag, twist_powers_.get(), twist_powers_.get() + slots_, slots_, false);
+        }
+        else
+        {
+            values[0] *= scalar;
+            values_imag[0] *= scalar;
+        }
+    }
+
+    const SEALContext::ContextData &CKKSEncoder::verify_encode_parameters(
+        parms_id_type parms_id, double scale, const MemoryPoolHandle &pool) const
+    {
+        auto context_data_ptr = context_.get_context_data(parms_id);
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("parms_id is not valid for encryption parameters");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        auto &context_data = *context_data_ptr;
+        auto &parms = context_data.parms();
+
+        // Quick sanity check
+        if (!product_fits_in(parms.coeff_modulus().size(), parms.poly_modulus_degree()))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // Check that scale is positive and not too large
+        if (scale <= 0 || (static_cast<int>(log2(scale)) + 1 >= context_data.total_coeff_modulus_bit_count()))
+        {
+            throw invalid_argument("scale out of bounds");
+        }
+
+        return context_data;
+    }
+
+    const SEALContext::ContextData &CKKSEncoder::verify_decode_parameters(
+        const Plaintext &plain, const MemoryPoolHandle &pool) const
+    {
+        if (!is_valid_for(plain, context_))
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+        if (!plain.is_ntt_form())
+        {
+            throw invalid_argument("plain is not in NTT form");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        auto &context_data = *context_.get_context_data(plain.parms_id());
+        size_t coeff_count = context_data.parms().poly_modulus_degree();
+
+        // Check that scale is positive and not too large
+        if (plain.scale() <= 0 ||
+            (static_cast<int>(log2(plain.scale())) >= context_data.total_coeff_modulus_bit_count()))
         {
-            root_powers_[1] = { 0, 1 };
-            inv_root_powers_[1] = { 0, -1 };
+            throw invalid_argument("scale out of bounds");
+        }
+
+        // Quick sanity check
+        int logn = get_power_of_two(coeff_count);
+        if ((logn < 0) || (coeff_count < SEAL_POLY_MOD_DEGREE_MIN) || (coeff_count > SEAL_POLY_MOD_DEGREE_MAX))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        return context_data;
+    }
+
+    void CKKSEncoder::decode_to_coeffs(
+        const Plaintext &plain, const SEALContext::ContextData &context_data, double *destination,
+        MemoryPoolHandle pool) const
+    {
+        auto &parms = context_data.parms();
+        size_t coeff_modulus_size = parms.coeff_modulus().size();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t rns_poly_uint64_count = mul_safe(coeff_count, coeff_modulus_size);
+
+        auto ntt_tables = context_data.small_ntt_tables();
+        auto decryption_modulus = context_data.total_coeff_modulus();
+        auto upper_half_threshold = context_data.upper_half_threshold();
+        double inv_scale = double(1.0) / plain.scale();
+
+        // Create mutable copy of input
+        auto plain_copy(allocate_uint(rns_poly_uint64_count, pool));
+        set_uint(plain.data(), rns_poly_uint64_count, plain_copy.get());
+
+        // Transform each polynomial from NTT domain
+        for (size_t i = 0; i < coeff_modulus_size; i++)
+        {
+            inverse_ntt_negacyclic_harvey(plain_copy.get() + (i * coeff_count), ntt_tables[i]);
+        }
+
+        if (coeff_modulus_size == 1)
+        {
+            // The coefficients are the centered residues
+            uint64_t modulus = parms.coeff_modulus()[0].value();
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                uint64_t value = plain_copy[i];
+                destination[i] = ((value >= upper_half_threshold[0]) ? -static_cast<double>(modulus - value)
+                                                                     : static_cast<double>(value)) *
+                                 inv_scale;
+            }
+            return;
         }
 
-        complex_arith_ = ComplexArith();
-        fft_handler_ = FFTHandler(complex_arith_);
+        if (coeff_modulus_size == 2)
+        {
+            // Compose with Garner's formula x = a_0 + q_0 * ((a_1 - a_0) * q_0^(-1) mod q_1), which fits in 128 bits
+            auto &modulus0 = parms.coeff_modulus()[0];
+            auto &modulus1 = parms.coeff_modulus()[1];
+            uint64_t inv_modulus0;
+            if (!try_invert_uint_mod(barrett_reduce_64(modulus0.value(), modulus1), modulus1, inv_modulus0))
+            {
+                throw logic_error("invalid parameters");
+            }
+            MultiplyUIntModOperand inv_modulus0_operand;
+            inv_modulus0_operand.set(inv_modulus0, modulus1);
+
+            double two_pow_64 = pow(2.0, 64);
+            const uint64_t *residues0 = plain_copy.get();
+            const uint64_t *residues1 = plain_copy.get() + coeff_count;
+            unsigned long long prod[2]{ 0, 0 };
+            uint64_t value[2]{ 0, 0 };
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                uint64_t diff = sub_uint_mod(residues1[i], barrett_reduce_64(residues0[i], modulus1), modulus1);
+                multiply_uint64(modulus0.value(), multiply_uint_mod(diff, inv_modulus0_operand, modulus1), prod);
+                unsigned char carry = add_uint64(*prod, residues0[i], value);
+                value[1] = static_cast<uint64_t>(prod[1]) + static_cast<uint64_t>(carry);
+                double coeff;
+                if (is_greater_than_or_equal_uint(value, upper_half_threshold, 2))
+                {
+                    sub_uint(decryption_modulus, value, 2, value);
+                    coeff = -(static_cast<double>(value[1]) * two_pow_64 + static_cast<double>(value[0]));
+                }
+                else
+                {
+                    coeff = static_cast<double>(value[1]) * two_pow_64 + static_cast<double>(value[0]);
+                }
+                destination[i] = coeff * inv_scale;
+            }
+            return;
+        }
+
+        // CRT-compose the polynomial
+        context_data.rns_tool()->base_q()->compose_array(plain_copy.get(), coeff_count, pool);
+
+        // Create floating-point representations of the multi-precision integer coefficients
+        double two_pow_64 = pow(2.0, 64);
+        for (size_t i = 0; i < coeff_count; i++)
+        {
+            double coeff = 0.0;
+            if (is_greater_than_or_equal_uint(
+                    plain_copy.get() + (i * coeff_modulus_size), upper_half_threshold, coeff_modulus_size))
+            {
+                double scaled_two_pow_64 = inv_scale;
+                for (size_t j = 0; j < coeff_modulus_size; j++, scaled_two_pow_64 *= two_pow_64)
+                {
+                    if (plain_copy[i * coeff_modulus_size + j] > decryption_modulus[j])
+                    {
+                        auto diff = plain_copy[i * coeff_modulus_size + j] - decryption_modulus[j];
+                        coeff += diff ? static_cast<double>(diff) * scaled_two_pow_64 : 0.0;
+                    }
+                    else
+                    {
+                        auto diff = decryption_modulus[j] - plain_copy[i * coeff_modulus_size + j];
+                        coeff -= diff ? static_cast<double>(diff) * scaled_two_pow_64 : 0.0;
+                    }
+                }
+            }
+            else
+            {
+                double scaled_two_pow_64 = inv_scale;
+                for (size_t j = 0; j < coeff_modulus_size; j++, scaled_two_pow_64 *= two_pow_64)
+                {
+                    auto curr_coeff = plain_copy[i * coeff_modulus_size + j];
+                    coeff += curr_coeff ? static_cast<double>(curr_coeff) * scaled_two_pow_64 : 0.0;
+                }
+            }
+
+            // Scaling instead incorporated above; this can help in cases
+            // where otherwise pow(two_pow_64, j) would overflow due to very
+            // large coeff_modulus_size and very large scale
+            // res[i] = res_accum * inv_scale;
+            destination[i] = coeff;
+        }
+    }
+
+    complex<double> CKKSEncoder::evaluate_slot(const double *coeffs, size_t coeff_count, size_t slot) const
+    {
+        // Slot i evaluates at the (3^i)-th power of the primitive 2n-th root
+        uint64_t m = static_cast<uint64_t>(coeff_count) << 1;
+        uint64_t pos = 1;
+        for (size_t i = 0; i < slot; i++)
+        {
+            pos = (pos * 3) & (m - 1);
+        }
+
+        complex<double> result = 0;
+        uint64_t index = 0;
+        for (size_t j = 0; j < coeff_count; j++)
+        {
+            result += coeffs[j] * complex_roots_->get_root(static_cast<size_t>(index));
+            index = (index + pos) & (m - 1);
+        }
+        return result;
+    }
+
+    void CKKSEncoder::coeffs_to_rns(
+        const double *coeffs, int max_coeff_bit_count, const SEALContext::ContextData &context_data,
+        uint64_t *destination, MemoryPoolHandle pool) const
+    {
+        auto &coeff_modulus = context_data.parms().coeff_modulus();
+        size_t coeff_modulus_size = coeff_modulus.size();
+        size_t coeff_count = context_data.parms().poly_modulus_degree();
+        double two_pow_64 = pow(2.0, 64);
+
+        // The coefficients are rounded once, and then reduced modulo one prime at a time, so that the innermost loops
+        // run over contiguous memory without branches. A rounded coefficient r that is negative and nonzero has the
+        // residue q - (r mod q); note that coeffs[i] < 0 and r != 0 imply that the coefficient rounds to -r.
+        if (max_coeff_bit_count <= 64)
+        {
+            auto coeffu(allocate_uint(coeff_count, pool));
+            uint64_t max_coeffu = 0;
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                coeffu[i] = static_cast<uint64_t>(fabs(round(coeffs[i])));
+                max_coeffu = max<>(max_coeffu, coeffu[i]);
+            }
+
+            for (size_t j = 0; j < coeff_modulus_size; j++, destination += coeff_count)
+            {
+                const Modulus &modulus = coeff_modulus[j];
+                uint64_t q = modulus.value();
+                if (max_coeffu < q)
+                {
+                    // The common case where the scale is smaller than the primes needs no reduction at all
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        uint64_t r = coeffu[i];
+                        destination[i] = (coeffs[i] < 0 && r) ? q - r : r;
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        uint64_t r = barrett_reduce_64(coeffu[i], modulus);
+                        destination[i] = (coeffs[i] < 0 && r) ? q - r : r;
+                    }
+                }
+            }
+        }
+        else if (max_coeff_bit_count <= 128)
+        {
+            // Split the coefficients into two words directly, rather than going through RNSBase::decompose
+            auto coeffu(allocate_uint(mul_safe(coeff_count, size_t(2)), pool));
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                double coeffd = fabs(round(coeffs[i]));
+                coeffu[2 * i] = static_cast<uint64_t>(fmod(coeffd, two_pow_64));
+                coeffu[2 * i + 1] = static_cast<uint64_t>(coeffd / two_pow_64);
+            }
+
+            for (size_t j = 0; j < coeff_modulus_size; j++, destination += coeff_count)
+            {
+                const Modulus &modulus = coeff_modulus[j];
+                uint64_t q = modulus.value();
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    uint64_t r = barrett_reduce_128(coeffu.get() + 2 * i, modulus);
+                    destination[i] = (coeffs[i] < 0 && r) ? q - r : r;
+                }
+            }
+        }
+        else
+        {
+            // Slow case
+            auto coeffu(allocate_uint(coeff_modulus_size, pool));
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                double coeffd = round(coeffs[i]);
+                bool is_negative = signbit(coeffd);
+                coeffd = fabs(coeffd);
+
+                // We are at this point guaranteed to fit in the allocated space
+                set_zero_uint(coeff_modulus_size, coeffu.get());
+                auto coeffu_ptr = coeffu.get();
+                while (coeffd >= 1)
+                {
+                    *coeffu_ptr++ = static_cast<uint64_t>(fmod(coeffd, two_pow_64));
+                    coeffd /= two_pow_64;
+                }
+
+                // Next decompose this coefficient
+                context_data.rns_tool()->base_q()->decompose(coeffu.get(), pool);
+
+                // Finally replace the sign if necessary
+                if (is_negative)
+                {
+                    for (size_t j = 0; j < coeff_modulus_size; j++)
+                    {
+                        destination[i + (j * coeff_count)] = negate_uint_mod(coeffu[j], coeff_modulus[j]);
+                    }
+                }
+                else
+                {
+                    for (size_t j = 0; j < coeff_modulus_size; j++)
+                    {
+                        destination[i + (j * coeff_count)] = coeffu[j];
+                    }
+                }
+            }
+        }
     }
 
     void CKKSEncoder::encode_internal(
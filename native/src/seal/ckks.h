@@ -9,6 +9,7 @@
 #include "seal/util/croots.h"
 #include "seal/util/defines.h"
 #include "seal/util/dwthandler.h"
+#include "seal/util/parallel.h"
 #include "seal/util/uintarithsmallmod.h"
 #include "seal/util/uintcore.h"
 #include <cmath>
@@ -25,7 +26,9 @@ namespace seal
     template <
         typename T_out, typename = std::enable_if_t<
                             std::is_same<std::remove_cv_t<T_out>, double>::value ||
-                            std::is_same<std::remove_cv_t<T_out>, std::complex<double>>::value>>
+                            std::is_same<std::remove_cv_t<T_out>, std::complex<double>>::value ||
+                            std::is_same<std::remove_cv_t<T_out>, float>::value ||
+                            std::is_same<std::remove_cv_t<T_out>, std::complex<float>>::value>>
     SEAL_NODISCARD inline T_out from_complex(std::complex<double> in);
 
     template <>
@@ -40,6 +43,18 @@ namespace seal
         return in;
     }
 
+    template <>
+    SEAL_NODISCARD inline float from_complex(std::complex<double> in)
+    {
+        return static_cast<float>(in.real());
+    }
+
+    template <>
+    SEAL_NODISCARD inline std::complex<float> from_complex(std::complex<double> in)
+    {
+        return std::complex<float>(in);
+    }
+
     namespace util
     {
         template <>
@@ -105,8 +120,7 @@ namespace seal
     */
     class CKKSEncoder
     {
-        using ComplexArith = util::Arithmetic<std::complex<double>, std::complex<double>, double>;
-        using FFTHandler = util::DWTHandler<std::complex<double>, std::complex<double>, double>;
+        friend class CKKSCoeffEncoder;
 
     public:
         /**
@@ -248,6 +262,151 @@ namespace seal
         {
             encode(values, context_.first_parms_id(), scale, destination, std::move(pool));
         }
+#endif
+        /**
+        Encodes several vectors of double-precision floating-point real or
+        complex numbers into plaintext polynomials, one for each vector, on up
+        to thread_count threads. The validity of the parameters is checked only
+        once, and the threads share the precomputed tables of the encoder. Each
+        thread allocates from its own new memory pool, so that its scratch
+        memory is reused from one vector to the next; with a single thread,
+        dynamic memory allocations are made from the memory pool pointed to by
+        the given MemoryPoolHandle. The result is the same as calling encode on
+        each vector. If an exception is thrown while encoding, the contents of
+        destination are unspecified.
+
+        @tparam T Vector value type (double or std::complex<double>)
+        @param[in] values The vectors of double-precision floating-point numbers
+        (of type T) to encode
+        @param[in] parms_id parms_id determining the encryption parameters to
+        be used by the result plaintexts
+        @param[in] scale Scaling parameter defining encoding precision
+        @param[out] destination The plaintext polynomials to overwrite with the
+        results, resized to the number of vectors
+        @param[in] thread_count The maximum number of threads to use
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::invalid_argument if any vector in values has invalid size
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if scale is not strictly positive
+        @throws std::invalid_argument if any encoding is too large for the
+        encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        template <
+            typename T, typename = std::enable_if_t<
+                            std::is_same<std::remove_cv_t<T>, double>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value>>
+        inline void encode_batch(
+            const std::vector<std::vector<T>> &values, parms_id_type parms_id, double scale,
+            std::vector<Plaintext> &destination, std::size_t thread_count = 1,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            encode_batch_internal(values, parms_id, scale, destination, thread_count, std::move(pool));
+        }
+
+        /**
+        Encodes several vectors of double-precision floating-point real or
+        complex numbers into plaintext polynomials, one for each vector, on up
+        to thread_count threads. The encryption parameters used are the top
+        level parameters for the given context. See the overload taking a
+        parms_id for details.
+
+        @tparam T Vector value type (double or std::complex<double>)
+        @param[in] values The vectors of double-precision floating-point numbers
+        (of type T) to encode
+        @param[in] scale Scaling parameter defining encoding precision
+        @param[out] destination The plaintext polynomials to overwrite with the
+        results, resized to the number of vectors
+        @param[in] thread_count The maximum number of threads to use
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::invalid_argument if any vector in values has invalid size
+        @throws std::invalid_argument if scale is not strictly positive
+        @throws std::invalid_argument if any encoding is too large for the
+        encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        template <
+            typename T, typename = std::enable_if_t<
+                            std::is_same<std::remove_cv_t<T>, double>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value>>
+        inline void encode_batch(
+            const std::vector<std::vector<T>> &values, double scale, std::vector<Plaintext> &destination,
+            std::size_t thread_count = 1, MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            encode_batch(values, context_.first_parms_id(), scale, destination, thread_count, std::move(pool));
+        }
+#ifdef SEAL_USE_MSGSL
+        /**
+        Encodes several arrays of double-precision floating-point real or
+        complex numbers into plaintext polynomials, one for each array, on up
+        to thread_count threads. See the overload taking vectors for details.
+
+        @tparam T Array value type (double or std::complex<double>)
+        @param[in] values The arrays of double-precision floating-point numbers
+        (of type T) to encode
+        @param[in] parms_id parms_id determining the encryption parameters to
+        be used by the result plaintexts
+        @param[in] scale Scaling parameter defining encoding precision
+        @param[out] destination The plaintext polynomials to overwrite with the
+        results, resized to the number of arrays
+        @param[in] thread_count The maximum number of threads to use
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::invalid_argument if any vector in values has invalid size
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if scale is not strictly positive
+        @throws std::invalid_argument if any encoding is too large for the
+        encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        template <
+            typename T, typename = std::enable_if_t<
+                            std::is_same<std::remove_cv_t<T>, double>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value>>
+        inline void encode_batch(
+            gsl::span<const gsl::span<const T>> values, parms_id_type parms_id, double scale,
+            std::vector<Plaintext> &destination, std::size_t thread_count = 1,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            encode_batch_internal(values, parms_id, scale, destination, thread_count, std::move(pool));
+        }
+
+        /**
+        Encodes several arrays of double-precision floating-point real or
+        complex numbers into plaintext polynomials, one for each array, on up
+        to thread_count threads. The encryption parameters used are the top
+        level parameters for the given context. See the overload taking vectors
+        for details.
+
+        @tparam T Array value type (double or std::complex<double>)
+        @param[in] values The arrays of double-precision floating-point numbers
+        (of type T) to encode
+        @param[in] scale Scaling parameter defining encoding precision
+        @param[out] destination The plaintext polynomials to overwrite with the
+        results, resized to the number of arrays
+        @param[in] thread_count The maximum number of threads to use
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::invalid_argument if any vector in values has invalid size
+        @throws std::invalid_argument if scale is not strictly positive
+        @throws std::invalid_argument if any encoding is too large for the
+        encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        template <
+            typename T, typename = std::enable_if_t<
+                            std::is_same<std::remove_cv_t<T>, double>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value>>
+        inline void encode_batch(
+            gsl::span<const gsl::span<const T>> values, double scale, std::vector<Plaintext> &destination,
+            std::size_t thread_count = 1, MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            encode_batch(values, context_.first_parms_id(), scale, destination, thread_count, std::move(pool));
+        }
 #endif
         /**
         Encodes a double-precision floating-point real number into a plaintext
@@ -381,10 +540,13 @@ namespace seal
 
         /**
         Decodes a plaintext polynomial into double-precision floating-point
-        real or complex numbers. Dynamic memory allocations in the process are
-        allocated from the memory pool pointed to by the given MemoryPoolHandle.
+        real or complex numbers. The values can also be written in single
+        precision, in which case they are computed in double precision and then
+        rounded. Dynamic memory allocations in the process are allocated from
+        the memory pool pointed to by the given MemoryPoolHandle.
 
-        @tparam T Vector value type (double or std::complex<double>)
+        @tparam T Vector value type (double, std::complex<double>, float, or
+        std::complex<float>)
         @param[in] plain The plaintext to decode
         @param[out] destination The vector to be overwritten with the values in
         the slots
@@ -396,20 +558,66 @@ namespace seal
         template <
             typename T, typename = std::enable_if_t<
                             std::is_same<std::remove_cv_t<T>, double>::value ||
-                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value>>
+                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value ||
+                            std::is_same<std::remove_cv_t<T>, float>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<float>>::value>>
         inline void decode(
             const Plaintext &plain, std::vector<T> &destination, MemoryPoolHandle pool = MemoryManager::GetPool())
         {
             destination.resize(slots_);
             decode_internal(plain, destination.data(), std::move(pool));
         }
+
+        /**
+        Decodes only the slots first_slot, ..., first_slot + slot_count - 1 of a
+        plaintext polynomial into double-precision floating-point real or complex
+        numbers, for example when only the first slot holds a result. The values
+        are the same as those decode writes to these slots. When very few slots
+        are requested, they are evaluated directly instead of with the full
+        transform. Dynamic memory allocations in the process are allocated from
+        the memory pool pointed to by the given MemoryPoolHandle.
+
+        @tparam T Vector value type (double, std::complex<double>, float, or
+        std::complex<float>)
+        @param[in] plain The plaintext to decode
+        @param[out] destination The vector to be overwritten with the values in
+        the requested slots, resized to slot_count
+        @param[in] first_slot The index of the first slot to decode
+        @param[in] slot_count The number of slots to decode
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if plain is not in NTT form or is invalid
+        for the encryption parameters
+        @throws std::invalid_argument if the slots are out of bounds
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        template <
+            typename T, typename = std::enable_if_t<
+                            std::is_same<std::remove_cv_t<T>, double>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value ||
+                            std::is_same<std::remove_cv_t<T>, float>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<float>>::value>>
+        inline void decode(
+            const Plaintext &plain, std::vector<T> &destination, std::size_t first_slot, std::size_t slot_count,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            if (first_slot > slots_ || slot_count > slots_ - first_slot)
+            {
+                throw std::invalid_argument("slot range is out of bounds");
+            }
+            destination.resize(slot_count);
+            decode_slots_internal(plain, destination.data(), first_slot, slot_count, std::move(pool));
+        }
+
 #ifdef SEAL_USE_MSGSL
         /**
         Decodes a plaintext polynomial into double-precision floating-point
-        real or complex numbers. Dynamic memory allocations in the process are
-        allocated from the memory pool pointed to by the given MemoryPoolHandle.
+        real or complex numbers. The values can also be written in single
+        precision, in which case they are computed in double precision and then
+        rounded. Dynamic memory allocations in the process are allocated from
+        the memory pool pointed to by the given MemoryPoolHandle.
 
-        @tparam T Array value type (double or std::complex<double>)
+        @tparam T Array value type (double, std::complex<double>, float, or
+        std::complex<float>)
         @param[in] plain The plaintext to decode
         @param[out] destination The array to be overwritten with the values in
         the slots
@@ -421,7 +629,9 @@ namespace seal
         template <
             typename T, typename = std::enable_if_t<
                             std::is_same<std::remove_cv_t<T>, double>::value ||
-                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value>>
+                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value ||
+                            std::is_same<std::remove_cv_t<T>, float>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<float>>::value>>
         inline void decode(
             const Plaintext &plain, gsl::span<T> destination, MemoryPoolHandle pool = MemoryManager::GetPool())
         {
@@ -431,6 +641,37 @@ namespace seal
             }
             decode_internal(plain, destination.data(), std::move(pool));
         }
+
+        /**
+        Decodes only the slots first_slot, ..., first_slot + destination.size() - 1
+        of a plaintext polynomial into double-precision floating-point real or
+        complex numbers. See the overload taking a vector for details.
+
+        @tparam T Array value type (double, std::complex<double>, float, or
+        std::complex<float>)
+        @param[in] plain The plaintext to decode
+        @param[out] destination The array to be overwritten with the values in
+        the requested slots
+        @param[in] first_slot The index of the first slot to decode
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if plain is not in NTT form or is invalid
+        for the encryption parameters
+        @throws std::invalid_argument if the slots are out of bounds
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        template <
+            typename T, typename = std::enable_if_t<
+                            std::is_same<std::remove_cv_t<T>, double>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value ||
+                            std::is_same<std::remove_cv_t<T>, float>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<float>>::value>>
+        inline void decode(
+            const Plaintext &plain, gsl::span<T> destination, std::size_t first_slot,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            decode_slots_internal(
+                plain, destination.data(), first_slot, static_cast<std::size_t>(destination.size()), std::move(pool));
+        }
 #endif
         /**
         Returns the number of complex numbers encoded.
@@ -450,11 +691,7 @@ namespace seal
             MemoryPoolHandle pool)
         {
             // Verify parameters.
-            auto context_data_ptr = context_.get_context_data(parms_id);
-            if (!context_data_ptr)
-            {
-                throw std::invalid_argument("parms_id is not valid for encryption parameters");
-            }
+            auto &context_data = verify_encode_parameters(parms_id, scale, pool);
             if (!values && values_size > 0)
             {
                 throw std::invalid_argument("values cannot be null");
@@ -463,48 +700,82 @@ namespace seal
             {
                 throw std::invalid_argument("values_size is too large");
             }
-            if (!pool)
+
+            encode_verified(values, values_size, context_data, scale, destination, std::move(pool));
+        }
+
+        template <typename Container>
+        void encode_batch_internal(
+            const Container &values, parms_id_type parms_id, double scale, std::vector<Plaintext> &destination,
+            std::size_t thread_count, MemoryPoolHandle pool)
+        {
+            // Verify parameters.
+            if (thread_count == 0)
             {
-                throw std::invalid_argument("pool is uninitialized");
+                throw std::invalid_argument("thread_count must be positive");
+            }
+            auto &context_data = verify_encode_parameters(parms_id, scale, pool);
+            std::size_t count = static_cast<std::size_t>(values.size());
+            for (std::size_t i = 0; i < count; i++)
+            {
+                if (!values.data()[i].data() && values.data()[i].size() > 0)
+                {
+                    throw std::invalid_argument("values cannot be null");
+                }
+                if (static_cast<std::size_t>(values.data()[i].size()) > slots_)
+                {
+                    throw std::invalid_argument("values_size is too large");
+                }
             }
 
-            auto &context_data = *context_data_ptr;
+            // The root tables are shared by all threads, and each thread reuses the scratch memory of one vector for
+            // the next from its own memory pool
+            destination.resize(count);
+            util::parallel_for(count, thread_count, std::move(pool), [&](std::size_t i, MemoryPoolHandle thread_pool) {
+                auto &vec = values.data()[i];
+                encode_verified(
+                    vec.data(), static_cast<std::size_t>(vec.size()), context_data, scale, destination[i],
+                    std::move(thread_pool));
+            });
+        }
+
+        // Returns the context data for parms_id after checking that parms_id, scale, and pool can be used to encode
+        const SEALContext::ContextData &verify_encode_parameters(
+            parms_id_type parms_id, double scale, const MemoryPoolHandle &pool) const;
+
+        template <typename T>
+        void encode_verified(
+            const T *values, std::size_t values_size, const SEALContext::ContextData &context_data, double scale,
+            Plaintext &destination, MemoryPoolHandle pool) const
+        {
             auto &parms = context_data.parms();
             auto &coeff_modulus = parms.coeff_modulus();
             std::size_t coeff_modulus_size = coeff_modulus.size();
             std::size_t coeff_count = parms.poly_modulus_degree();
 
-            // Quick sanity check
-            if (!util::product_fits_in(coeff_modulus_size, coeff_count))
-            {
-                throw std::logic_error("invalid parameters");
-            }
-
-            // Check that scale is positive and not too large
-            if (scale <= 0 || (static_cast<int>(log2(scale)) + 1 >= context_data.total_coeff_modulus_bit_count()))
-            {
-                throw std::invalid_argument("scale out of bounds");
-            }
-
             auto ntt_tables = context_data.small_ntt_tables();
 
-            // values_size is guaranteed to be no bigger than slots_
-            std::size_t n = util::mul_safe(slots_, std::size_t(2));
-
-            auto conj_values = util::allocate<std::complex<double>>(n, pool, 0);
+            // The real coefficients m_i of the plaintext polynomial are computed as the real and imaginary parts of the
+            // coefficients w_i = m_i + sqrt(-1) * m_(i + n/2) of a polynomial of half the degree, which takes the same
+            // values as m at the slots. Hence, the conjugate values need not be stored and the transform is of length
+            // n/2 for both real and complex inputs. Note that values_size is guaranteed to be no bigger than slots_.
+            // The transform works on the real and imaginary parts of w in separate halves of coeffs, so that after
+            // the transform coeffs holds exactly the coefficients of m.
+            auto coeffs = util::allocate<double>(coeff_count, pool, 0);
             for (std::size_t i = 0; i < values_size; i++)
             {
-                conj_values[matrix_reps_index_map_[i]] = values[i];
-                // TODO: if values are real, the following values should be set to zero, and multiply results by 2.
-                conj_values[matrix_reps_index_map_[i + slots_]] = std::conj(values[i]);
+                std::complex<double> value = values[i];
+                std::size_t index = matrix_reps_index_map_[i];
+                coeffs[index] = value.real();
+                coeffs[index + slots_] = (i & 1) ? -value.imag() : value.imag();
             }
-            double fix = scale / static_cast<double>(n);
-            fft_handler_.transform_from_rev(conj_values.get(), util::get_power_of_two(n), inv_root_powers_.get(), &fix);
+            double fix = scale / static_cast<double>(slots_);
+            inverse_half_transform(coeffs.get(), fix);
 
             double max_coeff = 0;
-            for (std::size_t i = 0; i < n; i++)
+            for (std::size_t i = 0; i < coeff_count; i++)
             {
-                max_coeff = std::max<>(max_coeff, std::fabs(conj_values[i].real()));
+                max_coeff = std::max<>(max_coeff, std::fabs(coeffs[i]));
             }
             // Verify that the values are not too large to fit in coeff_modulus
             // Note that we have an extra + 1 for the sign bit
@@ -515,108 +786,13 @@ namespace seal
                 throw std::invalid_argument("encoded values are too large");
             }
 
-            double two_pow_64 = std::pow(2.0, 64);
-
             // Resize destination to appropriate size
             // Need to first set parms_id to zero, otherwise resize
             // will throw an exception.
             destination.parms_id() = parms_id_zero;
             destination.resize(util::mul_safe(coeff_count, coeff_modulus_size));
 
-            // Use faster decomposition methods when possible
-            if (max_coeff_bit_count <= 64)
-            {
-                for (std::size_t i = 0; i < n; i++)
-                {
-                    double coeffd = std::round(conj_values[i].real());
-                    bool is_negative = std::signbit(coeffd);
-
-                    std::uint64_t coeffu = static_cast<std::uint64_t>(std::fabs(coeffd));
-
-                    if (is_negative)
-                    {
-                        for (std::size_t j = 0; j < coeff_modulus_size; j++)
-                        {
-                            destination[i + (j * coeff_count)] = util::negate_uint_mod(
-                                util::barrett_reduce_64(coeffu, coeff_modulus[j]), coeff_modulus[j]);
-                        }
-                    }
-                    else
-                    {
-                        for (std::size_t j = 0; j < coeff_modulus_size; j++)
-                        {
-                            destination[i + (j * coeff_count)] = util::barrett_reduce_64(coeffu, coeff_modulus[j]);
-                        }
-                    }
-                }
-            }
-            else if (max_coeff_bit_count <= 128)
-            {
-                for (std::size_t i = 0; i < n; i++)
-                {
-                    double coeffd = std::round(conj_values[i].real());
-                    bool is_negative = std::signbit(coeffd);
-                    coeffd = std::fabs(coeffd);
-
-                    std::uint64_t coeffu[2]{ static_cast<std::uint64_t>(std::fmod(coeffd, two_pow_64)),
-                                             static_cast<std::uint64_t>(coeffd / two_pow_64) };
-
-                    if (is_negative)
-                    {
-                        for (std::size_t j = 0; j < coeff_modulus_size; j++)
-                        {
-                            destination[i + (j * coeff_count)] = util::negate_uint_mod(
-                                util::barrett_reduce_128(coeffu, coeff_modulus[j]), coeff_modulus[j]);
-                        }
-                    }
-                    else
-                    {
-                        for (std::size_t j = 0; j < coeff_modulus_size; j++)
-                        {
-                            destination[i + (j * coeff_count)] = util::barrett_reduce_128(coeffu, coeff_modulus[j]);
-                        }
-                    }
-                }
-            }
-            else
-            {
-                // Slow case
-                auto coeffu(util::allocate_uint(coeff_modulus_size, pool));
-                for (std::size_t i = 0; i < n; i++)
-                {
-                    double coeffd = std::round(conj_values[i].real());
-                    bool is_negative = std::signbit(coeffd);
-                    coeffd = std::fabs(coeffd);
-
-                    // We are at this point guaranteed to fit in the allocated space
-                    util::set_zero_uint(coeff_modulus_size, coeffu.get());
-                    auto coeffu_ptr = coeffu.get();
-                    while (coeffd >= 1)
-                    {
-                        *coeffu_ptr++ = static_cast<std::uint64_t>(std::fmod(coeffd, two_pow_64));
-                        coeffd /= two_pow_64;
-                    }
-
-                    // Next decompose this coefficient
-                    context_data.rns_tool()->base_q()->decompose(coeffu.get(), pool);
-
-                    // Finally replace the sign if necessary
-                    if (is_negative)
-                    {
-                        for (std::size_t j = 0; j < coeff_modulus_size; j++)
-                        {
-                            destination[i + (j * coeff_count)] = util::negate_uint_mod(coeffu[j], coeff_modulus[j]);
-                        }
-                    }
-                    else
-                    {
-                        for (std::size_t j = 0; j < coeff_modulus_size; j++)
-                        {
-                            destination[i + (j * coeff_count)] = coeffu[j];
-                        }
-                    }
-                }
-            }
+            coeffs_to_rns(coeffs.get(), max_coeff_bit_count, context_data, destination.data(), pool);
 
             // Transform to NTT domain
             for (std::size_t i = 0; i < coeff_modulus_size; i++)
@@ -624,122 +800,99 @@ namespace seal
                 util::ntt_negacyclic_harvey(destination.data(i * coeff_count), ntt_tables[i]);
             }
 
-            destination.parms_id() = parms_id;
+            destination.parms_id() = context_data.parms_id();
             destination.scale() = scale;
         }
 
         template <
             typename T, typename = std::enable_if_t<
                             std::is_same<std::remove_cv_t<T>, double>::value ||
-                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value>>
+                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value ||
+                            std::is_same<std::remove_cv_t<T>, float>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<float>>::value>>
         void decode_internal(const Plaintext &plain, T *destination, MemoryPoolHandle pool)
         {
             // Verify parameters.
-            if (!is_valid_for(plain, context_))
-            {
-                throw std::invalid_argument("plain is not valid for encryption parameters");
-            }
-            if (!plain.is_ntt_form())
-            {
-                throw std::invalid_argument("plain is not in NTT form");
-            }
+            auto &context_data = verify_decode_parameters(plain, pool);
             if (!destination)
             {
                 throw std::invalid_argument("destination cannot be null");
             }
-            if (!pool)
-            {
-                throw std::invalid_argument("pool is uninitialized");
-            }
 
-            auto &context_data = *context_.get_context_data(plain.parms_id());
-            auto &parms = context_data.parms();
-            std::size_t coeff_modulus_size = parms.coeff_modulus().size();
-            std::size_t coeff_count = parms.poly_modulus_degree();
-            std::size_t rns_poly_uint64_count = util::mul_safe(coeff_count, coeff_modulus_size);
+            // The upper half of the coefficients holds the imaginary parts of the folded polynomial
+            std::size_t coeff_count = context_data.parms().poly_modulus_degree();
+            auto res(util::allocate<double>(coeff_count, pool));
+            decode_to_coeffs(plain, context_data, res.get(), std::move(pool));
 
-            auto ntt_tables = context_data.small_ntt_tables();
+            forward_half_transform(res.get());
 
-            // Check that scale is positive and not too large
-            if (plain.scale() <= 0 ||
-                (static_cast<int>(log2(plain.scale())) >= context_data.total_coeff_modulus_bit_count()))
+            for (std::size_t i = 0; i < slots_; i++)
             {
-                throw std::invalid_argument("scale out of bounds");
+                std::size_t index = matrix_reps_index_map_[i];
+                double imag = res[index + slots_];
+                destination[i] = from_complex<T>(std::complex<double>(res[index], (i & 1) ? -imag : imag));
             }
+        }
 
-            auto decryption_modulus = context_data.total_coeff_modulus();
-            auto upper_half_threshold = context_data.upper_half_threshold();
-            int logn = util::get_power_of_two(coeff_count);
-
-            // Quick sanity check
-            if ((logn < 0) || (coeff_count < SEAL_POLY_MOD_DEGREE_MIN) || (coeff_count > SEAL_POLY_MOD_DEGREE_MAX))
+        template <
+            typename T, typename = std::enable_if_t<
+                            std::is_same<std::remove_cv_t<T>, double>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value ||
+                            std::is_same<std::remove_cv_t<T>, float>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<float>>::value>>
+        void decode_slots_internal(
+            const Plaintext &plain, T *destination, std::size_t first_slot, std::size_t slot_count,
+            MemoryPoolHandle pool)
+        {
+            // Verify parameters.
+            auto &context_data = verify_decode_parameters(plain, pool);
+            if (!destination && slot_count > 0)
             {
-                throw std::logic_error("invalid parameters");
+                throw std::invalid_argument("destination cannot be null");
             }
-
-            double inv_scale = double(1.0) / plain.scale();
-
-            // Create mutable copy of input
-            auto plain_copy(util::allocate_uint(rns_poly_uint64_count, pool));
-            util::set_uint(plain.data(), rns_poly_uint64_count, plain_copy.get());
-
-            // Transform each polynomial from NTT domain
-            for (std::size_t i = 0; i < coeff_modulus_size; i++)
+            if (first_slot > slots_ || slot_count > slots_ - first_slot)
             {
-                util::inverse_ntt_negacyclic_harvey(plain_copy.get() + (i * coeff_count), ntt_tables[i]);
+                throw std::invalid_argument("slot range is out of bounds");
             }
 
-            // CRT-compose the polynomial
-            context_data.rns_tool()->base_q()->compose_array(plain_copy.get(), coeff_count, pool);
+            std::size_t coeff_count = context_data.parms().poly_modulus_degree();
+            auto res(util::allocate<double>(coeff_count, pool));
+            decode_to_coeffs(plain, context_data, res.get(), std::move(pool));
 
-            // Create floating-point representations of the multi-precision integer coefficients
-            double two_pow_64 = std::pow(2.0, 64);
-            auto res(util::allocate<std::complex<double>>(coeff_count, pool));
-            for (std::size_t i = 0; i < coeff_count; i++)
+            // Evaluating a slot directly costs n multiplications, so the transform is cheaper unless very few slots
+            // are needed
+            if (4 * slot_count <= static_cast<std::size_t>(util::get_power_of_two(slots_)))
             {
-                res[i] = 0.0;
-                if (util::is_greater_than_or_equal_uint(
-                        plain_copy.get() + (i * coeff_modulus_size), upper_half_threshold, coeff_modulus_size))
+                for (std::size_t i = 0; i < slot_count; i++)
                 {
-                    double scaled_two_pow_64 = inv_scale;
-                    for (std::size_t j = 0; j < coeff_modulus_size; j++, scaled_two_pow_64 *= two_pow_64)
-                    {
-                        if (plain_copy[i * coeff_modulus_size + j] > decryption_modulus[j])
-                        {
-                            auto diff = plain_copy[i * coeff_modulus_size + j] - decryption_modulus[j];
-                            res[i] += diff ? static_cast<double>(diff) * scaled_two_pow_64 : 0.0;
-                        }
-                        else
-                        {
-                            auto diff = decryption_modulus[j] - plain_copy[i * coeff_modulus_size + j];
-                            res[i] -= diff ? static_cast<double>(diff) * scaled_two_pow_64 : 0.0;
-                        }
-                    }
+                    destination[i] = from_complex<T>(evaluate_slot(res.get(), coeff_count, first_slot + i));
                 }
-                else
-                {
-                    double scaled_two_pow_64 = inv_scale;
-                    for (std::size_t j = 0; j < coeff_modulus_size; j++, scaled_two_pow_64 *= two_pow_64)
-                    {
-                        auto curr_coeff = plain_copy[i * coeff_modulus_size + j];
-                        res[i] += curr_coeff ? static_cast<double>(curr_coeff) * scaled_two_pow_64 : 0.0;
-                    }
-                }
-
-                // Scaling instead incorporated above; this can help in cases
-                // where otherwise pow(two_pow_64, j) would overflow due to very
-                // large coeff_modulus_size and very large scale
-                // res[i] = res_accum * inv_scale;
+                return;
             }
 
-            fft_handler_.transform_to_rev(res.get(), logn, root_powers_.get());
+            forward_half_transform(res.get());
 
-            for (std::size_t i = 0; i < slots_; i++)
+            for (std::size_t i = first_slot; i < first_slot + slot_count; i++)
             {
-                destination[i] = from_complex<T>(res[static_cast<std::size_t>(matrix_reps_index_map_[i])]);
+                std::size_t index = matrix_reps_index_map_[i];
+                double imag = res[index + slots_];
+                destination[i - first_slot] = from_complex<T>(std::complex<double>(res[index], (i & 1) ? -imag : imag));
             }
         }
 
+        // Returns the context data of plain after checking that plain and pool can be used to decode
+        const SEALContext::ContextData &verify_decode_parameters(
+            const Plaintext &plain, const MemoryPoolHandle &pool) const;
+
+        // Writes the coefficients of a verified plaintext, divided by its scale, to destination
+        void decode_to_coeffs(
+            const Plaintext &plain, const SEALContext::ContextData &context_data, double *destination,
+            MemoryPoolHandle pool) const;
+
+        // Evaluates the polynomial with the given real coefficients at the root of the given slot
+        SEAL_NODISCARD std::complex<double> evaluate_slot(
+            const double *coeffs, std::size_t coeff_count, std::size_t slot) const;
+
         void encode_internal(
             double value, parms_id_type parms_id, double scale, Plaintext &destination, MemoryPoolHandle pool);
 
@@ -753,6 +906,21 @@ namespace seal
 
         void encode_internal(std::int64_t value, parms_id_type parms_id, Plaintext &destination);
 
+        // Rounds the coeff_count coefficients in coeffs to integers and writes their residues modulo each prime in
+        // the coefficient modulus to destination, one prime after the other. The coefficients must be smaller in
+        // absolute value than 2^(max_coeff_bit_count - 1).
+        void coeffs_to_rns(
+            const double *coeffs, int max_coeff_bit_count, const SEALContext::ContextData &context_data,
+            std::uint64_t *destination, MemoryPoolHandle pool) const;
+
+        // Evaluates the folded polynomial w_i = m_i + sqrt(-1) * m_(i + n/2) at the slots, where values holds the n
+        // coefficients of m; the input is overwritten with the real parts of the values in bit-reversed order,
+        // followed by the imaginary parts
+        void forward_half_transform(double *values) const;
+
+        // Inverse of forward_half_transform, with all outputs multiplied by scalar
+        void inverse_half_transform(double *values, double scalar) const;
+
         MemoryPoolHandle pool_ = MemoryManager::GetPool();
 
         SEALContext context_;
@@ -761,16 +929,16 @@ namespace seal
 
         std::shared_ptr<util::ComplexRoots> complex_roots_;
 
-        // Holds 1~(n-1)-th powers of root in bit-reversed order, the 0-th power is left unset.
-        util::Pointer<std::complex<double>> root_powers_;
+        // Holds 1~(n/2-1)-th powers of the square of root in bit-reversed order, the 0-th power is left unset. The
+        // real parts are followed by the imaginary parts, as for the other tables.
+        util::Pointer<double> root_powers_;
 
-        // Holds 1~(n-1)-th powers of inverse root in scrambled order, the 0-th power is left unset.
-        util::Pointer<std::complex<double>> inv_root_powers_;
+        // Holds 1~(n/2-1)-th powers of the square of inverse root in scrambled order, the 0-th power is left unset.
+        util::Pointer<double> inv_root_powers_;
 
-        util::Pointer<std::size_t> matrix_reps_index_map_;
-
-        ComplexArith complex_arith_;
+        // Holds 0~(n/2-1)-th powers of root, which twist the negacyclic transform of length n/2 to the slots.
+        util::Pointer<double> twist_powers_;
 
-        FFTHandler fft_handler_;
+        util::Pointer<std::size_t> matrix_reps_index_map_;
     };
 } // namespace seal
@@ -0,0 +1,414 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/ckksbootstrapper.h"
+#include "seal/plaintext.h"
+#include "seal/util/common.h"
+#include "seal/util/croots.h"
+#include "seal/util/iterator.h"
+#include "seal/util/ntt.h"
+#include "seal/util/polyarithsmallmod.h"
+#include "seal/util/polycore.h"
+#include "seal/util/uintarithsmallmod.h"
+#include "seal/valcheck.h"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    namespace
+    {
+        constexpr double pi = 3.1415926535897932384626433832795028842;
+
+        // Evaluates a Chebyshev series with the Clenshaw recurrence
+        SEAL_NODISCARD double evaluate_chebyshev(const vector<double> &coeffs, double x)
+        {
+            double b1 = 0;
+            double b2 = 0;
+            for (size_t k = coeffs.size(); k-- > 1;)
+            {
+                double b0 = coeffs[k] + 2 * x * b1 - b2;
+                b2 = b1;
+                b1 = b0;
+            }
+            return coeffs[0] + x * b1 - b2;
+        }
+    } // namespace
+
+    CKKSBootstrapper::CKKSBootstrapper(const SEALContext &context, size_t hamming_weight, size_t sine_degree)
+        : context_(context), evaluator_(context), encoder_(context), polynomial_evaluator_(context)
+    {
+        // Verify parameters
+        if (!context_.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+        auto &context_data = *context_.first_context_data();
+        if (context_data.parms().scheme() != scheme_type::ckks)
+        {
+            throw invalid_argument("unsupported scheme");
+        }
+        if (!context_data.qualifiers().using_batching)
+        {
+            throw logic_error("encryption parameters do not support batching");
+        }
+        if (!context_.using_keyswitching())
+        {
+            throw logic_error("keyswitching is not supported by the context");
+        }
+        size_t coeff_count = context_data.parms().poly_modulus_degree();
+        if (!hamming_weight || hamming_weight > coeff_count)
+        {
+            throw invalid_argument("hamming_weight is not valid");
+        }
+
+        slot_count_ = coeff_count >> 1;
+        baby_step_count_ = 1;
+        while (baby_step_count_ * baby_step_count_ < slot_count_)
+        {
+            baby_step_count_ <<= 1;
+        }
+
+        // Decrypting a ciphertext modulo q_0 without reduction gives m + q_0 I, where each coefficient of I is a sum of
+        // at most h + 1 values in [-1/2, 1/2]; the bound leaves room for the fractional part and rounding
+        bound_ = static_cast<double>(hamming_weight + 4) / 2;
+        double bound = bound_;
+        auto sine = [bound](double x) { return sin(2 * pi * bound * x) / (2 * pi); };
+        if (sine_degree)
+        {
+            sine_coeffs_ = ChebyshevCoefficients(sine, sine_degree);
+        }
+        else
+        {
+            // Choose the smallest degree 2^k - 1 whose maximum error on a fine grid is below 2^-40
+            const double max_error = ldexp(1.0, -40);
+            for (sine_degree = 7;; sine_degree = 2 * sine_degree + 1)
+            {
+                if (sine_degree >= (size_t(1) << 16))
+                {
+                    throw invalid_argument("hamming_weight is too large");
+                }
+                sine_coeffs_ = ChebyshevCoefficients(sine, sine_degree);
+                double error = 0;
+                size_t sample_count = 8 * (sine_degree + 1);
+                for (size_t i = 0; i <= sample_count; i++)
+                {
+                    double x = -1 + 2 * static_cast<double>(i) / static_cast<double>(sample_count);
+                    error = max(error, fabs(evaluate_chebyshev(sine_coeffs_, x) - sine(x)));
+                }
+                if (error < max_error)
+                {
+                    break;
+                }
+            }
+        }
+
+        // The sine is odd, so the even coefficients vanish up to rounding errors
+        for (size_t k = 0; k < sine_coeffs_.size(); k += 2)
+        {
+            sine_coeffs_[k] = 0;
+        }
+
+        // One level each for coeff_to_slot and slot_to_coeff, and at most ceil(log2(d + 1)) + 1 for the sine
+        size_t sine_depth = 1;
+        while ((size_t(1) << (sine_depth - 1)) < sine_degree + 1)
+        {
+            sine_depth++;
+        }
+        depth_ = sine_depth + 2;
+        if (context_data.chain_index() < depth_)
+        {
+            throw invalid_argument("encryption parameters do not have enough levels for bootstrapping");
+        }
+
+        // Slot j evaluates the plaintext at the (3^j mod 2N)-th power of the primitive 2N-th root of unity
+        size_t m = coeff_count << 1;
+        ComplexRoots complex_roots(m, MemoryManager::GetPool());
+        roots_.resize(m);
+        for (size_t i = 0; i < m; i++)
+        {
+            roots_[i] = complex_roots.get_root(i);
+        }
+        slot_exponents_.resize(slot_count_);
+        size_t exponent = 1;
+        for (size_t j = 0; j < slot_count_; j++)
+        {
+            slot_exponents_[j] = exponent;
+            exponent = (exponent * 3) & (m - 1);
+        }
+    }
+
+    vector<int> CKKSBootstrapper::galois_steps() const
+    {
+        vector<int> steps;
+        for (size_t a = 1; a < baby_step_count_; a++)
+        {
+            steps.push_back(static_cast<int>(a));
+        }
+        for (size_t b = 1; b * baby_step_count_ < slot_count_; b++)
+        {
+            steps.push_back(static_cast<int>(b * baby_step_count_));
+        }
+        steps.push_back(0);
+        return steps;
+    }
+
+    void CKKSBootstrapper::bootstrap(
+        const Ciphertext &encrypted, const RelinKeys &relin_keys, const GaloisKeys &galois_keys,
+        Ciphertext &destination, MemoryPoolHandle pool)
+    {
+        if (!is_metadata_valid_for(relin_keys, context_))
+        {
+            throw invalid_argument("relin_keys is not valid for encryption parameters");
+        }
+        double scale = encrypted.scale();
+
+        Ciphertext raised(pool);
+        mod_raise(encrypted, raised, pool);
+
+        Ciphertext lower_coeffs(pool);
+        Ciphertext upper_coeffs(pool);
+        coeff_to_slot(raised, galois_keys, lower_coeffs, upper_coeffs, pool);
+        raised.release();
+
+        eval_mod_inplace(lower_coeffs, relin_keys, pool);
+        eval_mod_inplace(upper_coeffs, relin_keys, pool);
+
+        slot_to_coeff(lower_coeffs, upper_coeffs, scale, galois_keys, destination, pool);
+    }
+
+    void CKKSBootstrapper::mod_raise(const Ciphertext &encrypted, Ciphertext &destination, MemoryPoolHandle pool)
+    {
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!encrypted.is_ntt_form())
+        {
+            throw invalid_argument("encrypted must be in NTT form");
+        }
+        if (encrypted.size() > 2)
+        {
+            throw invalid_argument("encrypted size must be at most 2");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        Ciphertext last(encrypted, pool);
+        if (last.parms_id() != context_.last_parms_id())
+        {
+            evaluator_.mod_switch_to_inplace(last, context_.last_parms_id(), pool);
+        }
+
+        auto &last_context_data = *context_.last_context_data();
+        auto &first_context_data = *context_.first_context_data();
+        auto &q0 = last_context_data.parms().coeff_modulus()[0];
+        auto &coeff_modulus = first_context_data.parms().coeff_modulus();
+        size_t coeff_count = first_context_data.parms().poly_modulus_degree();
+        size_t coeff_modulus_size = coeff_modulus.size();
+        auto ntt_tables = first_context_data.small_ntt_tables();
+        uint64_t q0_half = q0.value() >> 1;
+
+        destination.resize(context_, context_.first_parms_id(), last.size());
+        SEAL_ITERATE(iter(last, destination), last.size(), [&](auto I) {
+            // Lift the coefficients modulo q_0 to the symmetric range and reduce them modulo the primes of the first
+            // level
+            CoeffIter component = get<0>(I)[0];
+            inverse_ntt_negacyclic_harvey(component, *last_context_data.small_ntt_tables());
+            SEAL_ITERATE(iter(get<1>(I), coeff_modulus, ntt_tables), coeff_modulus_size, [&](auto J) {
+                auto &modulus = get<1>(J);
+                uint64_t q0_mod = barrett_reduce_64(q0.value(), modulus);
+                SEAL_ITERATE(iter(component, get<0>(J)), coeff_count, [&](auto K) {
+                    uint64_t value = barrett_reduce_64(get<0>(K), modulus);
+                    get<1>(K) = get<0>(K) > q0_half ? sub_uint_mod(value, q0_mod, modulus) : value;
+                });
+                ntt_negacyclic_harvey(get<0>(J), get<2>(J));
+            });
+        });
+        destination.is_ntt_form() = true;
+        destination.scale() = static_cast<double>(q0.value());
+    }
+
+    void CKKSBootstrapper::coeff_to_slot(
+        const Ciphertext &encrypted, const GaloisKeys &galois_keys, Ciphertext &lower_coeffs,
+        Ciphertext &upper_coeffs, MemoryPoolHandle pool)
+    {
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (encrypted.parms_id() != context_.first_parms_id())
+        {
+            throw invalid_argument("encrypted is not at the first level");
+        }
+
+        // Coefficient k of the plaintext is (2 / N) Re(sum_j conj(zeta_j)^k z_j), where z_j is the value in slot j
+        // and zeta_j the root of unity at which slot j evaluates the plaintext
+        double factor = 1 / (static_cast<double>(slot_count_ << 1) * bound_);
+        vector<matrix_type> lower{ [this, factor](size_t row, size_t col) {
+            return conj(root_power(col, row)) * factor;
+        } };
+        vector<matrix_type> upper{ [this, factor](size_t row, size_t col) {
+            return conj(root_power(col, row + slot_count_)) * factor;
+        } };
+
+        // The results are rescaled to the prime that is dropped
+        auto &coeff_modulus = context_.first_context_data()->parms().coeff_modulus();
+        double dropped = static_cast<double>(coeff_modulus.back().value());
+        double plain_scale = dropped * dropped / encrypted.scale();
+
+        vector<int> steps;
+        for (size_t a = 0; a < baby_step_count_; a++)
+        {
+            steps.push_back(static_cast<int>(a));
+        }
+        vector<vector<Ciphertext>> baby_steps(1);
+        evaluator_.rotate_vector_hoisted(encrypted, steps, galois_keys, baby_steps[0], pool);
+
+        Ciphertext conjugate(pool);
+        for (auto output : { make_pair(&lower, &lower_coeffs), make_pair(&upper, &upper_coeffs) })
+        {
+            linear_transform(baby_steps, *output.first, plain_scale, galois_keys, *output.second, pool);
+            evaluator_.complex_conjugate(*output.second, galois_keys, conjugate, pool);
+            evaluator_.add_inplace(*output.second, conjugate);
+        }
+    }
+
+    void CKKSBootstrapper::eval_mod_inplace(Ciphertext &encrypted, const RelinKeys &relin_keys, MemoryPoolHandle pool)
+    {
+        polynomial_evaluator_.evaluate(
+            encrypted, sine_coeffs_, poly_basis_type::chebyshev, relin_keys, encrypted, move(pool));
+    }
+
+    void CKKSBootstrapper::slot_to_coeff(
+        const Ciphertext &lower_coeffs, const Ciphertext &upper_coeffs, double scale, const GaloisKeys &galois_keys,
+        Ciphertext &destination, MemoryPoolHandle pool)
+    {
+        if (!is_metadata_valid_for(lower_coeffs, context_) || !is_buffer_valid(lower_coeffs))
+        {
+            throw invalid_argument("lower_coeffs is not valid for encryption parameters");
+        }
+        if (!is_metadata_valid_for(upper_coeffs, context_) || !is_buffer_valid(upper_coeffs))
+        {
+            throw invalid_argument("upper_coeffs is not valid for encryption parameters");
+        }
+        if (lower_coeffs.parms_id() != upper_coeffs.parms_id() || lower_coeffs.scale() != upper_coeffs.scale())
+        {
+            throw invalid_argument("lower_coeffs and upper_coeffs mismatch");
+        }
+        if (lower_coeffs.parms_id() == context_.last_parms_id())
+        {
+            throw invalid_argument("lower_coeffs and upper_coeffs are at the last level");
+        }
+
+        // Slot j of the result is sum_k zeta_j^k m_k, where m_k is coefficient k of the plaintext
+        vector<matrix_type> matrices{ [this](size_t row, size_t col) { return root_power(row, col); },
+                                      [this](size_t row, size_t col) { return root_power(row, col + slot_count_); } };
+
+        // The slots hold the coefficients divided by q_0, and the result is rescaled to q_0 before setting its scale
+        auto &coeff_modulus = context_.get_context_data(lower_coeffs.parms_id())->parms().coeff_modulus();
+        double dropped = static_cast<double>(coeff_modulus.back().value());
+        double q0 = static_cast<double>(coeff_modulus.front().value());
+        double plain_scale = q0 * dropped / lower_coeffs.scale();
+
+        vector<int> steps;
+        for (size_t a = 0; a < baby_step_count_; a++)
+        {
+            steps.push_back(static_cast<int>(a));
+        }
+        vector<vector<Ciphertext>> baby_steps(2);
+        evaluator_.rotate_vector_hoisted(lower_coeffs, steps, galois_keys, baby_steps[0], pool);
+        evaluator_.rotate_vector_hoisted(upper_coeffs, steps, galois_keys, baby_steps[1], pool);
+
+        linear_transform(baby_steps, matrices, plain_scale, galois_keys, destination, pool);
+        destination.scale() = scale;
+    }
+
+    vector<double> CKKSBootstrapper::ChebyshevCoefficients(const function<double(double)> &function, size_t degree)
+    {
+        size_t node_count = degree + 1;
+        vector<double> values(node_count);
+        for (size_t j = 0; j < node_count; j++)
+        {
+            values[j] = function(cos(pi * (static_cast<double>(j) + 0.5) / static_cast<double>(node_count)));
+        }
+
+        vector<double> coeffs(node_count);
+        for (size_t k = 0; k < node_count; k++)
+        {
+            double sum = 0;
+            for (size_t j = 0; j < node_count; j++)
+            {
+                double angle = pi * static_cast<double>(k) * (static_cast<double>(j) + 0.5);
+                sum += values[j] * cos(angle / static_cast<double>(node_count));
+            }
+            coeffs[k] = 2 * sum / static_cast<double>(node_count);
+        }
+        coeffs[0] /= 2;
+        return coeffs;
+    }
+
+    void CKKSBootstrapper::linear_transform(
+        const vector<vector<Ciphertext>> &baby_steps, const vector<matrix_type> &matrices, double plain_scale,
+        const GaloisKeys &galois_keys, Ciphertext &destination, MemoryPoolHandle pool)
+    {
+        // With d = g b + a, the d-th diagonal times the input rotated by d equals the rotation by g b of the d-th
+        // diagonal rotated by -g b times the input rotated by a; the inner sums over a only need the baby steps
+        auto parms_id = baby_steps[0][0].parms_id();
+        vector<complex<double>> diagonal(slot_count_);
+        Plaintext plain(pool);
+        Ciphertext inner(pool);
+        Ciphertext term(pool);
+        Ciphertext result(pool);
+        for (size_t b = 0; b * baby_step_count_ < slot_count_; b++)
+        {
+            size_t giant_step = b * baby_step_count_;
+            bool inner_empty = true;
+            for (size_t i = 0; i < matrices.size(); i++)
+            {
+                for (size_t a = 0; a < baby_step_count_; a++)
+                {
+                    for (size_t j = 0; j < slot_count_; j++)
+                    {
+                        diagonal[j] = matrices[i]((j + slot_count_ - giant_step) % slot_count_, (j + a) % slot_count_);
+                    }
+                    encoder_.encode(diagonal, parms_id, plain_scale, plain, pool);
+                    if (inner_empty)
+                    {
+                        evaluator_.multiply_plain(baby_steps[i][a], plain, inner, pool);
+                        inner_empty = false;
+                    }
+                    else
+                    {
+                        evaluator_.multiply_plain(baby_steps[i][a], plain, term, pool);
+                        evaluator_.add_inplace(inner, term);
+                    }
+                }
+            }
+
+            if (giant_step)
+            {
+                evaluator_.rotate_vector_inplace(inner, static_cast<int>(giant_step), galois_keys, pool);
+                evaluator_.add_inplace(result, inner);
+            }
+            else
+            {
+                swap(result, inner);
+            }
+        }
+        evaluator_.rescale_to_next(result, destination, move(pool));
+    }
+
+    complex<double> CKKSBootstrapper::root_power(size_t row, size_t power) const
+    {
+        size_t m = slot_count_ << 2;
+        return roots_[(slot_exponents_[row] * power) & (m - 1)];
+    }
+} // namespace seal
@@ -0,0 +1,252 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/ciphertext.h"
+#include "seal/ckks.h"
+#include "seal/context.h"
+#include "seal/evaluator.h"
+#include "seal/galoiskeys.h"
+#include "seal/memorymanager.h"
+#include "seal/polynomialevaluator.h"
+#include "seal/relinkeys.h"
+#include "seal/util/defines.h"
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace seal
+{
+    /**
+    Refreshes CKKS ciphertexts that have run out of levels, so that the computation can continue without decrypting.
+    Bootstrapping consists of four steps:
+
+    1. mod_raise interprets a ciphertext at the last level, with coefficient modulus q_0, as a ciphertext at the first
+    level. It then decrypts to m + q_0 * I for the original plaintext polynomial m and a polynomial I with small
+    integer coefficients.
+    2. coeff_to_slot homomorphically moves the coefficients of this polynomial into the slots of two ciphertexts,
+    divided by q_0, one for the lower and one for the upper half of the coefficients.
+    3. eval_mod_inplace removes the integer parts I from the slots by evaluating a Chebyshev approximation of the sine
+    function (1 / 2pi) sin(2pi x), which is close to x - round(x) when the fractional part of x is small.
+    4. slot_to_coeff moves the remaining values m / q_0 back into the coefficients and restores the scale of the input.
+
+    The result encrypts the same values as the input at the level reached after depth levels have been consumed from
+    the first level.
+
+    @par Parameters
+    The secret key must be sparse, as generated by the KeyGenerator constructor that takes a Hamming weight, since the
+    coefficients of I are bounded by about half the Hamming weight h and the degree of the sine approximation grows
+    linearly with this bound. The first prime in the coefficient modulus must be considerably larger than the scale of
+    the ciphertexts to bootstrap, as the precision of the result is limited by the ratio of the two. The primes that
+    are consumed by bootstrapping are best chosen large (for example 60 bits), and the scale used while bootstrapping
+    is the last prime of the first level.
+
+    @par Linear Transformations
+    coeff_to_slot and slot_to_coeff multiply the slot vector with dense matrices, using the baby-step giant-step
+    algorithm on the diagonals of the matrices. The baby-step rotations of a ciphertext are computed with
+    Evaluator::rotate_vector_hoisted, so the decomposition needed for key switching is shared between them. The
+    diagonals are encoded when they are needed rather than stored, which keeps the memory use independent of the
+    number of slots. The number of plaintext multiplications is quadratic in the number of slots, which makes
+    bootstrapping with large polynomial modulus degrees slow; transformations factored into sparse FFT-like stages are
+    not implemented.
+
+    @par Galois Keys
+    The Galois keys passed to the bootstrapping functions must contain the rotations returned by galois_steps, which
+    includes the complex conjugation.
+
+    @par Thread Safety
+    A CKKSBootstrapper keeps state while bootstrapping, so concurrent calls must use separate instances.
+    */
+    class CKKSBootstrapper
+    {
+    public:
+        /**
+        Creates a CKKSBootstrapper for ciphertexts encrypted under a secret key with a given Hamming weight.
+
+        @param[in] context The SEALContext
+        @param[in] hamming_weight The number of nonzero coefficients in the secret key
+        @param[in] sine_degree The degree of the Chebyshev approximation of the sine function, or zero to choose the
+        smallest degree of the form 2^k - 1 that gives an approximation error below 2^-40
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if the scheme is not scheme_type::ckks
+        @throws std::invalid_argument if hamming_weight is zero or larger than the degree of the polynomial modulus
+        @throws std::invalid_argument if the encryption parameters do not have depth levels above the last level
+        @throws std::logic_error if the encryption parameters do not support batching or keyswitching
+        */
+        CKKSBootstrapper(const SEALContext &context, std::size_t hamming_weight, std::size_t sine_degree = 0);
+
+        /**
+        Returns the rotation steps for which Galois keys are needed, including zero for the complex conjugation.
+        */
+        SEAL_NODISCARD std::vector<int> galois_steps() const;
+
+        /**
+        Returns the maximum number of levels consumed by bootstrapping.
+        */
+        SEAL_NODISCARD inline std::size_t depth() const noexcept
+        {
+            return depth_;
+        }
+
+        /**
+        Returns the degree of the Chebyshev approximation of the sine function.
+        */
+        SEAL_NODISCARD inline std::size_t sine_degree() const noexcept
+        {
+            return sine_coeffs_.size() - 1;
+        }
+
+        /**
+        Bootstraps a ciphertext and stores the result in the destination parameter. The ciphertext is first switched
+        to the last level if it is not there yet. The result has the same scale as the input. Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to bootstrap
+        @param[in] relin_keys The relinearization keys
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The ciphertext to overwrite with the bootstrapped result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted, relin_keys, or galois_keys is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void bootstrap(
+            const Ciphertext &encrypted, const RelinKeys &relin_keys, const GaloisKeys &galois_keys,
+            Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Raises the coefficient modulus of a ciphertext at the last level to that of the first level, without changing
+        its coefficients as integers in the symmetric range around zero. The scale of the result is set to q_0, the
+        coefficient modulus of the last level. Dynamic memory allocations in the process are allocated from the memory
+        pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to raise, which is first switched to the last level if needed
+        @param[out] destination The ciphertext to overwrite with the raised ciphertext
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void mod_raise(
+            const Ciphertext &encrypted, Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Moves the coefficients of the plaintext polynomial encrypted by a raised ciphertext into slots. Slot j of
+        lower_coeffs and upper_coeffs holds coefficient j and j + N/2 respectively, divided by q_0 times the bound on
+        the integer parts used by eval_mod_inplace, where N is the degree of the polynomial modulus. Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted A ciphertext produced by mod_raise
+        @param[in] galois_keys The Galois keys
+        @param[out] lower_coeffs The ciphertext to overwrite with the lower half of the coefficients
+        @param[out] upper_coeffs The ciphertext to overwrite with the upper half of the coefficients
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is not at the first level
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void coeff_to_slot(
+            const Ciphertext &encrypted, const GaloisKeys &galois_keys, Ciphertext &lower_coeffs,
+            Ciphertext &upper_coeffs, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Reduces the slots of a ciphertext produced by coeff_to_slot modulo one, after undoing the division by the
+        bound on the integer parts. Dynamic memory allocations in the process are allocated from the memory pool
+        pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to reduce
+        @param[in] relin_keys The relinearization keys
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted or relin_keys is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted does not have enough levels left
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void eval_mod_inplace(
+            Ciphertext &encrypted, const RelinKeys &relin_keys, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Moves the lower and upper halves of the coefficients back from the slots into the coefficients of a single
+        ciphertext, undoing the division by q_0, and sets the scale of the result. Dynamic memory allocations in the
+        process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] lower_coeffs The lower half of the coefficients, as produced by eval_mod_inplace
+        @param[in] upper_coeffs The upper half of the coefficients, as produced by eval_mod_inplace
+        @param[in] scale The scale of the result, which is normally the scale of the ciphertext that was bootstrapped
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The ciphertext to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if lower_coeffs, upper_coeffs, or galois_keys is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if lower_coeffs and upper_coeffs are at different levels or scales
+        @throws std::invalid_argument if lower_coeffs and upper_coeffs are at the last level
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void slot_to_coeff(
+            const Ciphertext &lower_coeffs, const Ciphertext &upper_coeffs, double scale,
+            const GaloisKeys &galois_keys, Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Returns the Chebyshev coefficients of a function on [-1, 1], computed by interpolation in the Chebyshev nodes.
+        The result can be passed to PolynomialEvaluator::evaluate with poly_basis_type::chebyshev.
+
+        @param[in] function The function to approximate
+        @param[in] degree The degree of the approximation
+        */
+        SEAL_NODISCARD static std::vector<double> ChebyshevCoefficients(
+            const std::function<double(double)> &function, std::size_t degree);
+
+    private:
+        CKKSBootstrapper(const CKKSBootstrapper &copy) = delete;
+
+        CKKSBootstrapper(CKKSBootstrapper &&source) = delete;
+
+        CKKSBootstrapper &operator=(const CKKSBootstrapper &assign) = delete;
+
+        CKKSBootstrapper &operator=(CKKSBootstrapper &&assign) = delete;
+
+        using matrix_type = std::function<std::complex<double>(std::size_t row, std::size_t col)>;
+
+        // Computes the sum of the products of the matrices with the slot vectors of the inputs, where baby_steps[i]
+        // holds the rotations of the i-th input by 0, ..., baby_step_count_ - 1 steps, and rescales the result
+        void linear_transform(
+            const std::vector<std::vector<Ciphertext>> &baby_steps, const std::vector<matrix_type> &matrices,
+            double plain_scale, const GaloisKeys &galois_keys, Ciphertext &destination, MemoryPoolHandle pool);
+
+        // Returns zeta_row^power, where zeta_row is the root of unity at which slot row evaluates the plaintext
+        SEAL_NODISCARD std::complex<double> root_power(std::size_t row, std::size_t power) const;
+
+        SEALContext context_;
+
+        Evaluator evaluator_;
+
+        CKKSEncoder encoder_;
+
+        PolynomialEvaluator polynomial_evaluator_;
+
+        std::size_t slot_count_;
+
+        std::size_t baby_step_count_;
+
+        // Bound on the absolute value of the coefficients of q_0 * I plus the fractional part, divided by q_0
+        double bound_;
+
+        std::vector<double> sine_coeffs_;
+
+        std::size_t depth_;
+
+        // Exponents of the primitive 2N-th root of unity at which the slots evaluate the plaintext
+        std::vector<std::size_t> slot_exponents_;
+
+        // Powers of the primitive 2N-th root of unity
+        std::vector<std::complex<double>> roots_;
+    };
+} // namespace seal
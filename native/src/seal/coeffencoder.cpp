@@ -0,0 +1,269 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/coeffencoder.h"
+#include "seal/valcheck.h"
+#include "seal/util/common.h"
+#include "seal/util/ntt.h"
+#include "seal/util/pointer.h"
+#include "seal/util/uintcore.h"
+#include "seal/util/uintarithsmallmod.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    IntegerCoeffEncoder::IntegerCoeffEncoder(const SEALContext &context) : context_(context)
+    {
+        // Verify parameters
+        if (!context_.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+
+        auto &context_data = *context_.first_context_data();
+        if (context_data.parms().scheme() != scheme_type::bfv && context_data.parms().scheme() != scheme_type::bgv)
+        {
+            throw invalid_argument("unsupported scheme");
+        }
+
+        coeff_count_ = context_data.parms().poly_modulus_degree();
+    }
+
+    void IntegerCoeffEncoder::encode(const vector<uint64_t> &values, Plaintext &destination) const
+    {
+        // Validate input parameters
+        if (values.size() > coeff_count_)
+        {
+            throw invalid_argument("values is too large");
+        }
+        uint64_t modulus = context_.first_context_data()->parms().plain_modulus().value();
+        for (auto v : values)
+        {
+            if (v >= modulus)
+            {
+                throw invalid_argument("input value is larger than plain_modulus");
+            }
+        }
+
+        destination.parms_id() = parms_id_zero;
+        destination.resize(coeff_count_);
+        copy(values.begin(), values.end(), destination.data());
+        fill(destination.data() + values.size(), destination.data() + coeff_count_, uint64_t(0));
+    }
+
+    void IntegerCoeffEncoder::encode(const vector<int64_t> &values, Plaintext &destination) const
+    {
+        encode_internal(values, false, destination);
+    }
+
+    void IntegerCoeffEncoder::encode_reversed(const vector<int64_t> &values, Plaintext &destination) const
+    {
+        encode_internal(values, true, destination);
+    }
+
+    void IntegerCoeffEncoder::encode_internal(
+        const vector<int64_t> &values, bool reversed, Plaintext &destination) const
+    {
+        // Validate input parameters
+        if (values.size() > coeff_count_)
+        {
+            throw invalid_argument("values is too large");
+        }
+        auto &modulus = context_.first_context_data()->parms().plain_modulus();
+        uint64_t plain_modulus_div_two = modulus.value() >> 1;
+        for (auto v : values)
+        {
+            if (unsigned_gt(llabs(v), plain_modulus_div_two))
+            {
+                throw invalid_argument("input value is larger than plain_modulus");
+            }
+        }
+
+        destination.parms_id() = parms_id_zero;
+        destination.resize(coeff_count_);
+        set_zero_uint(coeff_count_, destination.data());
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            uint64_t value = (values[i] < 0) ? (modulus.value() + static_cast<uint64_t>(values[i]))
+                                             : static_cast<uint64_t>(values[i]);
+
+            // x^(-i) = -x^(N - i) in the negacyclic ring
+            if (reversed && i)
+            {
+                destination[coeff_count_ - i] = negate_uint_mod(value, modulus);
+            }
+            else
+            {
+                destination[i] = value;
+            }
+        }
+    }
+
+    void IntegerCoeffEncoder::decode(const Plaintext &plain, vector<uint64_t> &destination) const
+    {
+        if (!is_valid_for(plain, context_))
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+        if (plain.is_ntt_form())
+        {
+            throw invalid_argument("plain cannot be in NTT form");
+        }
+
+        // Never include the leading zero coefficient (if present)
+        size_t plain_coeff_count = min(plain.coeff_count(), coeff_count_);
+        destination.resize(coeff_count_);
+        copy(plain.data(), plain.data() + plain_coeff_count, destination.begin());
+        fill(destination.begin() + static_cast<ptrdiff_t>(plain_coeff_count), destination.end(), uint64_t(0));
+    }
+
+    void IntegerCoeffEncoder::decode(const Plaintext &plain, vector<int64_t> &destination) const
+    {
+        if (!is_valid_for(plain, context_))
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+        if (plain.is_ntt_form())
+        {
+            throw invalid_argument("plain cannot be in NTT form");
+        }
+
+        uint64_t modulus = context_.first_context_data()->parms().plain_modulus().value();
+        uint64_t plain_modulus_div_two = modulus >> 1;
+        size_t plain_coeff_count = min(plain.coeff_count(), coeff_count_);
+        destination.resize(coeff_count_);
+        for (size_t i = 0; i < coeff_count_; i++)
+        {
+            uint64_t curr_value = (i < plain_coeff_count) ? plain[i] : 0;
+            destination[i] = (curr_value > plain_modulus_div_two)
+                                 ? (static_cast<int64_t>(curr_value) - static_cast<int64_t>(modulus))
+                                 : static_cast<int64_t>(curr_value);
+        }
+    }
+
+    void IntegerCoeffEncoder::convolve_inplace(
+        Evaluator &evaluator, Ciphertext &encrypted, const vector<int64_t> &kernel, MemoryPoolHandle pool) const
+    {
+        Plaintext kernel_plain;
+        encode(kernel, kernel_plain);
+        evaluator.multiply_plain_inplace(encrypted, kernel_plain, move(pool));
+    }
+
+    void IntegerCoeffEncoder::correlate_inplace(
+        Evaluator &evaluator, Ciphertext &encrypted, const vector<int64_t> &kernel, MemoryPoolHandle pool) const
+    {
+        Plaintext kernel_plain;
+        encode_reversed(kernel, kernel_plain);
+        evaluator.multiply_plain_inplace(encrypted, kernel_plain, move(pool));
+    }
+
+    CKKSCoeffEncoder::CKKSCoeffEncoder(const SEALContext &context) : context_(context), encoder_(context)
+    {
+        coeff_count_ = context_.first_context_data()->parms().poly_modulus_degree();
+    }
+
+    void CKKSCoeffEncoder::encode(
+        const vector<double> &values, parms_id_type parms_id, double scale, Plaintext &destination,
+        MemoryPoolHandle pool) const
+    {
+        encode_internal(values, false, parms_id, scale, destination, move(pool));
+    }
+
+    void CKKSCoeffEncoder::encode_reversed(
+        const vector<double> &values, parms_id_type parms_id, double scale, Plaintext &destination,
+        MemoryPoolHandle pool) const
+    {
+        encode_internal(values, true, parms_id, scale, destination, move(pool));
+    }
+
+    void CKKSCoeffEncoder::encode_internal(
+        const vector<double> &values, bool reversed, parms_id_type parms_id, double scale, Plaintext &destination,
+        MemoryPoolHandle pool) const
+    {
+        // Verify parameters.
+        auto &context_data = encoder_.verify_encode_parameters(parms_id, scale, pool);
+        if (values.size() > coeff_count_)
+        {
+            throw invalid_argument("values is too large");
+        }
+
+        size_t coeff_modulus_size = context_data.parms().coeff_modulus().size();
+        auto ntt_tables = context_data.small_ntt_tables();
+
+        // x^(-i) = -x^(N - i) in the negacyclic ring
+        auto coeffs = allocate<double>(coeff_count_, pool, 0);
+        double max_coeff = 0;
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            double value = values[i] * scale;
+            if (reversed && i)
+            {
+                coeffs[coeff_count_ - i] = -value;
+            }
+            else
+            {
+                coeffs[i] = value;
+            }
+            max_coeff = max<>(max_coeff, fabs(value));
+        }
+
+        // Verify that the values are not too large to fit in coeff_modulus
+        // Note that we have an extra + 1 for the sign bit
+        int max_coeff_bit_count = static_cast<int>(ceil(log2(max<>(max_coeff, 1.0)))) + 1;
+        if (max_coeff_bit_count >= context_data.total_coeff_modulus_bit_count())
+        {
+            throw invalid_argument("encoded values are too large");
+        }
+
+        destination.parms_id() = parms_id_zero;
+        destination.resize(mul_safe(coeff_count_, coeff_modulus_size));
+        encoder_.coeffs_to_rns(coeffs.get(), max_coeff_bit_count, context_data, destination.data(), pool);
+
+        // Transform to NTT domain
+        for (size_t i = 0; i < coeff_modulus_size; i++)
+        {
+            ntt_negacyclic_harvey(destination.data(i * coeff_count_), ntt_tables[i]);
+        }
+
+        destination.parms_id() = context_data.parms_id();
+        destination.scale() = scale;
+    }
+
+    void CKKSCoeffEncoder::decode(const Plaintext &plain, vector<double> &destination, MemoryPoolHandle pool) const
+    {
+        auto &context_data = encoder_.verify_decode_parameters(plain, pool);
+        destination.resize(coeff_count_);
+        encoder_.decode_to_coeffs(plain, context_data, destination.data(), move(pool));
+    }
+
+    void CKKSCoeffEncoder::convolve_inplace(
+        Evaluator &evaluator, Ciphertext &encrypted, const vector<double> &kernel, double scale,
+        MemoryPoolHandle pool) const
+    {
+        if (!is_metadata_valid_for(encrypted, context_))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        Plaintext kernel_plain;
+        encode(kernel, encrypted.parms_id(), scale, kernel_plain, pool);
+        evaluator.multiply_plain_inplace(encrypted, kernel_plain, move(pool));
+    }
+
+    void CKKSCoeffEncoder::correlate_inplace(
+        Evaluator &evaluator, Ciphertext &encrypted, const vector<double> &kernel, double scale,
+        MemoryPoolHandle pool) const
+    {
+        if (!is_metadata_valid_for(encrypted, context_))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        Plaintext kernel_plain;
+        encode_reversed(kernel, encrypted.parms_id(), scale, kernel_plain, pool);
+        evaluator.multiply_plain_inplace(encrypted, kernel_plain, move(pool));
+    }
+} // namespace seal
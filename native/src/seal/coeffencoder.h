@@ -0,0 +1,281 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/ciphertext.h"
+#include "seal/ckks.h"
+#include "seal/context.h"
+#include "seal/evaluator.h"
+#include "seal/memorymanager.h"
+#include "seal/plaintext.h"
+#include "seal/util/defines.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace seal
+{
+    /**
+    Encodes vectors of integers directly as the coefficients of BFV and BGV plaintext polynomials, instead of in the
+    batching slots. The i-th value becomes the coefficient of x^i, reduced modulo the plaintext modulus, so the
+    product of two encodings holds the negacyclic convolution of the vectors. No batching support is needed for the
+    plain_modulus.
+
+    @par Convolutions
+    If a and b have sizes n and k with n + k - 1 at most the degree N of the polynomial modulus, the product of their
+    encodings holds the linear convolution c_i = sum_j a_(i-j) * b_j in its first n + k - 1 coefficients. The reversed
+    encoding of b puts b_j at x^(-j) = -x^(N-j), so that the product with the encoding of a holds the correlation
+    c_i = sum_j a_(i+j) * b_j in the coefficients i = 0, ..., n - k, for example for sliding inner products or
+    polynomial matching. convolve_inplace and correlate_inplace compute these with a single Evaluator::multiply_plain
+    on an encrypted vector a, without any rotations.
+    */
+    class IntegerCoeffEncoder
+    {
+    public:
+        /**
+        Creates an IntegerCoeffEncoder for the specified SEALContext.
+
+        @param[in] context The SEALContext
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if scheme is not scheme_type::bfv or scheme_type::bgv
+        */
+        IntegerCoeffEncoder(const SEALContext &context);
+
+        /**
+        Encodes a vector of integers modulo the plaintext modulus as the coefficients of a plaintext polynomial.
+
+        @param[in] values The integers to encode
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if values is larger than the degree of the polynomial modulus
+        @throws std::invalid_argument if any value is not less than the plaintext modulus
+        */
+        void encode(const std::vector<std::uint64_t> &values, Plaintext &destination) const;
+
+        /**
+        Encodes a vector of signed integers as the coefficients of a plaintext polynomial, with negative values
+        represented as their sum with the plaintext modulus.
+
+        @param[in] values The integers to encode
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if values is larger than the degree of the polynomial modulus
+        @throws std::invalid_argument if the absolute value of any value is larger than half the plaintext modulus
+        */
+        void encode(const std::vector<std::int64_t> &values, Plaintext &destination) const;
+
+        /**
+        Encodes a vector of signed integers in reverse, with the i-th value as the coefficient of x^(-i), for
+        computing correlations.
+
+        @param[in] values The integers to encode
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if values is larger than the degree of the polynomial modulus
+        @throws std::invalid_argument if the absolute value of any value is larger than half the plaintext modulus
+        */
+        void encode_reversed(const std::vector<std::int64_t> &values, Plaintext &destination) const;
+
+        /**
+        Decodes the coefficients of a plaintext polynomial into integers modulo the plaintext modulus.
+
+        @param[in] plain The plaintext polynomial to decode
+        @param[out] destination The vector to overwrite with all coefficients
+        @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is in NTT form
+        */
+        void decode(const Plaintext &plain, std::vector<std::uint64_t> &destination) const;
+
+        /**
+        Decodes the coefficients of a plaintext polynomial into signed integers, mapping the coefficients larger than
+        half the plaintext modulus to negative values.
+
+        @param[in] plain The plaintext polynomial to decode
+        @param[out] destination The vector to overwrite with all coefficients
+        @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is in NTT form
+        */
+        void decode(const Plaintext &plain, std::vector<std::int64_t> &destination) const;
+
+        /**
+        Multiplies an encrypted vector with a plaintext kernel, so that the result holds their convolution.
+
+        @param[in] evaluator The Evaluator to multiply with
+        @param[in] encrypted The encrypted vector to overwrite with the convolution
+        @param[in] kernel The kernel
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if kernel is larger than the degree of the polynomial modulus or has too large
+        values
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void convolve_inplace(
+            Evaluator &evaluator, Ciphertext &encrypted, const std::vector<std::int64_t> &kernel,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Multiplies an encrypted vector with the reversed encoding of a plaintext kernel, so that the result holds
+        their correlation.
+
+        @param[in] evaluator The Evaluator to multiply with
+        @param[in] encrypted The encrypted vector to overwrite with the correlation
+        @param[in] kernel The kernel
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if kernel is larger than the degree of the polynomial modulus or has too large
+        values
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void correlate_inplace(
+            Evaluator &evaluator, Ciphertext &encrypted, const std::vector<std::int64_t> &kernel,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Returns the number of coefficients, which is the degree of the polynomial modulus.
+        */
+        SEAL_NODISCARD inline std::size_t coeff_count() const noexcept
+        {
+            return coeff_count_;
+        }
+
+    private:
+        // Encodes the i-th value at x^i, or at x^(-i) if reversed is set
+        void encode_internal(const std::vector<std::int64_t> &values, bool reversed, Plaintext &destination) const;
+
+        SEALContext context_;
+
+        std::size_t coeff_count_;
+    };
+
+    /**
+    Encodes vectors of real numbers directly as the coefficients of CKKS plaintext polynomials, instead of in the
+    slots. The i-th value multiplied by the scale becomes the i-th coefficient, rounded to an integer and lifted to the
+    coefficient modulus; the plaintext is in NTT form like those created by CKKSEncoder. The product of two encodings
+    holds the negacyclic convolution of the vectors, at the product of the scales.
+
+    @par Convolutions
+    Products of encodings and reversed encodings give convolutions and correlations in the coefficients as described
+    for IntegerCoeffEncoder. Since no rotations are needed, no Galois keys have to be generated. The result of
+    convolve_inplace and correlate_inplace is at the product of the scales and usually needs to be rescaled.
+    */
+    class CKKSCoeffEncoder
+    {
+    public:
+        /**
+        Creates a CKKSCoeffEncoder for the specified SEALContext.
+
+        @param[in] context The SEALContext
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if scheme is not scheme_type::ckks
+        */
+        CKKSCoeffEncoder(const SEALContext &context);
+
+        /**
+        Encodes a vector of real numbers as the coefficients of a plaintext polynomial at the given level and scale.
+
+        @param[in] values The numbers to encode
+        @param[in] parms_id The parms_id of the level of the plaintext
+        @param[in] scale The scale of the plaintext
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if values is larger than the degree of the polynomial modulus
+        @throws std::invalid_argument if parms_id is not valid for the encryption parameters
+        @throws std::invalid_argument if scale is not strictly positive or too large
+        @throws std::invalid_argument if the encoding is too large for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void encode(
+            const std::vector<double> &values, parms_id_type parms_id, double scale, Plaintext &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Encodes a vector of real numbers in reverse, with the i-th value as the coefficient of x^(-i), for computing
+        correlations.
+
+        @param[in] values The numbers to encode
+        @param[in] parms_id The parms_id of the level of the plaintext
+        @param[in] scale The scale of the plaintext
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if values is larger than the degree of the polynomial modulus
+        @throws std::invalid_argument if parms_id is not valid for the encryption parameters
+        @throws std::invalid_argument if scale is not strictly positive or too large
+        @throws std::invalid_argument if the encoding is too large for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void encode_reversed(
+            const std::vector<double> &values, parms_id_type parms_id, double scale, Plaintext &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Decodes the coefficients of a plaintext polynomial, divided by its scale.
+
+        @param[in] plain The plaintext polynomial to decode
+        @param[out] destination The vector to overwrite with all coefficients
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if plain is not in NTT form or is not valid for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode(
+            const Plaintext &plain, std::vector<double> &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Multiplies an encrypted vector with a plaintext kernel encoded at the level of encrypted and the given scale,
+        so that the result holds their convolution at the product of the scales.
+
+        @param[in] evaluator The Evaluator to multiply with
+        @param[in] encrypted The encrypted vector to overwrite with the convolution
+        @param[in] kernel The kernel
+        @param[in] scale The scale to encode the kernel at
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if kernel is larger than the degree of the polynomial modulus
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if scale is not strictly positive or too large
+        @throws std::invalid_argument if the output scale is too large for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void convolve_inplace(
+            Evaluator &evaluator, Ciphertext &encrypted, const std::vector<double> &kernel, double scale,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Multiplies an encrypted vector with the reversed encoding of a plaintext kernel at the level of encrypted and
+        the given scale, so that the result holds their correlation at the product of the scales.
+
+        @param[in] evaluator The Evaluator to multiply with
+        @param[in] encrypted The encrypted vector to overwrite with the correlation
+        @param[in] kernel The kernel
+        @param[in] scale The scale to encode the kernel at
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if kernel is larger than the degree of the polynomial modulus
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if scale is not strictly positive or too large
+        @throws std::invalid_argument if the output scale is too large for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void correlate_inplace(
+            Evaluator &evaluator, Ciphertext &encrypted, const std::vector<double> &kernel, double scale,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Returns the number of coefficients, which is the degree of the polynomial modulus.
+        */
+        SEAL_NODISCARD inline std::size_t coeff_count() const noexcept
+        {
+            return coeff_count_;
+        }
+
+    private:
+        void encode_internal(
+            const std::vector<double> &values, bool reversed, parms_id_type parms_id, double scale,
+            Plaintext &destination, MemoryPoolHandle pool) const;
+
+        SEALContext context_;
+
+        // Provides the rounding, RNS lifting, and CRT composition shared with slot encoding
+        CKKSEncoder encoder_;
+
+        std::size_t coeff_count_;
+    };
+} // namespace seal
@@ -86,7 +86,7 @@ namespace seal
             return "valid";
 
         case error_type::invalid_scheme:
-            return "scheme must be BFV or CKKS";
+            return "scheme must be BFV, CKKS, or BGV";
 
         case error_type::invalid_coeff_modulus_size:
             return "coeff_modulus's primes' count is not bounded by SEAL_COEFF_MOD_COUNT_MIN(MAX)";
@@ -132,7 +132,7 @@ namespace seal
         }
     }
 
-    SEALContext::ContextData SEALContext::validate(EncryptionParameters parms)
+    SEALContext::ContextData SEALContext::validate(EncryptionParameters parms, const vector<uint32_t> &galois_elts)
     {
         ContextData context_data(parms, pool_);
         context_data.qualifiers_.parameter_error = error_type::success;
@@ -250,7 +250,7 @@ namespace seal
             return context_data;
         }
 
-        if (parms.scheme() == scheme_type::bfv)
+        if (parms.scheme() == scheme_type::bfv || parms.scheme() == scheme_type::bgv)
         {
             // Plain modulus must be at least 2 and at most 60 bits
             if (plain_modulus.value() >> SEAL_PLAIN_MOD_BIT_COUNT_MAX ||
@@ -412,14 +412,15 @@ namespace seal
                 (coeff_modulus[i].value() > coeff_modulus[i + 1].value());
         }
 
-        // Create GaloisTool
-        context_data.galois_tool_ = allocate<GaloisTool>(pool_, coeff_count_power, pool_);
+        // Create GaloisTool; the precomputed tables are shared by all levels
+        context_data.galois_tool_ = allocate<GaloisTool>(pool_, coeff_count_power, galois_elts, pool_);
 
         // Done with validation and pre-computations
         return context_data;
     }
 
-    parms_id_type SEALContext::create_next_context_data(const parms_id_type &prev_parms_id)
+    parms_id_type SEALContext::create_next_context_data(
+        const parms_id_type &prev_parms_id, const vector<uint32_t> &galois_elts)
     {
         // Create the next set of parameters by removing last modulus
         auto next_parms = context_data_map_.at(prev_parms_id)->parms_;
@@ -429,7 +430,7 @@ namespace seal
         auto next_parms_id = next_parms.parms_id();
 
         // Validate next parameters and create next context_data
-        auto next_context_data = validate(next_parms);
+        auto next_context_data = validate(next_parms, galois_elts);
 
         // If not valid then return zero parms_id
         if (!next_context_data.qualifiers_.parameters_set())
@@ -452,7 +453,8 @@ namespace seal
     }
 
     SEALContext::SEALContext(
-        EncryptionParameters parms, bool expand_mod_chain, sec_level_type sec_level, MemoryPoolHandle pool)
+        EncryptionParameters parms, bool expand_mod_chain, sec_level_type sec_level,
+        const vector<uint32_t> &galois_elts, MemoryPoolHandle pool)
         : pool_(move(pool)), sec_level_(sec_level)
     {
         if (!pool_)
@@ -470,7 +472,8 @@ namespace seal
         // Note that this happens even if parameters are not valid
 
         // First create key_parms_id_.
-        context_data_map_.emplace(make_pair(parms.parms_id(), make_shared<const ContextData>(validate(parms))));
+        context_data_map_.emplace(
+            make_pair(parms.parms_id(), make_shared<const ContextData>(validate(parms, galois_elts))));
         key_parms_id_ = parms.parms_id();
 
         // Then create first_parms_id_ if the parameters are valid and there is
@@ -483,7 +486,7 @@ namespace seal
         }
         else
         {
-            auto next_parms_id = create_next_context_data(key_parms_id_);
+            auto next_parms_id = create_next_context_data(key_parms_id_, galois_elts);
             first_parms_id_ = (next_parms_id == parms_id_zero) ? key_parms_id_ : next_parms_id;
         }
 
@@ -500,7 +503,7 @@ namespace seal
             auto prev_parms_id = first_parms_id_;
             while (context_data_map_.at(prev_parms_id)->parms().coeff_modulus().size() > 1)
             {
-                auto next_parms_id = create_next_context_data(prev_parms_id);
+                auto next_parms_id = create_next_context_data(prev_parms_id, galois_elts);
                 if (next_parms_id == parms_id_zero)
                 {
                     break;
@@ -10,8 +10,10 @@
 #include "seal/util/ntt.h"
 #include "seal/util/pointer.h"
 #include "seal/util/rns.h"
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace seal
 {
@@ -44,7 +46,7 @@ namespace seal
             success = 0,
 
             /**
-            scheme must be BFV or CKKS
+            scheme must be BFV, CKKS, or BGV
             */
             invalid_scheme = 1,
 
@@ -493,7 +495,31 @@ namespace seal
         SEALContext(
             const EncryptionParameters &parms, bool expand_mod_chain = true,
             sec_level_type sec_level = sec_level_type::tc128)
-            : SEALContext(parms, expand_mod_chain, sec_level, MemoryManager::GetPool())
+            : SEALContext(parms, expand_mod_chain, sec_level, {}, MemoryManager::GetPool())
+        {}
+
+        /**
+        Creates an instance of SEALContext and performs several pre-computations
+        on the given EncryptionParameters. In addition, the NTT permutation tables
+        for the given Galois elements are computed up front, so that rotations by
+        these elements never take a lock or incur first-use latency. The tables are
+        shared process-wide between all SEALContext instances with the same
+        poly_modulus_degree.
+
+        @param[in] parms The encryption parameters
+        @param[in] expand_mod_chain Determines whether the modulus switching chain
+        should be created
+        @param[in] sec_level Determines whether a specific security level should be
+        enforced according to HomomorphicEncryption.org security standard
+        @param[in] galois_elts The Galois elements whose permutation tables to
+        precompute
+        @throws std::invalid_argument if a Galois element is not valid for the
+        encryption parameters
+        */
+        SEALContext(
+            const EncryptionParameters &parms, bool expand_mod_chain, sec_level_type sec_level,
+            const std::vector<std::uint32_t> &galois_elts)
+            : SEALContext(parms, expand_mod_chain, sec_level, galois_elts, MemoryManager::GetPool())
         {}
 
         /**
@@ -642,12 +668,17 @@ namespace seal
         should be created
         @param[in] sec_level Determines whether a specific security level should be
         enforced according to HomomorphicEncryption.org security standard
+        @param[in] galois_elts The Galois elements whose permutation tables to
+        precompute
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if a Galois element is not valid
         @throws std::invalid_argument if pool is uninitialized
         */
-        SEALContext(EncryptionParameters parms, bool expand_mod_chain, sec_level_type sec_level, MemoryPoolHandle pool);
+        SEALContext(
+            EncryptionParameters parms, bool expand_mod_chain, sec_level_type sec_level,
+            const std::vector<std::uint32_t> &galois_elts, MemoryPoolHandle pool);
 
-        ContextData validate(EncryptionParameters parms);
+        ContextData validate(EncryptionParameters parms, const std::vector<std::uint32_t> &galois_elts);
 
         /**
         Create the next context_data by dropping the last element from coeff_modulus.
@@ -655,7 +686,8 @@ namespace seal
         Otherwise, returns the parms_id of the next parameter and appends the next
         context_data to the chain.
         */
-        parms_id_type create_next_context_data(const parms_id_type &prev_parms);
+        parms_id_type create_next_context_data(
+            const parms_id_type &prev_parms, const std::vector<std::uint32_t> &galois_elts);
 
         MemoryPoolHandle pool_;
 
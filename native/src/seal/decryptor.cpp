@@ -4,10 +4,12 @@
 #include "seal/decryptor.h"
 #include "seal/valcheck.h"
 #include "seal/util/common.h"
+#include "seal/util/ntt.h"
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/polycore.h"
 #include "seal/util/scalingvariant.h"
 #include "seal/util/uintarith.h"
+#include "seal/util/uintarithsmallmod.h"
 #include "seal/util/uintcore.h"
 #include <algorithm>
 #include <stdexcept>
@@ -102,6 +104,10 @@ namespace seal
             ckks_decrypt(encrypted, destination, pool_);
             return;
 
+        case scheme_type::bgv:
+            bgv_decrypt(encrypted, destination, pool_);
+            return;
+
         default:
             throw invalid_argument("unsupported scheme");
         }
@@ -182,6 +188,54 @@ namespace seal
         destination.scale() = encrypted.scale();
     }
 
+    void Decryptor::bgv_decrypt(const Ciphertext &encrypted, Plaintext &destination, MemoryPoolHandle pool)
+    {
+        if (!encrypted.is_ntt_form())
+        {
+            throw invalid_argument("encrypted must be in NTT form");
+        }
+
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        auto &plain_modulus = parms.plain_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_modulus_size = coeff_modulus.size();
+
+        // Firstly find c_0 + c_1 *s + ... + c_{count-1} * s^{count-1} mod q
+        // This is equal to correction_factor * m + t * v where ||t * v|| < q/2.
+        // Reducing the centered representative modulo t and multiplying by the
+        // inverse of the correction factor gives m.
+        SEAL_ALLOCATE_ZERO_GET_RNS_ITER(tmp_dest_modq, coeff_count, coeff_modulus_size, pool);
+        dot_product_ct_sk_array(encrypted, tmp_dest_modq, pool);
+        inverse_ntt_negacyclic_harvey(tmp_dest_modq, coeff_modulus_size, context_data.small_ntt_tables());
+
+        // Allocate a full size destination to write to
+        destination.parms_id() = parms_id_zero;
+        destination.resize(coeff_count);
+
+        // Reduce the centered representative modulo t
+        context_data.rns_tool()->decrypt_modt(tmp_dest_modq, destination.data(), pool);
+
+        // Remove the correction factor
+        if (encrypted.correction_factor() != 1)
+        {
+            uint64_t fix = 1;
+            if (!try_invert_uint_mod(encrypted.correction_factor(), plain_modulus, fix))
+            {
+                throw logic_error("invalid correction factor");
+            }
+            multiply_poly_scalar_coeffmod(
+                CoeffIter(destination.data()), coeff_count, fix, plain_modulus, CoeffIter(destination.data()));
+        }
+
+        // How many non-zero coefficients do we really have in the result?
+        size_t plain_coeff_count = get_significant_uint64_count_uint(destination.data(), coeff_count);
+
+        // Resize destination to appropriate size
+        destination.resize(max(plain_coeff_count, size_t(1)));
+    }
+
     void Decryptor::compute_secret_key_array(size_t max_power)
     {
 #ifdef SEAL_DEBUG
@@ -313,14 +367,19 @@ namespace seal
             throw invalid_argument("encrypted is empty");
         }
 
-        if (context_.key_context_data()->parms().scheme() != scheme_type::bfv)
+        auto scheme = context_.key_context_data()->parms().scheme();
+        if (scheme != scheme_type::bfv && scheme != scheme_type::bgv)
         {
             throw logic_error("unsupported scheme");
         }
-        if (encrypted.is_ntt_form())
+        if (scheme == scheme_type::bfv && encrypted.is_ntt_form())
         {
             throw invalid_argument("encrypted cannot be in NTT form");
         }
+        if (scheme == scheme_type::bgv && !encrypted.is_ntt_form())
+        {
+            throw invalid_argument("encrypted must be in NTT form");
+        }
 
         auto &context_data = *context_.get_context_data(encrypted.parms_id());
         auto &parms = context_data.parms();
@@ -344,9 +403,18 @@ namespace seal
         // The secret key powers are already NTT transformed.
         dot_product_ct_sk_array(encrypted, noise_poly, pool_);
 
-        // Multiply by plain_modulus and reduce mod coeff_modulus to get
-        // coeff_modulus()*noise.
-        multiply_poly_scalar_coeffmod(noise_poly, coeff_modulus_size, plain_modulus.value(), coeff_modulus, noise_poly);
+        if (scheme == scheme_type::bfv)
+        {
+            // Multiply by plain_modulus and reduce mod coeff_modulus to get
+            // coeff_modulus()*noise.
+            multiply_poly_scalar_coeffmod(
+                noise_poly, coeff_modulus_size, plain_modulus.value(), coeff_modulus, noise_poly);
+        }
+        else
+        {
+            // In BGV the noise is c(s) itself, relative to coeff_modulus()
+            inverse_ntt_negacyclic_harvey(noise_poly, coeff_modulus_size, context_data.small_ntt_tables());
+        }
 
         // CRT-compose the noise
         context_data.rns_tool()->base_q()->compose_array(noise_poly, coeff_count, pool_);
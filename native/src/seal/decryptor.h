@@ -42,7 +42,9 @@ namespace seal
     When using the BFV scheme (scheme_type::bfv), all plaintext and ciphertexts
     should remain by default in the usual coefficient representation, i.e. not in
     NTT form. When using the CKKS scheme (scheme_type::ckks), all plaintexts and
-    ciphertexts should remain by default in NTT form. We call these scheme-specific
+    ciphertexts should remain by default in NTT form. When using the BGV scheme
+    (scheme_type::bgv), plaintexts should remain in the usual coefficient
+    representation and ciphertexts in NTT form. We call these scheme-specific
     NTT states the "default NTT form". Decryption requires the input ciphertexts
     to be in the default NTT form, and will throw an exception if this is not the
     case.
@@ -77,7 +79,9 @@ namespace seal
         Computes the invariant noise budget (in bits) of a ciphertext. The
         invariant noise budget measures the amount of room there is for the noise
         to grow while ensuring correct decryptions. This function works only with
-        the BFV scheme.
+        the BFV and BGV schemes. For BGV the invariant noise is the infinity-norm
+        of the decryption of the ciphertext before reduction modulo the plaintext
+        modulus, divided by the coefficient modulus.
 
         @par Invariant Noise Budget
         The invariant noise polynomial of a ciphertext is a rational coefficient
@@ -92,10 +96,10 @@ namespace seal
         becomes too noisy to decrypt correctly.
 
         @param[in] encrypted The ciphertext
-        @throws std::invalid_argument if the scheme is not BFV
+        @throws std::invalid_argument if the scheme is not BFV or BGV
         @throws std::invalid_argument if encrypted is not valid for the encryption
         parameters
-        @throws std::invalid_argument if encrypted is in NTT form
+        @throws std::invalid_argument if encrypted is not in the default NTT form
         */
         SEAL_NODISCARD int invariant_noise_budget(const Ciphertext &encrypted);
 
@@ -104,6 +108,8 @@ namespace seal
 
         void ckks_decrypt(const Ciphertext &encrypted, Plaintext &destination, MemoryPoolHandle pool);
 
+        void bgv_decrypt(const Ciphertext &encrypted, Plaintext &destination, MemoryPoolHandle pool);
+
         Decryptor(const Decryptor &copy) = delete;
 
         Decryptor(Decryptor &&source) = delete;
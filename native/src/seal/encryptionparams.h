@@ -31,7 +31,10 @@ namespace seal
         bfv = 0x1,
 
         // Cheon-Kim-Kim-Song scheme
-        ckks = 0x2
+        ckks = 0x2,
+
+        // Brakerski-Gentry-Vaikuntanathan scheme
+        bgv = 0x3
     };
 
     /**
@@ -216,13 +219,13 @@ namespace seal
         form.
 
         @param[in] plain_modulus The new plaintext modulus
-        @throws std::logic_error if scheme is not scheme_type::BFV and plain_modulus
-        is non-zero
+        @throws std::logic_error if scheme is not scheme_type::BFV or scheme_type::BGV
+        and plain_modulus is non-zero
         */
         inline void set_plain_modulus(const Modulus &plain_modulus)
         {
-            // Check that scheme is BFV
-            if (scheme_ != scheme_type::bfv && !plain_modulus.is_zero())
+            // Check that scheme is BFV or BGV
+            if (scheme_ != scheme_type::bfv && scheme_ != scheme_type::bgv && !plain_modulus.is_zero())
             {
                 throw std::logic_error("plain_modulus is not supported for this scheme");
             }
@@ -466,6 +469,9 @@ namespace seal
                 /* fall through */
 
             case static_cast<std::uint8_t>(scheme_type::ckks):
+                /* fall through */
+
+            case static_cast<std::uint8_t>(scheme_type::bgv):
                 return true;
             }
             return false;
@@ -6,6 +6,7 @@
 #include "seal/randomtostd.h"
 #include "seal/util/common.h"
 #include "seal/util/iterator.h"
+#include "seal/util/ntt.h"
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/rlwe.h"
 #include "seal/util/scalingvariant.h"
@@ -107,7 +108,7 @@ namespace seal
         size_t coeff_count = parms.poly_modulus_degree();
         bool is_ntt_form = false;
 
-        if (parms.scheme() == scheme_type::ckks)
+        if (parms.scheme() == scheme_type::ckks || parms.scheme() == scheme_type::bgv)
         {
             is_ntt_form = true;
         }
@@ -136,7 +137,12 @@ namespace seal
 
                 // Modulus switching
                 SEAL_ITERATE(iter(temp, destination), temp.size(), [&](auto I) {
-                    if (is_ntt_form)
+                    if (parms.scheme() == scheme_type::bgv)
+                    {
+                        rns_tool->mod_t_and_divide_q_last_ntt_inplace(
+                            get<0>(I), prev_context_data.small_ntt_tables(), pool);
+                    }
+                    else if (is_ntt_form)
                     {
                         rns_tool->divide_and_round_q_last_ntt_inplace(
                             get<0>(I), prev_context_data.small_ntt_tables(), pool);
@@ -150,6 +156,7 @@ namespace seal
 
                 destination.is_ntt_form() = is_ntt_form;
                 destination.scale() = temp.scale();
+                destination.correction_factor() = temp.correction_factor();
                 destination.parms_id() = parms_id;
             }
             else
@@ -231,6 +238,35 @@ namespace seal
 
             destination.scale() = plain.scale();
         }
+        else if (scheme == scheme_type::bgv)
+        {
+            if (plain.is_ntt_form())
+            {
+                throw invalid_argument("plain cannot be in NTT form");
+            }
+
+            encrypt_zero_internal(context_.first_parms_id(), is_asymmetric, save_seed, destination, pool);
+
+            auto &context_data = *context_.first_context_data();
+            auto &parms = context_data.parms();
+            auto &coeff_modulus = parms.coeff_modulus();
+            size_t coeff_modulus_size = coeff_modulus.size();
+            size_t coeff_count = parms.poly_modulus_degree();
+            size_t plain_coeff_count = plain.coeff_count();
+
+            // The plaintext is lifted to each coefficient modulus, transformed to NTT form, and added into the c_0
+            // term of ciphertext (c_0,c_1)
+            SEAL_ALLOCATE_GET_COEFF_ITER(temp, coeff_count, pool);
+            RNSIter destination_iter = *iter(destination);
+            SEAL_ITERATE(
+                iter(destination_iter, coeff_modulus, context_data.small_ntt_tables()), coeff_modulus_size,
+                [&](auto I) {
+                    modulo_poly_coeffs(plain.data(), plain_coeff_count, get<1>(I), temp);
+                    set_zero_uint(coeff_count - plain_coeff_count, temp + plain_coeff_count);
+                    ntt_negacyclic_harvey(temp, get<2>(I));
+                    add_poly_coeffmod(get<0>(I), temp, coeff_count, get<1>(I), get<0>(I));
+                });
+        }
         else
         {
             throw invalid_argument("unsupported scheme");
@@ -0,0 +1,328 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/evaluationgraph.h"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+using namespace std;
+
+namespace seal
+{
+    EvaluationGraph::EvaluationGraph(const SEALContext &context, MemoryPoolHandle pool)
+        : context_(context), evaluator_(context), pool_(move(pool))
+    {
+        // Verify parameters
+        if (!pool_)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::input(const Ciphertext &encrypted)
+    {
+        Node node;
+        node.input = &encrypted;
+        nodes_.push_back(move(node));
+        return nodes_.size() - 1;
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::negate(handle_type operand)
+    {
+        return record({ operand }, [](Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                      Ciphertext &destination, MemoryPoolHandle) {
+            evaluator.negate(*operands[0], destination);
+        });
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::add(handle_type operand1, handle_type operand2)
+    {
+        return record({ operand1, operand2 }, [](Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                                 Ciphertext &destination, MemoryPoolHandle) {
+            evaluator.add(*operands[0], *operands[1], destination);
+        });
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::sub(handle_type operand1, handle_type operand2)
+    {
+        return record({ operand1, operand2 }, [](Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                                 Ciphertext &destination, MemoryPoolHandle) {
+            evaluator.sub(*operands[0], *operands[1], destination);
+        });
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::multiply(handle_type operand1, handle_type operand2)
+    {
+        return record({ operand1, operand2 }, [](Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                                 Ciphertext &destination, MemoryPoolHandle pool) {
+            evaluator.multiply(*operands[0], *operands[1], destination, move(pool));
+        });
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::square(handle_type operand)
+    {
+        return record({ operand }, [](Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                      Ciphertext &destination, MemoryPoolHandle pool) {
+            evaluator.square(*operands[0], destination, move(pool));
+        });
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::relinearize(handle_type operand, const RelinKeys &relin_keys)
+    {
+        return record({ operand }, [&relin_keys](
+                                       Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                       Ciphertext &destination, MemoryPoolHandle pool) {
+            evaluator.relinearize(*operands[0], relin_keys, destination, move(pool));
+        });
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::mod_switch_to_next(handle_type operand)
+    {
+        return record({ operand }, [](Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                      Ciphertext &destination, MemoryPoolHandle pool) {
+            evaluator.mod_switch_to_next(*operands[0], destination, move(pool));
+        });
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::rescale_to_next(handle_type operand)
+    {
+        return record({ operand }, [](Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                      Ciphertext &destination, MemoryPoolHandle pool) {
+            evaluator.rescale_to_next(*operands[0], destination, move(pool));
+        });
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::rotate_rows(
+        handle_type operand, int steps, const GaloisKeys &galois_keys)
+    {
+        return record({ operand }, [steps, &galois_keys](
+                                       Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                       Ciphertext &destination, MemoryPoolHandle pool) {
+            evaluator.rotate_rows(*operands[0], steps, galois_keys, destination, move(pool));
+        });
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::rotate_columns(handle_type operand, const GaloisKeys &galois_keys)
+    {
+        return record({ operand }, [&galois_keys](
+                                       Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                       Ciphertext &destination, MemoryPoolHandle pool) {
+            evaluator.rotate_columns(*operands[0], galois_keys, destination, move(pool));
+        });
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::rotate_vector(
+        handle_type operand, int steps, const GaloisKeys &galois_keys)
+    {
+        return record({ operand }, [steps, &galois_keys](
+                                       Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                       Ciphertext &destination, MemoryPoolHandle pool) {
+            evaluator.rotate_vector(*operands[0], steps, galois_keys, destination, move(pool));
+        });
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::add_plain(handle_type operand, const Plaintext &plain)
+    {
+        return record({ operand }, [&plain](
+                                       Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                       Ciphertext &destination, MemoryPoolHandle) {
+            evaluator.add_plain(*operands[0], plain, destination);
+        });
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::multiply_plain(handle_type operand, const Plaintext &plain)
+    {
+        return record({ operand }, [&plain](
+                                       Evaluator &evaluator, const vector<const Ciphertext *> &operands,
+                                       Ciphertext &destination, MemoryPoolHandle pool) {
+            evaluator.multiply_plain(*operands[0], plain, destination, move(pool));
+        });
+    }
+
+    void EvaluationGraph::keep(handle_type handle)
+    {
+        if (handle >= nodes_.size())
+        {
+            throw invalid_argument("handle is not valid");
+        }
+        nodes_[handle].keep = true;
+    }
+
+    void EvaluationGraph::execute(size_t thread_count)
+    {
+        if (thread_count == 0)
+        {
+            throw invalid_argument("thread_count must be positive");
+        }
+
+        // Operands that appear several times in one operation are counted once per appearance
+        size_t node_count = nodes_.size();
+        vector<size_t> pending_operands(node_count);
+        vector<size_t> pending_consumers(node_count);
+        vector<handle_type> ready;
+        for (handle_type handle = node_count; handle-- > 0;)
+        {
+            auto &node = nodes_[handle];
+            node.result.release();
+            node.executed = false;
+            pending_operands[handle] = node.operands.size();
+            pending_consumers[handle] = node.consumers.size();
+            if (!pending_operands[handle])
+            {
+                ready.push_back(handle);
+            }
+        }
+
+        mutex ready_mutex;
+        condition_variable ready_cv;
+        size_t finished_count = 0;
+        exception_ptr error;
+
+        // Ready operations are taken from the back, so operations whose operands have just been computed run next and
+        // their operands can be released sooner
+        auto work = [&](MemoryPoolHandle pool) {
+            unique_lock<mutex> lock(ready_mutex);
+            while (true)
+            {
+                ready_cv.wait(lock, [&] { return !ready.empty() || finished_count == node_count || error; });
+                if (error || ready.empty())
+                {
+                    return;
+                }
+                handle_type handle = ready.back();
+                ready.pop_back();
+                lock.unlock();
+
+                auto &node = nodes_[handle];
+                try
+                {
+                    if (!node.input)
+                    {
+                        vector<const Ciphertext *> operands;
+                        for (auto operand : node.operands)
+                        {
+                            operands.push_back(&value(operand));
+                        }
+                        node.result = Ciphertext(pool_);
+                        node.operation(evaluator_, operands, node.result, pool);
+                    }
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    if (!error)
+                    {
+                        error = current_exception();
+                    }
+                    ready_cv.notify_all();
+                    return;
+                }
+
+                lock.lock();
+                node.executed = true;
+                finished_count++;
+                for (auto operand : node.operands)
+                {
+                    if (!--pending_consumers[operand] && !nodes_[operand].keep)
+                    {
+                        nodes_[operand].result.release();
+                    }
+                }
+                for (auto consumer : node.consumers)
+                {
+                    if (!--pending_operands[consumer])
+                    {
+                        ready.push_back(consumer);
+                    }
+                }
+                ready_cv.notify_all();
+            }
+        };
+
+        // Each worker allocates its temporary memory from its own memory pool, also when running on this thread
+        if (thread_count == 1)
+        {
+            work(MemoryPoolHandle::New());
+        }
+        else
+        {
+            vector<thread> workers;
+            try
+            {
+                for (size_t t = 0; t < min(thread_count, node_count); t++)
+                {
+                    workers.emplace_back(work, MemoryPoolHandle::New());
+                }
+            }
+            catch (...)
+            {
+                // The workers already started finish the graph; join them before the joinable threads are destroyed
+                for (auto &worker : workers)
+                {
+                    worker.join();
+                }
+                throw;
+            }
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        if (error)
+        {
+            rethrow_exception(error);
+        }
+    }
+
+    const Ciphertext &EvaluationGraph::result(handle_type handle) const
+    {
+        if (handle >= nodes_.size())
+        {
+            throw invalid_argument("handle is not valid");
+        }
+        auto &node = nodes_[handle];
+        if (!node.executed)
+        {
+            throw logic_error("graph has not been executed");
+        }
+        if (!node.input && !node.keep && !node.consumers.empty())
+        {
+            throw logic_error("result has been released");
+        }
+        return value(handle);
+    }
+
+    EvaluationGraph::handle_type EvaluationGraph::record(vector<handle_type> operands, operation_type operation)
+    {
+        handle_type handle = nodes_.size();
+        for (auto operand : operands)
+        {
+            if (operand >= handle)
+            {
+                throw invalid_argument("operand is not a valid handle");
+            }
+        }
+        for (auto operand : operands)
+        {
+            nodes_[operand].consumers.push_back(handle);
+        }
+
+        Node node;
+        node.operation = move(operation);
+        node.operands = move(operands);
+        nodes_.push_back(move(node));
+        return handle;
+    }
+
+    const Ciphertext &EvaluationGraph::value(handle_type handle) const
+    {
+        auto &node = nodes_[handle];
+        return node.input ? *node.input : node.result;
+    }
+} // namespace seal
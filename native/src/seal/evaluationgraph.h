@@ -0,0 +1,256 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/ciphertext.h"
+#include "seal/context.h"
+#include "seal/evaluator.h"
+#include "seal/galoiskeys.h"
+#include "seal/memorymanager.h"
+#include "seal/plaintext.h"
+#include "seal/relinkeys.h"
+#include "seal/util/defines.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace seal
+{
+    /**
+    Records a homomorphic circuit as a graph of Evaluator operations and executes it on several threads. Operations are
+    recorded on handles, each of which refers to the ciphertext produced by an operation or given as an input. Nothing
+    is computed while recording; execute runs every operation as soon as all of its operands are available, so
+    independent operations, such as the branches of a wide circuit, run concurrently.
+
+    @par Memory
+    Each worker thread allocates its temporary memory from its own memory pool. Results are allocated from the memory
+    pool given to the constructor, and the result of an operation is released as soon as the last operation consuming
+    it has finished. Results of operations that are not consumed by any other operation, and results marked with keep,
+    are retained and can be accessed with result after execution.
+
+    @par Lifetime of Arguments
+    Input ciphertexts, plaintexts, and keys are referenced rather than copied, so they must remain alive and unchanged
+    until execute returns.
+
+    @par Thread Safety
+    Recording operations and executing the graph must not be done concurrently. During execution the operations share
+    a single Evaluator, which is safe since evaluation does not modify the Evaluator.
+    */
+    class EvaluationGraph
+    {
+    public:
+        /**
+        Identifies the ciphertext produced by a recorded operation or given as an input.
+        */
+        using handle_type = std::size_t;
+
+        /**
+        Creates an empty EvaluationGraph for the specified SEALContext.
+
+        @param[in] context The SEALContext
+        @param[in] pool The MemoryPoolHandle to allocate the results from
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        EvaluationGraph(const SEALContext &context, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Adds an input ciphertext to the graph.
+
+        @param[in] encrypted The input ciphertext
+        */
+        handle_type input(const Ciphertext &encrypted);
+
+        /**
+        Records a negation.
+
+        @param[in] operand The ciphertext to negate
+        @throws std::invalid_argument if operand is not a valid handle
+        */
+        handle_type negate(handle_type operand);
+
+        /**
+        Records an addition.
+
+        @param[in] operand1 The first ciphertext to add
+        @param[in] operand2 The second ciphertext to add
+        @throws std::invalid_argument if operand1 or operand2 is not a valid handle
+        */
+        handle_type add(handle_type operand1, handle_type operand2);
+
+        /**
+        Records a subtraction.
+
+        @param[in] operand1 The ciphertext to subtract from
+        @param[in] operand2 The ciphertext to subtract
+        @throws std::invalid_argument if operand1 or operand2 is not a valid handle
+        */
+        handle_type sub(handle_type operand1, handle_type operand2);
+
+        /**
+        Records a multiplication.
+
+        @param[in] operand1 The first ciphertext to multiply
+        @param[in] operand2 The second ciphertext to multiply
+        @throws std::invalid_argument if operand1 or operand2 is not a valid handle
+        */
+        handle_type multiply(handle_type operand1, handle_type operand2);
+
+        /**
+        Records a squaring.
+
+        @param[in] operand The ciphertext to square
+        @throws std::invalid_argument if operand is not a valid handle
+        */
+        handle_type square(handle_type operand);
+
+        /**
+        Records a relinearization.
+
+        @param[in] operand The ciphertext to relinearize
+        @param[in] relin_keys The relinearization keys
+        @throws std::invalid_argument if operand is not a valid handle
+        */
+        handle_type relinearize(handle_type operand, const RelinKeys &relin_keys);
+
+        /**
+        Records a modulus switch to the next level.
+
+        @param[in] operand The ciphertext to modulus switch
+        @throws std::invalid_argument if operand is not a valid handle
+        */
+        handle_type mod_switch_to_next(handle_type operand);
+
+        /**
+        Records a CKKS rescaling to the next level.
+
+        @param[in] operand The ciphertext to rescale
+        @throws std::invalid_argument if operand is not a valid handle
+        */
+        handle_type rescale_to_next(handle_type operand);
+
+        /**
+        Records a BFV row rotation.
+
+        @param[in] operand The ciphertext to rotate
+        @param[in] steps The number of steps to rotate, as in Evaluator::rotate_rows
+        @param[in] galois_keys The Galois keys
+        @throws std::invalid_argument if operand is not a valid handle
+        */
+        handle_type rotate_rows(handle_type operand, int steps, const GaloisKeys &galois_keys);
+
+        /**
+        Records a BFV column rotation.
+
+        @param[in] operand The ciphertext to rotate
+        @param[in] galois_keys The Galois keys
+        @throws std::invalid_argument if operand is not a valid handle
+        */
+        handle_type rotate_columns(handle_type operand, const GaloisKeys &galois_keys);
+
+        /**
+        Records a CKKS vector rotation.
+
+        @param[in] operand The ciphertext to rotate
+        @param[in] steps The number of steps to rotate, as in Evaluator::rotate_vector
+        @param[in] galois_keys The Galois keys
+        @throws std::invalid_argument if operand is not a valid handle
+        */
+        handle_type rotate_vector(handle_type operand, int steps, const GaloisKeys &galois_keys);
+
+        /**
+        Records the addition of a plaintext.
+
+        @param[in] operand The ciphertext to add to
+        @param[in] plain The plaintext to add
+        @throws std::invalid_argument if operand is not a valid handle
+        */
+        handle_type add_plain(handle_type operand, const Plaintext &plain);
+
+        /**
+        Records the multiplication with a plaintext.
+
+        @param[in] operand The ciphertext to multiply
+        @param[in] plain The plaintext to multiply with
+        @throws std::invalid_argument if operand is not a valid handle
+        */
+        handle_type multiply_plain(handle_type operand, const Plaintext &plain);
+
+        /**
+        Retains the result of an operation after execution even if it is consumed by other operations.
+
+        @param[in] handle The operation whose result to retain
+        @throws std::invalid_argument if handle is not valid
+        */
+        void keep(handle_type handle);
+
+        /**
+        Executes all recorded operations using up to thread_count threads. If an operation throws, no further
+        operations are started and the exception is rethrown once the running operations have finished. Results of a
+        previous execution are discarded.
+
+        @param[in] thread_count The maximum number of threads to use
+        @throws std::invalid_argument if thread_count is zero
+        */
+        void execute(std::size_t thread_count);
+
+        /**
+        Returns the result of an operation. Only the results of operations that are not consumed by other operations,
+        or that were marked with keep, are available.
+
+        @param[in] handle The operation whose result to return
+        @throws std::invalid_argument if handle is not valid
+        @throws std::logic_error if the graph has not been executed since the operation was recorded
+        @throws std::logic_error if the result has been released
+        */
+        SEAL_NODISCARD const Ciphertext &result(handle_type handle) const;
+
+        /**
+        Returns the number of recorded operations, including inputs.
+        */
+        SEAL_NODISCARD inline std::size_t size() const noexcept
+        {
+            return nodes_.size();
+        }
+
+    private:
+        EvaluationGraph(const EvaluationGraph &copy) = delete;
+
+        EvaluationGraph &operator=(const EvaluationGraph &assign) = delete;
+
+        using operation_type = std::function<void(
+            Evaluator &evaluator, const std::vector<const Ciphertext *> &operands, Ciphertext &destination,
+            MemoryPoolHandle pool)>;
+
+        struct Node
+        {
+            // Set for input nodes only
+            const Ciphertext *input = nullptr;
+
+            operation_type operation;
+
+            std::vector<handle_type> operands;
+
+            std::vector<handle_type> consumers;
+
+            bool keep = false;
+
+            bool executed = false;
+
+            Ciphertext result;
+        };
+
+        handle_type record(std::vector<handle_type> operands, operation_type operation);
+
+        SEAL_NODISCARD const Ciphertext &value(handle_type handle) const;
+
+        SEALContext context_;
+
+        Evaluator evaluator_;
+
+        MemoryPoolHandle pool_;
+
+        std::vector<Node> nodes_;
+    };
+} // namespace seal
@@ -5,6 +5,7 @@
 #include "seal/util/common.h"
 #include "seal/util/galois.h"
 #include "seal/util/numth.h"
+#include "seal/util/parallel.h"
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/polycore.h"
 #include "seal/util/scalingvariant.h"
@@ -12,6 +13,7 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <iterator>
 
 using namespace std;
 using namespace seal::util;
@@ -33,6 +35,9 @@ namespace seal
             switch (context_data.parms().scheme())
             {
             case scheme_type::bfv:
+                /* fall through */
+
+            case scheme_type::bgv:
                 scale_bit_count_bound = context_data.parms().plain_modulus().bit_count();
                 break;
             case scheme_type::ckks:
@@ -45,6 +50,164 @@ namespace seal
 
             return !(scale <= 0 || (static_cast<int>(log2(scale)) >= scale_bit_count_bound));
         }
+
+        // Finds small integers e1 and e2 such that factor1 * e1 = factor2 * e2 mod plain_modulus, and returns
+        // factor1 * e1 mod plain_modulus together with e1 and e2. Multiplying two BGV ciphertexts by e1 and e2 gives
+        // them the same correction factor, while keeping the noise growth small.
+        SEAL_NODISCARD tuple<uint64_t, int64_t, int64_t> balance_correction_factors(
+            uint64_t factor1, uint64_t factor2, const Modulus &plain_modulus)
+        {
+            uint64_t t = plain_modulus.value();
+            uint64_t half_t = t >> 1;
+            auto to_signed = [&](uint64_t value) {
+                return value > half_t ? -static_cast<int64_t>(t - value) : static_cast<int64_t>(value);
+            };
+
+            // ratio = factor2 / factor1 mod t
+            uint64_t ratio = 1;
+            if (!try_invert_uint_mod(factor1, plain_modulus, ratio))
+            {
+                throw logic_error("invalid correction factor");
+            }
+            ratio = multiply_uint_mod(ratio, factor2, plain_modulus);
+
+            int64_t e1 = to_signed(ratio);
+            int64_t e2 = 1;
+            uint64_t sum = static_cast<uint64_t>(abs(e1)) + 1;
+
+            // The extended Euclidean algorithm on t and ratio yields pairs (a, b) with a = b * ratio mod t; the pair
+            // with the smallest sum of absolute values is used
+            int64_t prev_a = static_cast<int64_t>(t);
+            int64_t prev_b = 0;
+            int64_t a = static_cast<int64_t>(ratio);
+            int64_t b = 1;
+            while (a)
+            {
+                int64_t q = prev_a / a;
+                int64_t temp = prev_a % a;
+                prev_a = a;
+                a = temp;
+
+                temp = prev_b - b * q;
+                prev_b = b;
+                b = temp;
+
+                uint64_t new_sum = static_cast<uint64_t>(abs(a)) + static_cast<uint64_t>(abs(b));
+                if (a && new_sum < sum)
+                {
+                    sum = new_sum;
+                    e1 = a;
+                    e2 = b;
+                }
+            }
+
+            uint64_t e1_mod_t = barrett_reduce_64(static_cast<uint64_t>(abs(e1)), plain_modulus);
+            if (e1 < 0)
+            {
+                e1_mod_t = negate_uint_mod(e1_mod_t, plain_modulus);
+            }
+            return make_tuple(multiply_uint_mod(factor1, e1_mod_t, plain_modulus), e1, e2);
+        }
+
+        // Writes correction_factor times plain modulo the plain modulus, lifted to the coefficient modulus of
+        // context_data and transformed to NTT form, to destination; this is how a plaintext is added to BGV ciphertexts
+        void bgv_lift_plain_ntt(
+            const Plaintext &plain, uint64_t correction_factor, const SEALContext::ContextData &context_data,
+            RNSIter destination)
+        {
+            auto &parms = context_data.parms();
+            auto &plain_modulus = parms.plain_modulus();
+            size_t plain_coeff_count = plain.coeff_count();
+            SEAL_ITERATE(
+                iter(destination, parms.coeff_modulus(), context_data.small_ntt_tables()), parms.coeff_modulus().size(),
+                [&](auto I) {
+                    multiply_poly_scalar_coeffmod(
+                        plain.data(), plain_coeff_count, correction_factor, plain_modulus, get<0>(I));
+                    modulo_poly_coeffs(get<0>(I), plain_coeff_count, get<1>(I), get<0>(I));
+                    set_zero_uint(parms.poly_modulus_degree() - plain_coeff_count, get<0>(I) + plain_coeff_count);
+                    ntt_negacyclic_harvey(get<0>(I), get<2>(I));
+                });
+        }
+
+        // Checks that round(value) fits in 128 bits and is smaller than the coefficient modulus
+        SEAL_NODISCARD inline bool is_scaled_value_within_bounds(
+            double value, const SEALContext::ContextData &context_data) noexcept
+        {
+            if (!isfinite(value))
+            {
+                return false;
+            }
+            if (fabs(value) < 1.0)
+            {
+                return true;
+            }
+            int coeff_bit_count = static_cast<int>(log2(fabs(value))) + 2;
+            return coeff_bit_count < min(context_data.total_coeff_modulus_bit_count(), 128);
+        }
+
+        // Splits round(value) into its absolute value as a 128-bit integer and its sign
+        SEAL_NODISCARD inline bool decompose_rounded(double value, uint64_t *coeffu) noexcept
+        {
+            double two_pow_64 = pow(2.0, 64);
+            double coeffd = round(value);
+            bool is_negative = signbit(coeffd);
+            coeffd = fabs(coeffd);
+            coeffu[0] = static_cast<uint64_t>(fmod(coeffd, two_pow_64));
+            coeffu[1] = static_cast<uint64_t>(coeffd / two_pow_64);
+            return is_negative;
+        }
+
+        SEAL_NODISCARD inline uint64_t reduce_signed_uint128(
+            const uint64_t *coeffu, bool is_negative, const Modulus &modulus) noexcept
+        {
+            uint64_t result = barrett_reduce_128(coeffu, modulus);
+            return is_negative ? negate_uint_mod(result, modulus) : result;
+        }
+
+        // Returns the memory pool for temporaries that do not outlive a single operation. Temporaries that would come
+        // from the global memory pool are taken from the thread-local memory pool instead, which needs no locking and
+        // keeps the freed allocations of one operation around for the next one on the same thread.
+        SEAL_NODISCARD inline MemoryPoolHandle scratch_pool(MemoryPoolHandle pool) noexcept
+        {
+#ifndef _M_CEE
+            if (pool == MemoryPoolHandle::Global())
+            {
+                return MemoryPoolHandle::ThreadLocal();
+            }
+#endif
+            return pool;
+        }
+
+        // Applies work to every ciphertext on up to thread_count threads. Each thread allocates from its own memory
+        // pool, so the scratch memory of one ciphertext is reused for the next.
+        void for_each_parallel(
+            vector<Ciphertext> &encrypteds, size_t thread_count,
+            const function<void(Ciphertext &, MemoryPoolHandle)> &work)
+        {
+            parallel_for(
+                encrypteds.size(), thread_count, MemoryManager::GetPool(),
+                [&](size_t i, MemoryPoolHandle pool) { work(encrypteds[i], move(pool)); });
+        }
+
+        // Multiplies every RNS component of encrypted by a signed 128-bit constant
+        void multiply_signed_uint128(
+            Ciphertext &encrypted, const uint64_t *coeffu, bool is_negative,
+            const SEALContext::ContextData &context_data)
+        {
+            auto &coeff_modulus = context_data.parms().coeff_modulus();
+            size_t coeff_count = context_data.parms().poly_modulus_degree();
+            size_t encrypted_size = encrypted.size();
+            SEAL_ITERATE(iter(coeff_modulus, size_t(0)), coeff_modulus.size(), [&](auto I) {
+                // The same precomputed operand is used for every polynomial of the ciphertext
+                MultiplyUIntModOperand scalar;
+                scalar.set(reduce_signed_uint128(coeffu, is_negative, get<0>(I)), get<0>(I));
+                for (size_t i = 0; i < encrypted_size; i++)
+                {
+                    CoeffIter poly(encrypted.data(i) + get<1>(I) * coeff_count);
+                    multiply_poly_scalar_coeffmod(poly, coeff_count, scalar, get<0>(I), poly);
+                }
+            });
+        }
     } // namespace
 
     Evaluator::Evaluator(const SEALContext &context) : context_(context)
@@ -75,6 +238,38 @@ namespace seal
         }
     }
 
+    shared_ptr<const SEALContext::ContextData> Evaluator::verify_batch(
+        const vector<Ciphertext> &encrypteds, size_t thread_count) const
+    {
+        if (thread_count == 0)
+        {
+            throw invalid_argument("thread_count must be positive");
+        }
+        if (encrypteds.empty())
+        {
+            return nullptr;
+        }
+
+        // The first ciphertext is validated fully; the others only need to match it
+        auto &first = encrypteds[0];
+        if (!is_metadata_valid_for(first, context_) || !is_buffer_valid(first))
+        {
+            throw invalid_argument("encrypteds is not valid for encryption parameters");
+        }
+        for (auto &encrypted : encrypteds)
+        {
+            if (encrypted.parms_id() != first.parms_id() || encrypted.is_ntt_form() != first.is_ntt_form() ||
+                encrypted.coeff_modulus_size() != first.coeff_modulus_size() ||
+                encrypted.poly_modulus_degree() != first.poly_modulus_degree() ||
+                encrypted.size() < SEAL_CIPHERTEXT_SIZE_MIN || encrypted.size() > SEAL_CIPHERTEXT_SIZE_MAX ||
+                !are_same_scale(encrypted, first) || !is_buffer_valid(encrypted))
+            {
+                throw invalid_argument("encrypteds do not have matching parameters");
+            }
+        }
+        return context_.get_context_data(first.parms_id());
+    }
+
     void Evaluator::negate_inplace(Ciphertext &encrypted)
     {
         // Verify parameters.
@@ -130,6 +325,24 @@ namespace seal
         auto &coeff_modulus = parms.coeff_modulus();
         size_t coeff_count = parms.poly_modulus_degree();
         size_t coeff_modulus_size = coeff_modulus.size();
+
+        if (encrypted1.correction_factor() != encrypted2.correction_factor())
+        {
+            // Balance the correction factors of BGV ciphertexts before the addition
+            auto factors = balance_correction_factors(
+                encrypted1.correction_factor(), encrypted2.correction_factor(), parms.plain_modulus());
+            uint64_t e1[2]{ static_cast<uint64_t>(abs(get<1>(factors))), 0 };
+            multiply_signed_uint128(encrypted1, e1, get<1>(factors) < 0, context_data);
+            encrypted1.correction_factor() = get<0>(factors);
+
+            Ciphertext encrypted2_copy = encrypted2;
+            uint64_t e2[2]{ static_cast<uint64_t>(abs(get<2>(factors))), 0 };
+            multiply_signed_uint128(encrypted2_copy, e2, get<2>(factors) < 0, context_data);
+            encrypted2_copy.correction_factor() = get<0>(factors);
+            add_inplace(encrypted1, encrypted2_copy);
+            return;
+        }
+
         size_t encrypted1_size = encrypted1.size();
         size_t encrypted2_size = encrypted2.size();
         size_t max_count = max(encrypted1_size, encrypted2_size);
@@ -213,6 +426,24 @@ namespace seal
         auto &parms = context_data.parms();
         auto &coeff_modulus = parms.coeff_modulus();
         size_t coeff_count = parms.poly_modulus_degree();
+
+        if (encrypted1.correction_factor() != encrypted2.correction_factor())
+        {
+            // Balance the correction factors of BGV ciphertexts before the subtraction
+            auto factors = balance_correction_factors(
+                encrypted1.correction_factor(), encrypted2.correction_factor(), parms.plain_modulus());
+            uint64_t e1[2]{ static_cast<uint64_t>(abs(get<1>(factors))), 0 };
+            multiply_signed_uint128(encrypted1, e1, get<1>(factors) < 0, context_data);
+            encrypted1.correction_factor() = get<0>(factors);
+
+            Ciphertext encrypted2_copy = encrypted2;
+            uint64_t e2[2]{ static_cast<uint64_t>(abs(get<2>(factors))), 0 };
+            multiply_signed_uint128(encrypted2_copy, e2, get<2>(factors) < 0, context_data);
+            encrypted2_copy.correction_factor() = get<0>(factors);
+            sub_inplace(encrypted1, encrypted2_copy);
+            return;
+        }
+
         size_t encrypted1_size = encrypted1.size();
         size_t encrypted2_size = encrypted2.size();
         size_t max_count = max(encrypted1_size, encrypted2_size);
@@ -272,6 +503,10 @@ namespace seal
             ckks_multiply(encrypted1, encrypted2, pool);
             break;
 
+        case scheme_type::bgv:
+            bgv_multiply(encrypted1, encrypted2, pool);
+            break;
+
         default:
             throw invalid_argument("unsupported scheme");
         }
@@ -291,6 +526,8 @@ namespace seal
             throw invalid_argument("encrypted1 or encrypted2 cannot be in NTT form");
         }
 
+        pool = scratch_pool(move(pool));
+
         // Extract encryption parameters.
         auto &context_data = *context_.get_context_data(encrypted1.parms_id());
         auto &parms = context_data.parms();
@@ -388,81 +625,77 @@ namespace seal
 
         SEAL_ITERATE(iter(encrypted2, encrypted2_q, encrypted2_Bsk), encrypted2_size, behz_extend_base_convert_to_ntt);
 
-        // Allocate temporary space for the output of step (4)
-        // We allocate space separately for the base q and the base Bsk components
-        SEAL_ALLOCATE_ZERO_GET_POLY_ITER(temp_dest_q, dest_size, coeff_count, base_q_size, pool);
-        SEAL_ALLOCATE_ZERO_GET_POLY_ITER(temp_dest_Bsk, dest_size, coeff_count, base_Bsk_size, pool);
+        // BEHZ steps (4)-(8) are performed one output component at a time, so only a single component of the product
+        // in base q U Bsk is held in memory instead of all dest_size of them. The inputs were already extended to base
+        // q U Bsk above, so writing an output component to encrypted1 does not affect the remaining components even
+        // when encrypted2 refers to encrypted1.
 
-        // Perform BEHZ step (4): dyadic multiplication on arbitrary size ciphertexts
-        SEAL_ITERATE(iter(size_t(0)), dest_size, [&](auto I) {
+        // Allocate temporary space for one output component of step (4), with the base Bsk components following the
+        // base q components so that steps (6)-(8) can work on it in place
+        SEAL_ALLOCATE_GET_RNS_ITER(temp_q_Bsk, coeff_count, base_q_size + base_Bsk_size, pool);
+        RNSIter temp_dest_q = temp_q_Bsk;
+        RNSIter temp_dest_Bsk = temp_q_Bsk + base_q_size;
+
+        // Allocate temporary space for a single dyadic product and for the fast divide-and-floor result in base Bsk
+        SEAL_ALLOCATE_GET_COEFF_ITER(temp, coeff_count, pool);
+        SEAL_ALLOCATE_GET_RNS_ITER(temp_Bsk, coeff_count, base_Bsk_size, pool);
+
+        SEAL_ITERATE(iter(size_t(0), encrypted1), dest_size, [&](auto I) {
             // We iterate over relevant components of encrypted1 and encrypted2 in increasing order for
             // encrypted1 and reversed (decreasing) order for encrypted2. The bounds for the indices of
             // the relevant terms are obtained as follows.
-            size_t curr_encrypted1_last = min<size_t>(I, encrypted1_size - 1);
-            size_t curr_encrypted2_first = min<size_t>(I, encrypted2_size - 1);
-            size_t curr_encrypted1_first = I - curr_encrypted2_first;
-            // size_t curr_encrypted2_last = I - curr_encrypted1_last;
+            size_t curr_encrypted1_last = min<size_t>(get<0>(I), encrypted1_size - 1);
+            size_t curr_encrypted2_first = min<size_t>(get<0>(I), encrypted2_size - 1);
+            size_t curr_encrypted1_first = get<0>(I) - curr_encrypted2_first;
+            // size_t curr_encrypted2_last = get<0>(I) - curr_encrypted1_last;
 
             // The total number of dyadic products is now easy to compute
             size_t steps = curr_encrypted1_last - curr_encrypted1_first + 1;
 
-            // This lambda function computes the ciphertext product for BFV multiplication. Since we use the BEHZ
-            // approach, the multiplication of individual polynomials is done using a dyadic product where the inputs
-            // are already in NTT form. The arguments of the lambda function are expected to be as follows:
+            // This lambda function computes one component of the ciphertext product for BFV multiplication. Since we
+            // use the BEHZ approach, the multiplication of individual polynomials is done using a dyadic product where
+            // the inputs are already in NTT form. The arguments of the lambda function are expected to be as follows:
             //
             // 1. a ConstPolyIter pointing to the beginning of the first input ciphertext (in NTT form)
             // 2. a ConstPolyIter pointing to the beginning of the second input ciphertext (in NTT form)
             // 3. a ConstModulusIter pointing to an array of Modulus elements for the base
             // 4. the size of the base
-            // 5. a PolyIter pointing to the beginning of the output ciphertext
+            // 5. an RNSIter pointing to the output component
             auto behz_ciphertext_product = [&](ConstPolyIter in1_iter, ConstPolyIter in2_iter,
-                                               ConstModulusIter base_iter, size_t base_size, PolyIter out_iter) {
+                                               ConstModulusIter base_iter, size_t base_size, RNSIter out_iter) {
                 // Create a shifted iterator for the first input
                 auto shifted_in1_iter = in1_iter + curr_encrypted1_first;
 
                 // Create a shifted reverse iterator for the second input
                 auto shifted_reversed_in2_iter = reverse_iter(in2_iter + curr_encrypted2_first);
 
-                // Create a shifted iterator for the output
-                auto shifted_out_iter = out_iter[I];
-
                 SEAL_ITERATE(iter(shifted_in1_iter, shifted_reversed_in2_iter), steps, [&](auto J) {
-                    SEAL_ITERATE(iter(J, base_iter, shifted_out_iter), base_size, [&](auto K) {
-                        SEAL_ALLOCATE_GET_COEFF_ITER(temp, coeff_count, pool);
+                    SEAL_ITERATE(iter(J, base_iter, out_iter), base_size, [&](auto K) {
                         dyadic_product_coeffmod(get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), temp);
                         add_poly_coeffmod(temp, get<2>(K), coeff_count, get<1>(K), get<2>(K));
                     });
                 });
             };
 
-            // Perform the BEHZ ciphertext product both for base q and base Bsk
+            // Perform BEHZ step (4): dyadic multiplication both for base q and base Bsk
+            set_zero_poly(coeff_count, base_q_size + base_Bsk_size, temp_q_Bsk);
             behz_ciphertext_product(encrypted1_q, encrypted2_q, base_q, base_q_size, temp_dest_q);
             behz_ciphertext_product(encrypted1_Bsk, encrypted2_Bsk, base_Bsk, base_Bsk_size, temp_dest_Bsk);
-        });
-
-        // Perform BEHZ step (5): transform data from NTT form
-        // Lazy reduction here. The following multiply_poly_scalar_coeffmod will correct the value back to [0, p)
-        inverse_ntt_negacyclic_harvey_lazy(temp_dest_q, dest_size, base_q_ntt_tables);
-        inverse_ntt_negacyclic_harvey_lazy(temp_dest_Bsk, dest_size, base_Bsk_ntt_tables);
 
-        // Perform BEHZ steps (6)-(8)
-        SEAL_ITERATE(iter(temp_dest_q, temp_dest_Bsk, encrypted1), dest_size, [&](auto I) {
-            // Bring together the base q and base Bsk components into a single allocation
-            SEAL_ALLOCATE_GET_RNS_ITER(temp_q_Bsk, coeff_count, base_q_size + base_Bsk_size, pool);
+            // Perform BEHZ step (5): transform data from NTT form
+            // Lazy reduction here. The following multiply_poly_scalar_coeffmod will correct the value back to [0, p)
+            inverse_ntt_negacyclic_harvey_lazy(temp_dest_q, base_q_size, base_q_ntt_tables);
+            inverse_ntt_negacyclic_harvey_lazy(temp_dest_Bsk, base_Bsk_size, base_Bsk_ntt_tables);
 
             // Step (6): multiply base q components by t (plain_modulus)
-            multiply_poly_scalar_coeffmod(get<0>(I), base_q_size, plain_modulus, base_q, temp_q_Bsk);
-
-            multiply_poly_scalar_coeffmod(get<1>(I), base_Bsk_size, plain_modulus, base_Bsk, temp_q_Bsk + base_q_size);
-
-            // Allocate yet another temporary for fast divide-and-floor result in base Bsk
-            SEAL_ALLOCATE_GET_RNS_ITER(temp_Bsk, coeff_count, base_Bsk_size, pool);
+            multiply_poly_scalar_coeffmod(temp_dest_q, base_q_size, plain_modulus, base_q, temp_dest_q);
+            multiply_poly_scalar_coeffmod(temp_dest_Bsk, base_Bsk_size, plain_modulus, base_Bsk, temp_dest_Bsk);
 
             // Step (7): divide by q and floor, producing a result in base Bsk
             rns_tool->fast_floor(temp_q_Bsk, temp_Bsk, pool);
 
             // Step (8): use Shenoy-Kumaresan method to convert the result to base q and write to encrypted1
-            rns_tool->fastbconv_sk(temp_Bsk, get<2>(I), pool);
+            rns_tool->fastbconv_sk(temp_Bsk, get<1>(I), pool);
         });
 
         // Set the scale
@@ -476,6 +709,8 @@ namespace seal
             throw invalid_argument("encrypted1 or encrypted2 must be in NTT form");
         }
 
+        pool = scratch_pool(move(pool));
+
         // Extract encryption parameters.
         auto &context_data = *context_.get_context_data(encrypted1.parms_id());
         auto &parms = context_data.parms();
@@ -549,6 +784,23 @@ namespace seal
         encrypted1.scale() = new_scale;
     }
 
+    void Evaluator::bgv_multiply(Ciphertext &encrypted1, const Ciphertext &encrypted2, MemoryPoolHandle pool)
+    {
+        if (!(encrypted1.is_ntt_form() && encrypted2.is_ntt_form()))
+        {
+            throw invalid_argument("encrypted1 or encrypted2 must be in NTT form");
+        }
+
+        // The correction factors multiply
+        auto &plain_modulus = context_.get_context_data(encrypted1.parms_id())->parms().plain_modulus();
+        uint64_t new_correction_factor =
+            multiply_uint_mod(encrypted1.correction_factor(), encrypted2.correction_factor(), plain_modulus);
+
+        // The tensor product is computed with dyadic products in NTT form, exactly as in CKKS
+        ckks_multiply(encrypted1, encrypted2, move(pool));
+        encrypted1.correction_factor() = new_correction_factor;
+    }
+
     void Evaluator::square_inplace(Ciphertext &encrypted, MemoryPoolHandle pool)
     {
         // Verify parameters.
@@ -568,6 +820,10 @@ namespace seal
             ckks_square(encrypted, move(pool));
             break;
 
+        case scheme_type::bgv:
+            bgv_square(encrypted, move(pool));
+            break;
+
         default:
             throw invalid_argument("unsupported scheme");
         }
@@ -587,6 +843,8 @@ namespace seal
             throw invalid_argument("encrypted cannot be in NTT form");
         }
 
+        pool = scratch_pool(move(pool));
+
         // Extract encryption parameters.
         auto &context_data = *context_.get_context_data(encrypted.parms_id());
         auto &parms = context_data.parms();
@@ -673,60 +931,62 @@ namespace seal
         // Perform BEHZ steps (1)-(3)
         SEAL_ITERATE(iter(encrypted, encrypted_q, encrypted_Bsk), encrypted_size, behz_extend_base_convert_to_ntt);
 
-        // Allocate temporary space for the output of step (4)
-        // We allocate space separately for the base q and the base Bsk components
-        SEAL_ALLOCATE_ZERO_GET_POLY_ITER(temp_dest_q, dest_size, coeff_count, base_q_size, pool);
-        SEAL_ALLOCATE_ZERO_GET_POLY_ITER(temp_dest_Bsk, dest_size, coeff_count, base_Bsk_size, pool);
-
-        // Perform BEHZ step (4): dyadic Karatsuba-squaring on size-2 ciphertexts
+        // As in Evaluator::bfv_multiply, BEHZ steps (4)-(8) are performed one output component at a time
+        SEAL_ALLOCATE_GET_RNS_ITER(temp_q_Bsk, coeff_count, base_q_size + base_Bsk_size, pool);
+        RNSIter temp_dest_q = temp_q_Bsk;
+        RNSIter temp_dest_Bsk = temp_q_Bsk + base_q_size;
+        SEAL_ALLOCATE_GET_RNS_ITER(temp_Bsk, coeff_count, base_Bsk_size, pool);
 
-        // This lambda function computes the size-2 ciphertext square for BFV multiplication. Since we use the BEHZ
-        // approach, the multiplication of individual polynomials is done using a dyadic product where the inputs
-        // are already in NTT form. The arguments of the lambda function are expected to be as follows:
+        // This lambda function computes one component of the size-2 ciphertext square for BFV multiplication using
+        // Karatsuba-squaring. Since we use the BEHZ approach, the multiplication of individual polynomials is done
+        // using a dyadic product where the inputs are already in NTT form. The arguments of the lambda function are
+        // expected to be as follows:
         //
-        // 1. a ConstPolyIter pointing to the beginning of the input ciphertext (in NTT form)
+        // 1. the index of the output component
+        // 2. a ConstPolyIter pointing to the beginning of the input ciphertext (in NTT form)
         // 3. a ConstModulusIter pointing to an array of Modulus elements for the base
         // 4. the size of the base
-        // 5. a PolyIter pointing to the beginning of the output ciphertext
-        auto behz_ciphertext_square = [&](ConstPolyIter in_iter, ConstModulusIter base_iter, size_t base_size,
-                                          PolyIter out_iter) {
-            // Compute c0^2
-            dyadic_product_coeffmod(in_iter[0], in_iter[0], base_size, base_iter, out_iter[0]);
-
-            // Compute 2*c0*c1
-            dyadic_product_coeffmod(in_iter[0], in_iter[1], base_size, base_iter, out_iter[1]);
-            add_poly_coeffmod(out_iter[1], out_iter[1], base_size, base_iter, out_iter[1]);
-
-            // Compute c1^2
-            dyadic_product_coeffmod(in_iter[1], in_iter[1], base_size, base_iter, out_iter[2]);
-        };
-
-        // Perform the BEHZ ciphertext square both for base q and base Bsk
-        behz_ciphertext_square(encrypted_q, base_q, base_q_size, temp_dest_q);
-        behz_ciphertext_square(encrypted_Bsk, base_Bsk, base_Bsk_size, temp_dest_Bsk);
+        // 5. an RNSIter pointing to the output component
+        auto behz_ciphertext_square = [&](size_t index, ConstPolyIter in_iter, ConstModulusIter base_iter,
+                                          size_t base_size, RNSIter out_iter) {
+            switch (index)
+            {
+            case 0:
+                // Compute c0^2
+                dyadic_product_coeffmod(in_iter[0], in_iter[0], base_size, base_iter, out_iter);
+                break;
 
-        // Perform BEHZ step (5): transform data from NTT form
-        inverse_ntt_negacyclic_harvey(temp_dest_q, dest_size, base_q_ntt_tables);
-        inverse_ntt_negacyclic_harvey(temp_dest_Bsk, dest_size, base_Bsk_ntt_tables);
+            case 1:
+                // Compute 2*c0*c1
+                dyadic_product_coeffmod(in_iter[0], in_iter[1], base_size, base_iter, out_iter);
+                add_poly_coeffmod(out_iter, out_iter, base_size, base_iter, out_iter);
+                break;
 
-        // Perform BEHZ steps (6)-(8)
-        SEAL_ITERATE(iter(temp_dest_q, temp_dest_Bsk, encrypted), dest_size, [&](auto I) {
-            // Bring together the base q and base Bsk components into a single allocation
-            SEAL_ALLOCATE_GET_RNS_ITER(temp_q_Bsk, coeff_count, base_q_size + base_Bsk_size, pool);
+            default:
+                // Compute c1^2
+                dyadic_product_coeffmod(in_iter[1], in_iter[1], base_size, base_iter, out_iter);
+                break;
+            }
+        };
 
-            // Step (6): multiply base q components by t (plain_modulus)
-            multiply_poly_scalar_coeffmod(get<0>(I), base_q_size, plain_modulus, base_q, temp_q_Bsk);
+        SEAL_ITERATE(iter(size_t(0), encrypted), dest_size, [&](auto I) {
+            // Perform BEHZ step (4): dyadic Karatsuba-squaring both for base q and base Bsk
+            behz_ciphertext_square(get<0>(I), encrypted_q, base_q, base_q_size, temp_dest_q);
+            behz_ciphertext_square(get<0>(I), encrypted_Bsk, base_Bsk, base_Bsk_size, temp_dest_Bsk);
 
-            multiply_poly_scalar_coeffmod(get<1>(I), base_Bsk_size, plain_modulus, base_Bsk, temp_q_Bsk + base_q_size);
+            // Perform BEHZ step (5): transform data from NTT form
+            inverse_ntt_negacyclic_harvey(temp_dest_q, base_q_size, base_q_ntt_tables);
+            inverse_ntt_negacyclic_harvey(temp_dest_Bsk, base_Bsk_size, base_Bsk_ntt_tables);
 
-            // Allocate yet another temporary for fast divide-and-floor result in base Bsk
-            SEAL_ALLOCATE_GET_RNS_ITER(temp_Bsk, coeff_count, base_Bsk_size, pool);
+            // Step (6): multiply base q components by t (plain_modulus)
+            multiply_poly_scalar_coeffmod(temp_dest_q, base_q_size, plain_modulus, base_q, temp_dest_q);
+            multiply_poly_scalar_coeffmod(temp_dest_Bsk, base_Bsk_size, plain_modulus, base_Bsk, temp_dest_Bsk);
 
             // Step (7): divide by q and floor, producing a result in base Bsk
             rns_tool->fast_floor(temp_q_Bsk, temp_Bsk, pool);
 
-            // Step (8): use Shenoy-Kumaresan method to convert the result to base q and write to encrypted1
-            rns_tool->fastbconv_sk(temp_Bsk, get<2>(I), pool);
+            // Step (8): use Shenoy-Kumaresan method to convert the result to base q and write to encrypted
+            rns_tool->fastbconv_sk(temp_Bsk, get<1>(I), pool);
         });
 
         // Set the scale
@@ -740,6 +1000,8 @@ namespace seal
             throw invalid_argument("encrypted must be in NTT form");
         }
 
+        pool = scratch_pool(move(pool));
+
         // Extract encryption parameters.
         auto &context_data = *context_.get_context_data(encrypted.parms_id());
         auto &parms = context_data.parms();
@@ -799,6 +1061,21 @@ namespace seal
         encrypted.scale() = new_scale;
     }
 
+    void Evaluator::bgv_square(Ciphertext &encrypted, MemoryPoolHandle pool)
+    {
+        if (!encrypted.is_ntt_form())
+        {
+            throw invalid_argument("encrypted must be in NTT form");
+        }
+
+        auto &plain_modulus = context_.get_context_data(encrypted.parms_id())->parms().plain_modulus();
+        uint64_t new_correction_factor =
+            multiply_uint_mod(encrypted.correction_factor(), encrypted.correction_factor(), plain_modulus);
+
+        ckks_square(encrypted, move(pool));
+        encrypted.correction_factor() = new_correction_factor;
+    }
+
     void Evaluator::relinearize_internal(
         Ciphertext &encrypted, const RelinKeys &relin_keys, size_t destination_size, MemoryPoolHandle pool)
     {
@@ -808,6 +1085,10 @@ namespace seal
         {
             throw invalid_argument("encrypted is not valid for encryption parameters");
         }
+        if (context_data_ptr->parms().scheme() == scheme_type::bfv && encrypted.is_ntt_form())
+        {
+            throw invalid_argument("BFV encrypted cannot be in NTT form");
+        }
         if (relin_keys.parms_id() != context_.key_parms_id())
         {
             throw invalid_argument("relin_keys is not valid for encryption parameters");
@@ -869,11 +1150,17 @@ namespace seal
         {
             throw invalid_argument("CKKS encrypted must be in NTT form");
         }
+        if (context_data_ptr->parms().scheme() == scheme_type::bgv && !encrypted.is_ntt_form())
+        {
+            throw invalid_argument("BGV encrypted must be in NTT form");
+        }
         if (!pool)
         {
             throw invalid_argument("pool is uninitialized");
         }
 
+        pool = scratch_pool(move(pool));
+
         // Extract encryption parameters.
         auto &context_data = *context_data_ptr;
         auto &next_context_data = *context_data.next_context_data();
@@ -901,6 +1188,12 @@ namespace seal
             });
             break;
 
+        case scheme_type::bgv:
+            SEAL_ITERATE(iter(encrypted_copy), encrypted_size, [&](auto I) {
+                rns_tool->mod_t_and_divide_q_last_ntt_inplace(I, context_data.small_ntt_tables(), pool);
+            });
+            break;
+
         default:
             throw invalid_argument("unsupported scheme");
         }
@@ -919,6 +1212,12 @@ namespace seal
             destination.scale() =
                 encrypted.scale() / static_cast<double>(context_data.parms().coeff_modulus().back().value());
         }
+        else if (next_parms.scheme() == scheme_type::bgv)
+        {
+            // Change the correction factor when using BGV
+            destination.correction_factor() = multiply_uint_mod(
+                encrypted.correction_factor(), rns_tool->inv_q_last_mod_t(), next_parms.plain_modulus());
+        }
     }
 
     void Evaluator::mod_switch_drop_to_next(const Ciphertext &encrypted, Ciphertext &destination, MemoryPoolHandle pool)
@@ -1041,6 +1340,9 @@ namespace seal
         switch (context_.first_context_data()->parms().scheme())
         {
         case scheme_type::bfv:
+            /* fall through */
+
+        case scheme_type::bgv:
             // Modulus switching with scaling
             mod_switch_scale_to_next(encrypted, destination, move(pool));
             break;
@@ -1133,6 +1435,9 @@ namespace seal
         switch (context_.first_context_data()->parms().scheme())
         {
         case scheme_type::bfv:
+            /* fall through */
+
+        case scheme_type::bgv:
             throw invalid_argument("unsupported operation for scheme type");
 
         case scheme_type::ckks:
@@ -1182,6 +1487,9 @@ namespace seal
         switch (context_data_ptr->parms().scheme())
         {
         case scheme_type::bfv:
+            /* fall through */
+
+        case scheme_type::bgv:
             throw invalid_argument("unsupported operation for scheme type");
 
         case scheme_type::ckks:
@@ -1236,7 +1544,7 @@ namespace seal
         auto &context_data = *context_data_ptr;
         auto &parms = context_data.parms();
 
-        if (parms.scheme() != scheme_type::bfv)
+        if (parms.scheme() != scheme_type::bfv && parms.scheme() != scheme_type::bgv)
         {
             throw logic_error("unsupported scheme");
         }
@@ -1281,6 +1589,99 @@ namespace seal
         destination = product_vec.back();
     }
 
+    void Evaluator::multiply_many_parallel(
+        const vector<Ciphertext> &encrypteds, const RelinKeys &relin_keys, Ciphertext &destination,
+        size_t thread_count)
+    {
+        // Verify parameters.
+        if (encrypteds.size() == 0)
+        {
+            throw invalid_argument("encrypteds vector must not be empty");
+        }
+        if (thread_count == 0)
+        {
+            throw invalid_argument("thread_count must be positive");
+        }
+        for (size_t i = 0; i < encrypteds.size(); i++)
+        {
+            if (&encrypteds[i] == &destination)
+            {
+                throw invalid_argument("encrypteds must be different from destination");
+            }
+        }
+
+        // There is at least one ciphertext
+        auto context_data_ptr = context_.get_context_data(encrypteds[0].parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypteds is not valid for encryption parameters");
+        }
+        if (context_data_ptr->parms().scheme() != scheme_type::bfv &&
+            context_data_ptr->parms().scheme() != scheme_type::bgv)
+        {
+            throw logic_error("unsupported scheme");
+        }
+
+        // If there is only one ciphertext, return it.
+        if (encrypteds.size() == 1)
+        {
+            destination = encrypteds[0];
+            return;
+        }
+
+        // Each worker allocates from its own memory pool to avoid contention on a shared one
+        size_t count = encrypteds.size();
+        thread_count = min(thread_count, count / 2);
+        vector<MemoryPoolHandle> pools;
+        generate_n(back_inserter(pools), thread_count, [] { return MemoryPoolHandle::New(); });
+
+        // The two level buffers alternate between levels so their allocations are reused. Worker t always writes the
+        // products with index t modulo thread_count, so buffers are only ever resized from that worker's pool.
+        size_t buffer_size = (count + 1) / 2;
+        vector<Ciphertext> current;
+        vector<Ciphertext> next;
+        for (size_t i = 0; i < buffer_size; i++)
+        {
+            current.emplace_back(pools[i % thread_count]);
+            next.emplace_back(pools[i % thread_count]);
+        }
+
+        // The multiplications within a level of the product tree are independent
+        auto multiply_level = [&](const vector<Ciphertext> &operands, size_t operand_count) {
+            size_t product_count = operand_count / 2;
+            run_workers(min(thread_count, product_count), [&](size_t t) {
+                for (size_t j = t; j < product_count; j += thread_count)
+                {
+                    multiply(operands[2 * j], operands[2 * j + 1], next[j], pools[t]);
+                    relinearize_inplace(next[j], relin_keys, pools[t]);
+                }
+            });
+        };
+
+        // First level reads the inputs directly; an odd one out is carried to the next level
+        multiply_level(encrypteds, count);
+        if (count & 1)
+        {
+            next[count / 2] = encrypteds.back();
+        }
+        count = (count + 1) / 2;
+        swap(current, next);
+
+        while (count > 1)
+        {
+            multiply_level(current, count);
+            if (count & 1)
+            {
+                // Copy rather than swap so that each buffer keeps its worker's pool
+                next[count / 2] = current[count - 1];
+            }
+            count = (count + 1) / 2;
+            swap(current, next);
+        }
+
+        destination = current[0];
+    }
+
     void Evaluator::exponentiate_inplace(
         Ciphertext &encrypted, uint64_t exponent, const RelinKeys &relin_keys, MemoryPoolHandle pool)
     {
@@ -1308,10 +1709,76 @@ namespace seal
         {
             return;
         }
+        if (context_data_ptr->parms().scheme() != scheme_type::bfv &&
+            context_data_ptr->parms().scheme() != scheme_type::bgv)
+        {
+            throw logic_error("unsupported scheme");
+        }
+
+        // Right-to-left binary exponentiation; keep in sync with ExponentiationChain. The powers encrypted^(2^i) are
+        // obtained by repeated squaring and those selected by the bits of exponent are multiplied into the result in
+        // increasing order of depth. This gives the same multiplicative depth ceil(log2(exponent)) as a balanced
+        // product tree but needs only one temporary ciphertext.
+        auto square_relin = [&](Ciphertext &operand) {
+            square_inplace(operand, pool);
+            relinearize_inplace(operand, relin_keys, pool);
+        };
+
+        // The lowest selected power becomes the initial result
+        while (!(exponent & 1))
+        {
+            square_relin(encrypted);
+            exponent >>= 1;
+        }
+        exponent >>= 1;
+        if (!exponent)
+        {
+            return;
+        }
+
+        Ciphertext power(encrypted, pool);
+        while (exponent)
+        {
+            square_relin(power);
+            if (exponent & 1)
+            {
+                multiply_inplace(encrypted, power, pool);
+                relinearize_inplace(encrypted, relin_keys, pool);
+            }
+            exponent >>= 1;
+        }
+    }
+
+    vector<uint64_t> Evaluator::ExponentiationChain(uint64_t exponent)
+    {
+        if (exponent == 0)
+        {
+            throw invalid_argument("exponent cannot be 0");
+        }
 
-        // Create a vector of copies of encrypted
-        vector<Ciphertext> exp_vector(static_cast<size_t>(exponent), encrypted);
-        multiply_many(exp_vector, relin_keys, encrypted, move(pool));
+        vector<uint64_t> chain{ 1 };
+        uint64_t power = 1;
+        while (!(exponent & 1))
+        {
+            power <<= 1;
+            chain.push_back(power);
+            exponent >>= 1;
+        }
+        uint64_t result = power;
+        exponent >>= 1;
+
+        while (exponent)
+        {
+            power <<= 1;
+            chain.push_back(power);
+            if (exponent & 1)
+            {
+                result += power;
+                chain.push_back(result);
+            }
+            exponent >>= 1;
+        }
+        return chain;
     }
 
     void Evaluator::add_plain_inplace(Ciphertext &encrypted, const Plaintext &plain)
@@ -1328,19 +1795,27 @@ namespace seal
 
         auto &context_data = *context_.get_context_data(encrypted.parms_id());
         auto &parms = context_data.parms();
-        if (parms.scheme() == scheme_type::bfv && encrypted.is_ntt_form())
+        if (parms.scheme() == scheme_type::bfv && plain.is_ntt_form())
         {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
+            throw invalid_argument("BFV plain cannot be in NTT form");
         }
         if (parms.scheme() == scheme_type::ckks && !encrypted.is_ntt_form())
         {
             throw invalid_argument("CKKS encrypted must be in NTT form");
         }
-        if (plain.is_ntt_form() != encrypted.is_ntt_form())
+        if (parms.scheme() == scheme_type::ckks && plain.is_ntt_form() != encrypted.is_ntt_form())
         {
             throw invalid_argument("NTT form mismatch");
         }
-        if (encrypted.is_ntt_form() && (encrypted.parms_id() != plain.parms_id()))
+        if (parms.scheme() == scheme_type::bgv && plain.is_ntt_form())
+        {
+            throw invalid_argument("BGV plain cannot be in NTT form");
+        }
+        if (parms.scheme() == scheme_type::bgv && !encrypted.is_ntt_form())
+        {
+            throw invalid_argument("BGV encrypted must be in NTT form");
+        }
+        if (plain.is_ntt_form() && (encrypted.parms_id() != plain.parms_id()))
         {
             throw invalid_argument("encrypted and plain parameter mismatch");
         }
@@ -1364,7 +1839,21 @@ namespace seal
         {
         case scheme_type::bfv:
         {
-            multiply_add_plain_with_scaling_variant(plain, context_data, *iter(encrypted));
+            if (encrypted.is_ntt_form())
+            {
+                // Scale the plaintext in coefficient form and only transform the result
+                auto pool = MemoryManager::GetPool();
+                SEAL_ALLOCATE_ZERO_GET_RNS_ITER(temp, coeff_count, coeff_modulus_size, pool);
+                multiply_add_plain_with_scaling_variant(plain, context_data, temp);
+                ntt_negacyclic_harvey(temp, coeff_modulus_size, iter(context_data.small_ntt_tables()));
+
+                RNSIter encrypted_iter(encrypted.data(), coeff_count);
+                add_poly_coeffmod(encrypted_iter, temp, coeff_modulus_size, coeff_modulus, encrypted_iter);
+            }
+            else
+            {
+                multiply_add_plain_with_scaling_variant(plain, context_data, *iter(encrypted));
+            }
             break;
         }
 
@@ -1376,6 +1865,18 @@ namespace seal
             break;
         }
 
+        case scheme_type::bgv:
+        {
+            // The plaintext is multiplied by the correction factor of the ciphertext
+            auto pool = MemoryManager::GetPool();
+            SEAL_ALLOCATE_ZERO_GET_RNS_ITER(temp, coeff_count, coeff_modulus_size, pool);
+            bgv_lift_plain_ntt(plain, encrypted.correction_factor(), context_data, temp);
+
+            RNSIter encrypted_iter(encrypted.data(), coeff_count);
+            add_poly_coeffmod(encrypted_iter, temp, coeff_modulus_size, coeff_modulus, encrypted_iter);
+            break;
+        }
+
         default:
             throw invalid_argument("unsupported scheme");
         }
@@ -1402,19 +1903,27 @@ namespace seal
 
         auto &context_data = *context_.get_context_data(encrypted.parms_id());
         auto &parms = context_data.parms();
-        if (parms.scheme() == scheme_type::bfv && encrypted.is_ntt_form())
+        if (parms.scheme() == scheme_type::bfv && plain.is_ntt_form())
         {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
+            throw invalid_argument("BFV plain cannot be in NTT form");
         }
         if (parms.scheme() == scheme_type::ckks && !encrypted.is_ntt_form())
         {
             throw invalid_argument("CKKS encrypted must be in NTT form");
         }
-        if (plain.is_ntt_form() != encrypted.is_ntt_form())
+        if (parms.scheme() == scheme_type::ckks && plain.is_ntt_form() != encrypted.is_ntt_form())
         {
             throw invalid_argument("NTT form mismatch");
         }
-        if (encrypted.is_ntt_form() && (encrypted.parms_id() != plain.parms_id()))
+        if (parms.scheme() == scheme_type::bgv && plain.is_ntt_form())
+        {
+            throw invalid_argument("BGV plain cannot be in NTT form");
+        }
+        if (parms.scheme() == scheme_type::bgv && !encrypted.is_ntt_form())
+        {
+            throw invalid_argument("BGV encrypted must be in NTT form");
+        }
+        if (plain.is_ntt_form() && (encrypted.parms_id() != plain.parms_id()))
         {
             throw invalid_argument("encrypted and plain parameter mismatch");
         }
@@ -1438,7 +1947,21 @@ namespace seal
         {
         case scheme_type::bfv:
         {
-            multiply_sub_plain_with_scaling_variant(plain, context_data, *iter(encrypted));
+            if (encrypted.is_ntt_form())
+            {
+                // Scale the plaintext in coefficient form and only transform the result
+                auto pool = MemoryManager::GetPool();
+                SEAL_ALLOCATE_ZERO_GET_RNS_ITER(temp, coeff_count, coeff_modulus_size, pool);
+                multiply_add_plain_with_scaling_variant(plain, context_data, temp);
+                ntt_negacyclic_harvey(temp, coeff_modulus_size, iter(context_data.small_ntt_tables()));
+
+                RNSIter encrypted_iter(encrypted.data(), coeff_count);
+                sub_poly_coeffmod(encrypted_iter, temp, coeff_modulus_size, coeff_modulus, encrypted_iter);
+            }
+            else
+            {
+                multiply_sub_plain_with_scaling_variant(plain, context_data, *iter(encrypted));
+            }
             break;
         }
 
@@ -1450,6 +1973,18 @@ namespace seal
             break;
         }
 
+        case scheme_type::bgv:
+        {
+            // The plaintext is multiplied by the correction factor of the ciphertext
+            auto pool = MemoryManager::GetPool();
+            SEAL_ALLOCATE_ZERO_GET_RNS_ITER(temp, coeff_count, coeff_modulus_size, pool);
+            bgv_lift_plain_ntt(plain, encrypted.correction_factor(), context_data, temp);
+
+            RNSIter encrypted_iter(encrypted.data(), coeff_count);
+            sub_poly_coeffmod(encrypted_iter, temp, coeff_modulus_size, coeff_modulus, encrypted_iter);
+            break;
+        }
+
         default:
             throw invalid_argument("unsupported scheme");
         }
@@ -1462,7 +1997,116 @@ namespace seal
 #endif
     }
 
-    void Evaluator::multiply_plain_inplace(Ciphertext &encrypted, const Plaintext &plain, MemoryPoolHandle pool)
+    void Evaluator::add_plain_batch_internal(
+        vector<Ciphertext> &encrypteds, const Plaintext &plain, bool subtract, size_t thread_count)
+    {
+        // Verify parameters.
+        auto context_data_ptr = verify_batch(encrypteds, thread_count);
+        if (!is_metadata_valid_for(plain, context_) || !is_buffer_valid(plain))
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+        if (!context_data_ptr)
+        {
+            return;
+        }
+
+        auto &first = encrypteds[0];
+        auto &context_data = *context_data_ptr;
+        auto &parms = context_data.parms();
+        if (parms.scheme() == scheme_type::bfv && plain.is_ntt_form())
+        {
+            throw invalid_argument("BFV plain cannot be in NTT form");
+        }
+        if (parms.scheme() == scheme_type::ckks && !first.is_ntt_form())
+        {
+            throw invalid_argument("CKKS encrypted must be in NTT form");
+        }
+        if (parms.scheme() == scheme_type::ckks && plain.is_ntt_form() != first.is_ntt_form())
+        {
+            throw invalid_argument("NTT form mismatch");
+        }
+        if (parms.scheme() == scheme_type::bgv && plain.is_ntt_form())
+        {
+            throw invalid_argument("BGV plain cannot be in NTT form");
+        }
+        if (parms.scheme() == scheme_type::bgv && !first.is_ntt_form())
+        {
+            throw invalid_argument("BGV encrypted must be in NTT form");
+        }
+        if (plain.is_ntt_form() && (first.parms_id() != plain.parms_id()))
+        {
+            throw invalid_argument("encrypted and plain parameter mismatch");
+        }
+        if (!are_same_scale(first, plain))
+        {
+            throw invalid_argument("scale mismatch");
+        }
+
+        // Extract encryption parameters.
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_modulus_size = coeff_modulus.size();
+
+        // Size check
+        if (!product_fits_in(coeff_count, coeff_modulus_size))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // Bring the plaintext to the form in which it is added to every ciphertext
+        auto pool = MemoryManager::GetPool();
+        SEAL_ALLOCATE_ZERO_GET_RNS_ITER(operand, coeff_count, coeff_modulus_size, pool);
+        switch (parms.scheme())
+        {
+        case scheme_type::bfv:
+            multiply_add_plain_with_scaling_variant(plain, context_data, operand);
+            if (first.is_ntt_form())
+            {
+                ntt_negacyclic_harvey(operand, coeff_modulus_size, iter(context_data.small_ntt_tables()));
+            }
+            break;
+
+        case scheme_type::ckks:
+            set_poly(plain.data(), coeff_count, coeff_modulus_size, operand);
+            break;
+
+        case scheme_type::bgv:
+            for (auto &encrypted : encrypteds)
+            {
+                if (encrypted.correction_factor() != first.correction_factor())
+                {
+                    throw invalid_argument("correction factor mismatch");
+                }
+            }
+            bgv_lift_plain_ntt(plain, first.correction_factor(), context_data, operand);
+            break;
+
+        default:
+            throw invalid_argument("unsupported scheme");
+        }
+
+        for_each_parallel(encrypteds, thread_count, [&](Ciphertext &encrypted, MemoryPoolHandle) {
+            RNSIter encrypted_iter(encrypted.data(), coeff_count);
+            if (subtract)
+            {
+                sub_poly_coeffmod(encrypted_iter, operand, coeff_modulus_size, coeff_modulus, encrypted_iter);
+            }
+            else
+            {
+                add_poly_coeffmod(encrypted_iter, operand, coeff_modulus_size, coeff_modulus, encrypted_iter);
+            }
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+            // Transparent ciphertext output is not allowed.
+            if (encrypted.is_transparent())
+            {
+                throw logic_error("result ciphertext is transparent");
+            }
+#endif
+        });
+    }
+
+    void Evaluator::multiply_plain_inplace(Ciphertext &encrypted, const Plaintext &plain, MemoryPoolHandle pool)
     {
         // Verify parameters.
         if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
@@ -1473,16 +2117,37 @@ namespace seal
         {
             throw invalid_argument("plain is not valid for encryption parameters");
         }
-        if (encrypted.is_ntt_form() != plain.is_ntt_form())
-        {
-            throw invalid_argument("NTT form mismatch");
-        }
         if (!pool)
         {
             throw invalid_argument("pool is uninitialized");
         }
 
-        if (encrypted.is_ntt_form())
+        auto scheme = context_.get_context_data(encrypted.parms_id())->parms().scheme();
+        bool is_bfv_or_bgv = scheme == scheme_type::bfv || scheme == scheme_type::bgv;
+        if (is_bfv_or_bgv && encrypted.is_ntt_form() && !plain.is_ntt_form())
+        {
+            // BFV ciphertext kept in NTT form or BGV ciphertext; transform a copy of the plaintext to match
+            Plaintext plain_ntt(plain, pool);
+            transform_to_ntt_inplace(plain_ntt, encrypted.parms_id(), pool);
+            multiply_plain_ntt(encrypted, plain_ntt);
+        }
+        else if (scheme == scheme_type::bfv && !encrypted.is_ntt_form() && plain.is_ntt_form())
+        {
+            // Plaintext encoded in NTT form, for example by BatchEncoder; transform the ciphertext there and back.
+            // Check the level first so that a mismatch leaves the ciphertext unchanged.
+            if (encrypted.parms_id() != plain.parms_id())
+            {
+                throw invalid_argument("encrypted and plain parameter mismatch");
+            }
+            transform_to_ntt_inplace(encrypted);
+            multiply_plain_ntt(encrypted, plain);
+            transform_from_ntt_inplace(encrypted);
+        }
+        else if (encrypted.is_ntt_form() != plain.is_ntt_form())
+        {
+            throw invalid_argument("NTT form mismatch");
+        }
+        else if (encrypted.is_ntt_form())
         {
             multiply_plain_ntt(encrypted, plain);
         }
@@ -1669,6 +2334,340 @@ namespace seal
         encrypted_ntt.scale() = new_scale;
     }
 
+    void Evaluator::multiply_plain_batch_inplace(
+        vector<Ciphertext> &encrypteds, const Plaintext &plain, size_t thread_count)
+    {
+        // Verify parameters.
+        auto context_data_ptr = verify_batch(encrypteds, thread_count);
+        if (!is_metadata_valid_for(plain, context_) || !is_buffer_valid(plain))
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+        if (!context_data_ptr)
+        {
+            return;
+        }
+
+        auto &first = encrypteds[0];
+        auto scheme = context_data_ptr->parms().scheme();
+        bool is_bfv_or_bgv = scheme == scheme_type::bfv || scheme == scheme_type::bgv;
+        if (first.is_ntt_form() != plain.is_ntt_form() && !(is_bfv_or_bgv && first.is_ntt_form()) &&
+            !(scheme == scheme_type::bfv && plain.is_ntt_form()))
+        {
+            throw invalid_argument("NTT form mismatch");
+        }
+
+        if (!first.is_ntt_form() && !plain.is_ntt_form() && plain.nonzero_coeff_count() == 1)
+        {
+            // Monomials are multiplied directly in coefficient form
+            for_each_parallel(encrypteds, thread_count, [&](Ciphertext &encrypted, MemoryPoolHandle pool) {
+                multiply_plain_normal(encrypted, plain, move(pool));
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+                // Transparent ciphertext output is not allowed.
+                if (encrypted.is_transparent())
+                {
+                    throw logic_error("result ciphertext is transparent");
+                }
+#endif
+            });
+            return;
+        }
+
+        // Transform the plaintext only once instead of once per ciphertext
+        Plaintext plain_ntt;
+        if (!plain.is_ntt_form())
+        {
+            transform_to_ntt(plain, first.parms_id(), plain_ntt);
+        }
+        const Plaintext &operand = plain.is_ntt_form() ? plain : plain_ntt;
+        bool transform_encrypted = !first.is_ntt_form();
+        if (transform_encrypted && first.parms_id() != operand.parms_id())
+        {
+            // Fail before any ciphertext is moved to NTT form
+            throw invalid_argument("encrypteds and plain parameter mismatch");
+        }
+
+        for_each_parallel(encrypteds, thread_count, [&](Ciphertext &encrypted, MemoryPoolHandle) {
+            if (transform_encrypted)
+            {
+                transform_to_ntt_inplace(encrypted);
+            }
+            multiply_plain_ntt(encrypted, operand);
+            if (transform_encrypted)
+            {
+                transform_from_ntt_inplace(encrypted);
+            }
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+            // Transparent ciphertext output is not allowed.
+            if (encrypted.is_transparent())
+            {
+                throw logic_error("result ciphertext is transparent");
+            }
+#endif
+        });
+    }
+
+    void Evaluator::add_const_inplace(Ciphertext &encrypted, uint64_t value)
+    {
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        auto &parms = context_data.parms();
+        if (parms.scheme() != scheme_type::bfv && parms.scheme() != scheme_type::bgv)
+        {
+            throw logic_error("unsupported scheme");
+        }
+        if (parms.scheme() == scheme_type::bgv && !encrypted.is_ntt_form())
+        {
+            throw invalid_argument("BGV encrypted must be in NTT form");
+        }
+
+        // Extract encryption parameters.
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_modulus_size = coeff_modulus.size();
+        auto &plain_modulus = parms.plain_modulus();
+        value = barrett_reduce_64(value, plain_modulus);
+
+        if (parms.scheme() == scheme_type::bgv)
+        {
+            // The constant is multiplied by the correction factor and is the same in every coefficient of the NTT
+            // form
+            value = multiply_uint_mod(value, encrypted.correction_factor(), plain_modulus);
+            SEAL_ITERATE(iter(*iter(encrypted), coeff_modulus), coeff_modulus_size, [&](auto I) {
+                add_poly_scalar_coeffmod(
+                    get<0>(I), coeff_count, barrett_reduce_64(value, get<1>(I)), get<1>(I), get<0>(I));
+            });
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+            // Transparent ciphertext output is not allowed.
+            if (encrypted.is_transparent())
+            {
+                throw logic_error("result ciphertext is transparent");
+            }
+#endif
+            return;
+        }
+
+        // Compute floor(q / t) * value + fix, rounded as in multiply_add_plain_with_scaling_variant, where
+        // fix = floor(((q mod t) * value + floor((t + 1) / 2)) / t)
+        unsigned long long prod[2]{ 0, 0 };
+        uint64_t numerator[2]{ 0, 0 };
+        multiply_uint64(value, context_data.coeff_modulus_mod_plain_modulus(), prod);
+        unsigned char carry = add_uint64(*prod, context_data.plain_upper_half_threshold(), numerator);
+        numerator[1] = static_cast<uint64_t>(prod[1]) + static_cast<uint64_t>(carry);
+        uint64_t fix[2]{ 0, 0 };
+        divide_uint128_inplace(numerator, plain_modulus.value(), fix);
+
+        // A constant polynomial has the same value in every coefficient of its NTT form
+        bool is_ntt_form = encrypted.is_ntt_form();
+        SEAL_ITERATE(
+            iter(*iter(encrypted), coeff_modulus, context_data.coeff_div_plain_modulus()), coeff_modulus_size,
+            [&](auto I) {
+                uint64_t scaled_value = multiply_add_uint_mod(value, get<2>(I), fix[0], get<1>(I));
+                if (is_ntt_form)
+                {
+                    add_poly_scalar_coeffmod(get<0>(I), coeff_count, scaled_value, get<1>(I), get<0>(I));
+                }
+                else
+                {
+                    get<0>(I)[0] = add_uint_mod(get<0>(I)[0], scaled_value, get<1>(I));
+                }
+            });
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+        // Transparent ciphertext output is not allowed.
+        if (encrypted.is_transparent())
+        {
+            throw logic_error("result ciphertext is transparent");
+        }
+#endif
+    }
+
+    void Evaluator::add_const_inplace(Ciphertext &encrypted, int64_t value)
+    {
+        add_const_inplace(encrypted, reduce_const(encrypted, value));
+    }
+
+    void Evaluator::add_const_inplace(Ciphertext &encrypted, double value)
+    {
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        auto &parms = context_data.parms();
+        if (parms.scheme() != scheme_type::ckks)
+        {
+            throw logic_error("unsupported scheme");
+        }
+        if (!encrypted.is_ntt_form())
+        {
+            throw invalid_argument("CKKS encrypted must be in NTT form");
+        }
+
+        double scaled_value = value * encrypted.scale();
+        if (!is_scaled_value_within_bounds(scaled_value, context_data))
+        {
+            throw invalid_argument("encoded value is too large");
+        }
+
+        // Extract encryption parameters.
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_modulus_size = coeff_modulus.size();
+
+        // The constant is the same in every coefficient of the NTT form
+        uint64_t coeffu[2]{ 0, 0 };
+        bool is_negative = decompose_rounded(scaled_value, coeffu);
+        SEAL_ITERATE(iter(*iter(encrypted), coeff_modulus), coeff_modulus_size, [&](auto I) {
+            uint64_t scalar = reduce_signed_uint128(coeffu, is_negative, get<1>(I));
+            add_poly_scalar_coeffmod(get<0>(I), coeff_count, scalar, get<1>(I), get<0>(I));
+        });
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+        // Transparent ciphertext output is not allowed.
+        if (encrypted.is_transparent())
+        {
+            throw logic_error("result ciphertext is transparent");
+        }
+#endif
+    }
+
+    void Evaluator::sub_const_inplace(Ciphertext &encrypted, uint64_t value)
+    {
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+
+        auto &parms = context_.get_context_data(encrypted.parms_id())->parms();
+        if (parms.scheme() != scheme_type::bfv && parms.scheme() != scheme_type::bgv)
+        {
+            throw logic_error("unsupported scheme");
+        }
+
+        auto &plain_modulus = parms.plain_modulus();
+        add_const_inplace(encrypted, negate_uint_mod(barrett_reduce_64(value, plain_modulus), plain_modulus));
+    }
+
+    void Evaluator::sub_const_inplace(Ciphertext &encrypted, int64_t value)
+    {
+        sub_const_inplace(encrypted, reduce_const(encrypted, value));
+    }
+
+    void Evaluator::multiply_const_inplace(Ciphertext &encrypted, uint64_t value)
+    {
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        auto &parms = context_data.parms();
+        if (parms.scheme() != scheme_type::bfv && parms.scheme() != scheme_type::bgv)
+        {
+            throw logic_error("unsupported scheme");
+        }
+
+        auto &plain_modulus = parms.plain_modulus();
+        value = barrett_reduce_64(value, plain_modulus);
+        if (!value)
+        {
+            throw invalid_argument("value cannot be zero");
+        }
+
+        // Use the representative of smallest absolute value to minimize the noise growth
+        bool is_negative = value >= context_data.plain_upper_half_threshold();
+        uint64_t coeffu[2]{ is_negative ? plain_modulus.value() - value : value, 0 };
+        multiply_signed_uint128(encrypted, coeffu, is_negative, context_data);
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+        // Transparent ciphertext output is not allowed.
+        if (encrypted.is_transparent())
+        {
+            throw logic_error("result ciphertext is transparent");
+        }
+#endif
+    }
+
+    void Evaluator::multiply_const_inplace(Ciphertext &encrypted, int64_t value)
+    {
+        multiply_const_inplace(encrypted, reduce_const(encrypted, value));
+    }
+
+    uint64_t Evaluator::reduce_const(const Ciphertext &encrypted, int64_t value) const
+    {
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+
+        auto &parms = context_.get_context_data(encrypted.parms_id())->parms();
+        if (parms.scheme() != scheme_type::bfv && parms.scheme() != scheme_type::bgv)
+        {
+            throw logic_error("unsupported scheme");
+        }
+
+        auto &plain_modulus = parms.plain_modulus();
+        if (value < 0)
+        {
+            uint64_t abs_value = static_cast<uint64_t>(-(value + 1)) + 1;
+            return negate_uint_mod(barrett_reduce_64(abs_value, plain_modulus), plain_modulus);
+        }
+        return barrett_reduce_64(static_cast<uint64_t>(value), plain_modulus);
+    }
+
+    void Evaluator::multiply_const_inplace(Ciphertext &encrypted, double value, double scale)
+    {
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        if (context_data.parms().scheme() != scheme_type::ckks)
+        {
+            throw logic_error("unsupported scheme");
+        }
+        if (!encrypted.is_ntt_form())
+        {
+            throw invalid_argument("CKKS encrypted must be in NTT form");
+        }
+
+        double new_scale = encrypted.scale() * scale;
+        if (!is_scale_within_bounds(scale, context_data) || !is_scale_within_bounds(new_scale, context_data))
+        {
+            throw invalid_argument("scale out of bounds");
+        }
+
+        double scaled_value = value * scale;
+        if (!is_scaled_value_within_bounds(scaled_value, context_data))
+        {
+            throw invalid_argument("encoded value is too large");
+        }
+
+        uint64_t coeffu[2]{ 0, 0 };
+        bool is_negative = decompose_rounded(scaled_value, coeffu);
+        multiply_signed_uint128(encrypted, coeffu, is_negative, context_data);
+
+        // Set the scale
+        encrypted.scale() = new_scale;
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+        // Transparent ciphertext output is not allowed.
+        if (encrypted.is_transparent())
+        {
+            throw logic_error("result ciphertext is transparent");
+        }
+#endif
+    }
+
     void Evaluator::transform_to_ntt_inplace(Plaintext &plain, parms_id_type parms_id, MemoryPoolHandle pool)
     {
         // Verify parameters.
@@ -1906,12 +2905,18 @@ namespace seal
             throw invalid_argument("encrypted size must be 2");
         }
 
+        if (parms.scheme() != scheme_type::bfv && parms.scheme() != scheme_type::ckks &&
+            parms.scheme() != scheme_type::bgv)
+        {
+            throw logic_error("scheme not implemented");
+        }
+
         SEAL_ALLOCATE_GET_RNS_ITER(temp, coeff_count, coeff_modulus_size, pool);
 
         // DO NOT CHANGE EXECUTION ORDER OF FOLLOWING SECTION
         // BEGIN: Apply Galois for each ciphertext
         // Execution order is sensitive, since apply_galois is not inplace!
-        if (parms.scheme() == scheme_type::bfv)
+        if (!encrypted.is_ntt_form())
         {
             // !!! DO NOT CHANGE EXECUTION ORDER!!!
 
@@ -1925,8 +2930,9 @@ namespace seal
             // Next transform encrypted.data(1)
             galois_tool->apply_galois(encrypted_iter[1], coeff_modulus_size, galois_elt, coeff_modulus, temp);
         }
-        else if (parms.scheme() == scheme_type::ckks)
+        else
         {
+            // CKKS, BGV, or BFV kept in NTT form: permute the NTT slots directly
             // !!! DO NOT CHANGE EXECUTION ORDER!!!
 
             // First transform encrypted.data(0)
@@ -1939,10 +2945,6 @@ namespace seal
             // Next transform encrypted.data(1)
             galois_tool->apply_galois_ntt(encrypted_iter[1], coeff_modulus_size, galois_elt, temp);
         }
-        else
-        {
-            throw logic_error("scheme not implemented");
-        }
 
         // Wipe encrypted.data(1)
         set_zero_poly(coeff_count, coeff_modulus_size, encrypted.data(1));
@@ -1951,8 +2953,18 @@ namespace seal
         // REORDERING IS SAFE NOW
 
         // Calculate (temp * galois_key[0], temp * galois_key[1]) + (ct[0], 0)
-        switch_key_inplace(
-            encrypted, temp, static_cast<const KSwitchKeys &>(galois_keys), GaloisKeys::get_index(galois_elt), pool);
+        if (galois_keys.is_lazy())
+        {
+            // Hold on to the expanded key in case it is evicted by another thread
+            auto galois_key = galois_keys.acquire_key(context_, galois_elt);
+            switch_key_inplace(encrypted, temp, *galois_key, nullptr, pool);
+        }
+        else
+        {
+            switch_key_inplace(
+                encrypted, temp, static_cast<const KSwitchKeys &>(galois_keys), GaloisKeys::get_index(galois_elt),
+                pool);
+        }
 #ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
         // Transparent ciphertext output is not allowed.
         if (encrypted.is_transparent())
@@ -1962,6 +2974,45 @@ namespace seal
 #endif
     }
 
+    void Evaluator::rotate_batch_internal(
+        vector<Ciphertext> &encrypteds, int steps, const GaloisKeys &galois_keys, size_t thread_count)
+    {
+        // Verify parameters.
+        auto context_data_ptr = verify_batch(encrypteds, thread_count);
+        if (!context_data_ptr)
+        {
+            return;
+        }
+        if (!context_data_ptr->qualifiers().using_batching)
+        {
+            throw logic_error("encryption parameters do not support batching");
+        }
+        if (galois_keys.parms_id() != context_.key_parms_id())
+        {
+            throw invalid_argument("galois_keys is not valid for encryption parameters");
+        }
+
+        // Is there anything to do?
+        if (steps == 0)
+        {
+            return;
+        }
+
+        // Steps without a dedicated Galois key are decomposed by rotate_internal
+        auto galois_elt = context_data_ptr->galois_tool()->get_elt_from_step(steps);
+        bool has_key = galois_keys.has_key(galois_elt);
+        for_each_parallel(encrypteds, thread_count, [&](Ciphertext &encrypted, MemoryPoolHandle pool) {
+            if (has_key)
+            {
+                apply_galois_inplace(encrypted, galois_elt, galois_keys, move(pool));
+            }
+            else
+            {
+                rotate_internal(encrypted, steps, galois_keys, move(pool));
+            }
+        });
+    }
+
     void Evaluator::rotate_internal(
         Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, MemoryPoolHandle pool)
     {
@@ -2019,31 +3070,152 @@ namespace seal
         }
     }
 
-    void Evaluator::switch_key_inplace(
-        Ciphertext &encrypted, ConstRNSIter target_iter, const KSwitchKeys &kswitch_keys, size_t kswitch_keys_index,
-        MemoryPoolHandle pool)
+    void Evaluator::rotate_vector_hoisted(
+        const Ciphertext &encrypted, const vector<int> &steps, const GaloisKeys &galois_keys,
+        vector<Ciphertext> &destinations, MemoryPoolHandle pool)
     {
-        auto parms_id = encrypted.parms_id();
-        auto &context_data = *context_.get_context_data(parms_id);
-        auto &parms = context_data.parms();
-        auto &key_context_data = *context_.key_context_data();
-        auto &key_parms = key_context_data.parms();
-        auto scheme = parms.scheme();
+        if (context_.key_context_data()->parms().scheme() != scheme_type::ckks)
+        {
+            throw logic_error("unsupported scheme");
+        }
 
         // Verify parameters.
         if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
         {
             throw invalid_argument("encrypted is not valid for encryption parameters");
         }
-        if (!target_iter)
+        if (galois_keys.parms_id() != context_.key_parms_id())
         {
-            throw invalid_argument("target_iter");
+            throw invalid_argument("galois_keys is not valid for encryption parameters");
+        }
+        if (!encrypted.is_ntt_form())
+        {
+            throw invalid_argument("encrypted must be in NTT form");
+        }
+        if (encrypted.size() != 2)
+        {
+            throw invalid_argument("encrypted size must be 2");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
         }
         if (!context_.using_keyswitching())
         {
             throw logic_error("keyswitching is not supported by the context");
         }
 
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        if (!context_data.qualifiers().using_batching)
+        {
+            throw logic_error("encryption parameters do not support batching");
+        }
+
+        // Find the Galois elements first, so that missing keys are reported before any work is done
+        auto galois_tool = context_.key_context_data()->galois_tool();
+        vector<uint32_t> galois_elts;
+        for (int step : steps)
+        {
+            uint32_t galois_elt = step ? galois_tool->get_elt_from_step(step) : 0;
+            if (galois_elt && !galois_keys.has_key(galois_elt))
+            {
+                throw invalid_argument("Galois key not present");
+            }
+            galois_elts.push_back(galois_elt);
+        }
+
+        // Extract encryption parameters.
+        auto &parms = context_data.parms();
+        auto &key_context_data = *context_.key_context_data();
+        auto &key_modulus = key_context_data.parms().coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t decomp_modulus_size = parms.coeff_modulus().size();
+        size_t key_modulus_size = key_modulus.size();
+        size_t rns_modulus_size = decomp_modulus_size + 1;
+        auto key_ntt_tables = iter(key_context_data.small_ntt_tables());
+
+        // Size check
+        if (!product_fits_in(coeff_count, rns_modulus_size, decomp_modulus_size))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // Decompose the second component once, as switch_key_inplace would: part J reduced modulo the I-th modulus of
+        // the extended basis and in NTT form is stored at index I * decomp_modulus_size + J. The automorphism is a
+        // permutation of NTT coefficients, so it can be applied to the parts afterwards.
+        ConstRNSIter c1(encrypted.data(1), coeff_count);
+        SEAL_ALLOCATE_GET_RNS_ITER(c1_coeff, coeff_count, decomp_modulus_size, pool);
+        set_uint(c1, decomp_modulus_size * coeff_count, c1_coeff);
+        inverse_ntt_negacyclic_harvey(c1_coeff, decomp_modulus_size, key_ntt_tables);
+
+        SEAL_ALLOCATE_GET_RNS_ITER(decomposed, coeff_count, rns_modulus_size * decomp_modulus_size, pool);
+        SEAL_ITERATE(iter(size_t(0)), rns_modulus_size, [&](auto I) {
+            size_t key_index = (I == decomp_modulus_size ? key_modulus_size - 1 : I);
+            SEAL_ITERATE(iter(size_t(0)), decomp_modulus_size, [&](auto J) {
+                CoeffIter part = decomposed[I * decomp_modulus_size + J];
+                if (I == J)
+                {
+                    set_uint(c1[J], coeff_count, part);
+                    return;
+                }
+                if (key_modulus[J] <= key_modulus[key_index])
+                {
+                    set_uint(c1_coeff[J], coeff_count, part);
+                }
+                else
+                {
+                    modulo_poly_coeffs(c1_coeff[J], coeff_count, key_modulus[key_index], part);
+                }
+                ntt_negacyclic_harvey_lazy(part, key_ntt_tables[key_index]);
+            });
+        });
+
+        // Results are collected separately in case encrypted is one of the destinations
+        vector<Ciphertext> results;
+        SEAL_ALLOCATE_GET_RNS_ITER(permuted, coeff_count, rns_modulus_size * decomp_modulus_size, pool);
+        for (auto galois_elt : galois_elts)
+        {
+            results.push_back(encrypted);
+            if (!galois_elt)
+            {
+                continue;
+            }
+            auto &result = results.back();
+
+            // Apply the automorphism to the first component and to the decomposition of the second one
+            auto encrypted_iter = iter(encrypted);
+            galois_tool->apply_galois_ntt(encrypted_iter[0], decomp_modulus_size, galois_elt, iter(result)[0]);
+            galois_tool->apply_galois_ntt(
+                decomposed, rns_modulus_size * decomp_modulus_size, galois_elt, permuted);
+            set_zero_poly(coeff_count, decomp_modulus_size, result.data(1));
+
+            if (galois_keys.is_lazy())
+            {
+                // Hold on to the expanded key in case it is evicted by another thread
+                auto galois_key = galois_keys.acquire_key(context_, galois_elt);
+                switch_key_inplace(result, ConstRNSIter(), *galois_key, nullptr, pool, permuted);
+            }
+            else
+            {
+                switch_key_inplace(
+                    result, ConstRNSIter(), static_cast<const KSwitchKeys &>(galois_keys),
+                    GaloisKeys::get_index(galois_elt), pool, permuted);
+            }
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+            // Transparent ciphertext output is not allowed.
+            if (result.is_transparent())
+            {
+                throw logic_error("result ciphertext is transparent");
+            }
+#endif
+        }
+        destinations = move(results);
+    }
+
+    void Evaluator::switch_key_inplace(
+        Ciphertext &encrypted, ConstRNSIter target_iter, const KSwitchKeys &kswitch_keys, size_t kswitch_keys_index,
+        MemoryPoolHandle pool, const uint64_t *decomposed_target)
+    {
         // Don't validate all of kswitch_keys but just check the parms_id.
         if (kswitch_keys.parms_id() != context_.key_parms_id())
         {
@@ -2054,18 +3226,57 @@ namespace seal
         {
             throw out_of_range("kswitch_keys_index");
         }
-        if (!pool)
+
+        switch_key_inplace(
+            encrypted, target_iter, kswitch_keys.data()[kswitch_keys_index],
+            kswitch_keys.packed_data(kswitch_keys_index), move(pool), decomposed_target);
+    }
+
+    void Evaluator::switch_key_inplace(
+        Ciphertext &encrypted, ConstRNSIter target_iter, const vector<PublicKey> &key_vector,
+        const uint64_t *packed_key, MemoryPoolHandle pool, const uint64_t *decomposed_target)
+    {
+        auto parms_id = encrypted.parms_id();
+        auto &context_data = *context_.get_context_data(parms_id);
+        auto &parms = context_data.parms();
+        auto &key_context_data = *context_.key_context_data();
+        auto &key_parms = key_context_data.parms();
+        auto scheme = parms.scheme();
+
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
         {
-            throw invalid_argument("pool is uninitialized");
+            throw invalid_argument("encrypted is not valid for encryption parameters");
         }
-        if (scheme == scheme_type::bfv && encrypted.is_ntt_form())
+        if (!target_iter && !decomposed_target)
         {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
+            throw invalid_argument("target_iter");
         }
+        if (!context_.using_keyswitching())
+        {
+            throw logic_error("keyswitching is not supported by the context");
+        }
+        if (key_vector.size() < parms.coeff_modulus().size())
+        {
+            throw invalid_argument("kswitch_keys is not valid for encryption parameters");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        pool = scratch_pool(move(pool));
         if (scheme == scheme_type::ckks && !encrypted.is_ntt_form())
         {
             throw invalid_argument("CKKS encrypted must be in NTT form");
         }
+        if (scheme == scheme_type::bgv && !encrypted.is_ntt_form())
+        {
+            throw invalid_argument("BGV encrypted must be in NTT form");
+        }
+
+        // BFV ciphertexts may also be kept in NTT form; target_iter is then in NTT form as well
+        bool is_ntt_form = encrypted.is_ntt_form();
 
         // Extract encryption parameters.
         size_t coeff_count = parms.poly_modulus_degree();
@@ -2083,8 +3294,8 @@ namespace seal
         }
 
         // Prepare input
-        auto &key_vector = kswitch_keys.data()[kswitch_keys_index];
         size_t key_component_count = key_vector[0].data().size();
+        size_t key_decomp_modulus_size = key_vector.size();
 
         // Check only the used component in KSwitchKeys.
         for (auto &each_key : key_vector)
@@ -2095,19 +3306,26 @@ namespace seal
             }
         }
 
-        // Create a copy of target_iter
-        SEAL_ALLOCATE_GET_RNS_ITER(t_target, coeff_count, decomp_modulus_size, pool);
-        set_uint(target_iter, decomp_modulus_size * coeff_count, t_target);
-
-        // In CKKS t_target is in NTT form; switch back to normal form
-        if (scheme == scheme_type::ckks)
+        // Create a copy of target_iter, unless it has already been decomposed
+        SEAL_ALLOCATE_GET_RNS_ITER(t_target, coeff_count, decomposed_target ? 0 : decomp_modulus_size, pool);
+        if (!decomposed_target)
         {
-            inverse_ntt_negacyclic_harvey(t_target, decomp_modulus_size, key_ntt_tables);
+            set_uint(target_iter, decomp_modulus_size * coeff_count, t_target);
+
+            // If t_target is in NTT form, switch back to normal form
+            if (is_ntt_form)
+            {
+                inverse_ntt_negacyclic_harvey(t_target, decomp_modulus_size, key_ntt_tables);
+            }
         }
 
         // Temporary result
         auto t_poly_prod(allocate_zero_poly_array(key_component_count, coeff_count, rns_modulus_size, pool));
 
+        // Lazy accumulator (128-bit coefficients) and NTT buffer, reused for every RNS factor
+        auto t_poly_lazy(allocate_poly_array(key_component_count, coeff_count, 2, pool));
+        SEAL_ALLOCATE_GET_COEFF_ITER(t_ntt, coeff_count, pool);
+
         SEAL_ITERATE(iter(size_t(0)), rns_modulus_size, [&](auto I) {
             size_t key_index = (I == decomp_modulus_size ? key_modulus_size - 1 : I);
 
@@ -2115,19 +3333,23 @@ namespace seal
             size_t lazy_reduction_summand_bound = size_t(SEAL_MULTIPLY_ACCUMULATE_USER_MOD_MAX);
             size_t lazy_reduction_counter = lazy_reduction_summand_bound;
 
-            // Allocate memory for a lazy accumulator (128-bit coefficients)
-            auto t_poly_lazy(allocate_zero_poly_array(key_component_count, coeff_count, 2, pool));
+            // Clear the lazy accumulator
+            set_zero_poly_array(key_component_count, coeff_count, 2, t_poly_lazy.get());
 
             // Semantic misuse of PolyIter; this is really pointing to the data for a single RNS factor
             PolyIter accumulator_iter(t_poly_lazy.get(), 2, coeff_count);
 
             // Multiply with keys and perform lazy reduction on product's coefficients
             SEAL_ITERATE(iter(size_t(0)), decomp_modulus_size, [&](auto J) {
-                SEAL_ALLOCATE_GET_COEFF_ITER(t_ntt, coeff_count, pool);
                 ConstCoeffIter t_operand;
 
+                // The decomposition was computed beforehand
+                if (decomposed_target)
+                {
+                    t_operand = decomposed_target + (I * decomp_modulus_size + J) * coeff_count;
+                }
                 // RNS-NTT form exists in input
-                if ((scheme == scheme_type::ckks) && (I == J))
+                else if (is_ntt_form && (I == J))
                 {
                     t_operand = target_iter[J];
                 }
@@ -2150,10 +3372,23 @@ namespace seal
                 }
 
                 // Multiply with keys and modular accumulate products in a lazy fashion
-                SEAL_ITERATE(iter(key_vector[J].data(), accumulator_iter), key_component_count, [&](auto K) {
+                SEAL_ITERATE(iter(size_t(0), accumulator_iter), key_component_count, [&](auto K) {
+                    // Packed keys store the components read here next to each other
+                    ConstCoeffIter t_key_acc;
+                    if (packed_key)
+                    {
+                        t_key_acc = packed_key +
+                                    ((key_index * key_decomp_modulus_size + J) * key_component_count + get<0>(K)) *
+                                        coeff_count;
+                    }
+                    else
+                    {
+                        t_key_acc = iter(key_vector[J].data())[get<0>(K)][key_index];
+                    }
+
                     if (!lazy_reduction_counter)
                     {
-                        SEAL_ITERATE(iter(t_operand, get<0>(K)[key_index], get<1>(K)), coeff_count, [&](auto L) {
+                        SEAL_ITERATE(iter(t_operand, t_key_acc, get<1>(K)), coeff_count, [&](auto L) {
                             unsigned long long qword[2]{ 0, 0 };
                             multiply_uint64(get<0>(L), get<1>(L), qword);
 
@@ -2166,7 +3401,7 @@ namespace seal
                     else
                     {
                         // Same as above but no reduction
-                        SEAL_ITERATE(iter(t_operand, get<0>(K)[key_index], get<1>(K)), coeff_count, [&](auto L) {
+                        SEAL_ITERATE(iter(t_operand, t_key_acc, get<1>(K)), coeff_count, [&](auto L) {
                             unsigned long long qword[2]{ 0, 0 };
                             multiply_uint64(get<0>(L), get<1>(L), qword);
                             add_uint128(qword, get<2>(L).ptr(), qword);
@@ -2206,39 +3441,83 @@ namespace seal
 
         // Perform modulus switching with scaling
         PolyIter t_poly_prod_iter(t_poly_prod.get(), coeff_count, rns_modulus_size);
+        auto &plain_modulus = parms.plain_modulus();
+        SEAL_ALLOCATE_GET_COEFF_ITER(t_k, coeff_count, pool);
         SEAL_ITERATE(iter(encrypted, t_poly_prod_iter), key_component_count, [&](auto I) {
             // Lazy reduction; this needs to be then reduced mod qi
             CoeffIter t_last(get<1>(I)[decomp_modulus_size]);
             inverse_ntt_negacyclic_harvey_lazy(t_last, key_ntt_tables[key_modulus_size - 1]);
 
-            // Add (p-1)/2 to change from flooring to rounding.
             uint64_t qk = key_modulus[key_modulus_size - 1].value();
             uint64_t qk_half = qk >> 1;
-            SEAL_ITERATE(t_last, coeff_count, [&](auto &J) {
-                J = barrett_reduce_64(J + qk_half, key_modulus[key_modulus_size - 1]);
-            });
+            if (scheme == scheme_type::bgv)
+            {
+                // In BGV the subtracted polynomial delta = t_last + qk * k must be divisible by t, so that the noise
+                // remains a multiple of t. For the centered representative of t_last, k = -t_last * qk^(-1) mod t.
+                uint64_t qk_mod_t = barrett_reduce_64(qk, plain_modulus);
+                auto &inv_qk_mod_t = key_context_data.rns_tool()->inv_q_last_mod_t();
+                SEAL_ITERATE(iter(t_last, t_k), coeff_count, [&](auto J) {
+                    get<0>(J) = barrett_reduce_64(get<0>(J), key_modulus[key_modulus_size - 1]);
+                    uint64_t c_mod_t = barrett_reduce_64(get<0>(J), plain_modulus);
+                    if (get<0>(J) > qk_half)
+                    {
+                        c_mod_t = sub_uint_mod(c_mod_t, qk_mod_t, plain_modulus);
+                    }
+                    get<1>(J) =
+                        multiply_uint_mod(negate_uint_mod(c_mod_t, plain_modulus), inv_qk_mod_t, plain_modulus);
+                });
+            }
+            else
+            {
+                // Add (p-1)/2 to change from flooring to rounding.
+                SEAL_ITERATE(t_last, coeff_count, [&](auto &J) {
+                    J = barrett_reduce_64(J + qk_half, key_modulus[key_modulus_size - 1]);
+                });
+            }
 
             SEAL_ITERATE(iter(I, key_modulus, key_ntt_tables, modswitch_factors), decomp_modulus_size, [&](auto J) {
-                SEAL_ALLOCATE_GET_COEFF_ITER(t_ntt, coeff_count, pool);
-
-                // (ct mod 4qk) mod qi
                 uint64_t qi = get<1>(J).value();
-                if (qk > qi)
+                if (scheme == scheme_type::bgv)
                 {
-                    // This cannot be spared. NTT only tolerates input that is less than 4*modulus (i.e. qk <=4*qi).
-                    modulo_poly_coeffs(t_last, coeff_count, get<1>(J), t_ntt);
+                    // delta mod qi, in [0, qi)
+                    uint64_t qk_mod_qi = barrett_reduce_64(qk, get<1>(J));
+                    uint64_t t_mod_qi = barrett_reduce_64(plain_modulus.value(), get<1>(J));
+                    uint64_t t_half = plain_modulus.value() >> 1;
+                    SEAL_ITERATE(iter(t_last, t_k, t_ntt), coeff_count, [&](auto K) {
+                        uint64_t c = barrett_reduce_64(get<0>(K), get<1>(J));
+                        if (get<0>(K) > qk_half)
+                        {
+                            c = sub_uint_mod(c, qk_mod_qi, get<1>(J));
+                        }
+                        uint64_t k = barrett_reduce_64(get<1>(K), get<1>(J));
+                        if (get<1>(K) > t_half)
+                        {
+                            k = sub_uint_mod(k, t_mod_qi, get<1>(J));
+                        }
+                        get<2>(K) = multiply_add_uint_mod(k, qk_mod_qi, c, get<1>(J));
+                    });
                 }
                 else
                 {
-                    set_uint(t_last, coeff_count, t_ntt);
-                }
+                    // (ct mod 4qk) mod qi
+                    if (qk > qi)
+                    {
+                        // This cannot be spared. NTT only tolerates input that is less than 4*modulus (i.e.
+                        // qk <=4*qi).
+                        modulo_poly_coeffs(t_last, coeff_count, get<1>(J), t_ntt);
+                    }
+                    else
+                    {
+                        set_uint(t_last, coeff_count, t_ntt);
+                    }
 
-                // Lazy substraction, results in [0, 2*qi), since fix is in [0, qi].
-                uint64_t fix = qi - barrett_reduce_64(qk_half, get<1>(J));
-                SEAL_ITERATE(t_ntt, coeff_count, [fix](auto &K) { K += fix; });
+                    // Lazy substraction, results in [0, 2*qi), since fix is in [0, qi].
+                    uint64_t fix = qi - barrett_reduce_64(qk_half, get<1>(J));
+                    SEAL_ITERATE(t_ntt, coeff_count, [fix](auto &K) { K += fix; });
+                }
 
                 uint64_t qi_lazy = qi << 1; // some multiples of qi
-                if (scheme == scheme_type::ckks)
+                if (is_ntt_form)
                 {
                     // This ntt_negacyclic_harvey_lazy results in [0, 4*qi).
                     ntt_negacyclic_harvey_lazy(t_ntt, get<2>(J));
@@ -2252,7 +3531,7 @@ namespace seal
                     qi_lazy = qi << 2;
 #endif
                 }
-                else if (scheme == scheme_type::bfv)
+                else
                 {
                     inverse_ntt_negacyclic_harvey_lazy(get<0, 1>(J), get<2>(J));
                 }
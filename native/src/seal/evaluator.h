@@ -14,7 +14,9 @@
 #include "seal/valcheck.h"
 #include "seal/util/iterator.h"
 #include <map>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 namespace seal
@@ -50,6 +52,21 @@ namespace seal
     When batching is enabled, we provide operations for rotating the plaintext matrix rows cyclically left or right, and
     for rotating the columns (swapping the rows). Rotations require Galois keys to have been generated.
 
+    @par Batch Operations
+    When the same plain operation or rotation is applied to many ciphertexts, the batch variants such as
+    multiply_plain_batch_inplace validate the inputs and prepare the plaintext or Galois element once, and then process
+    the ciphertexts on several threads. Each thread allocates from its own memory pool, so the scratch memory of one
+    ciphertext is reused for the next. All ciphertexts in a batch must have the same parameters, NTT form, and scale.
+
+    @par Scratch Memory
+    Multiplication, squaring, relinearization, rotations, and modulus switching with scaling need a number of
+    temporary polynomials that are released before the operation returns. When these operations are given the global
+    memory pool, which is the default, the temporaries are instead allocated from the thread-local memory pool. This
+    avoids contention on the global memory pool when many threads evaluate concurrently, and after the first operation
+    on a thread the temporaries are served from memory freed by the previous one. The thread-local memory pool holds on
+    to this memory until the thread exits. To allocate the temporaries from a specific memory pool, pass a memory pool
+    other than the global one.
+
     @par Other Operations
     We also provide operations for transforming ciphertexts to NTT form and back, and for transforming plaintext
     polynomials to NTT form. These can be used in a very fast plain multiplication variant, that assumes the inputs to
@@ -60,11 +77,21 @@ namespace seal
     @par NTT form
     When using the BFV scheme (scheme_type::bfv), all plaintexts and ciphertexts should remain by default in the usual
     coefficient representation, i.e., not in NTT form. When using the CKKS scheme (scheme_type::ckks), all plaintexts
-    and ciphertexts should remain by default in NTT form. We call these scheme-specific NTT states the "default NTT
-    form". Some functions, such as add, work even if the inputs are not in the default state, but others, such as
-    multiply, will throw an exception. The output of all evaluation functions will be in the same state as the input(s),
-    with the exception of the transform_to_ntt and transform_from_ntt functions, which change the state. Ideally, unless
-    these two functions are called, all other functions should "just work".
+    and ciphertexts should remain by default in NTT form. When using the BGV scheme (scheme_type::bgv), plaintexts
+    should remain in the usual coefficient representation and ciphertexts in NTT form. We call these scheme-specific NTT
+    states the "default NTT form". Some functions, such as add, work even if the inputs are not in the default state,
+    but others, such as multiply, will throw an exception. The output of all evaluation functions will be in the same
+    state as the input(s), with the exception of the transform_to_ntt and transform_from_ntt functions, which change the
+    state. Ideally, unless these two functions are called, all other functions should "just work".
+
+    @par Keeping BFV Ciphertexts in NTT Form
+    BFV ciphertexts can be transformed to NTT form with transform_to_ntt and kept there across sequences of additions,
+    negations, plain multiplications, and rotations, avoiding the repeated transforms that these functions would
+    otherwise perform internally. In particular, rotations of such ciphertexts permute the NTT form directly and skip
+    the forward and inverse transforms around key switching. Plaintexts given to add_plain and sub_plain remain in
+    coefficient form, and multiply_plain transforms a coefficient form plaintext automatically, although transforming
+    it once with transform_to_ntt is faster when it is reused. Ciphertext multiplication, relinearization, and modulus
+    switching still require the coefficient form, so call transform_from_ntt before these and before decryption.
 
     @see EncryptionParameters for more details on encryption parameters.
     @see BatchEncoder for more details on batching
@@ -578,7 +605,7 @@ namespace seal
         @param[in] relin_keys The relinearization keys
         @param[out] destination The ciphertext to overwrite with the multiplication result
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
-        @throws std::logic_error if scheme is not scheme_type::bfv
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
         @throws std::invalid_argument if encrypteds is empty
         @throws std::invalid_argument if ciphertexts or relin_keys are not valid for the encryption parameters
         @throws std::invalid_argument if encrypteds are not in the default NTT form
@@ -592,17 +619,44 @@ namespace seal
             const std::vector<Ciphertext> &encrypteds, const RelinKeys &relin_keys, Ciphertext &destination,
             MemoryPoolHandle pool = MemoryManager::GetPool());
 
+        /**
+        Multiplies several ciphertexts together using several threads. This function computes the product of several
+        ciphertexts given as an std::vector and stores the result in the destination parameter. The product tree is
+        evaluated level by level, and the independent multiplications within each level are distributed across up to
+        thread_count threads. Relinearization is performed automatically after every multiplication in the process.
+        Each thread allocates from its own new memory pool, and the ciphertexts of one level reuse the memory of the
+        level two steps before, so the memory in use is proportional to the number of input ciphertexts.
+
+        @param[in] encrypteds The ciphertexts to multiply
+        @param[in] relin_keys The relinearization keys
+        @param[out] destination The ciphertext to overwrite with the multiplication result
+        @param[in] thread_count The maximum number of threads to use
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::invalid_argument if encrypteds is empty
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::invalid_argument if ciphertexts or relin_keys are not valid for the encryption parameters
+        @throws std::invalid_argument if encrypteds are not in the default NTT form
+        @throws std::invalid_argument if the output scale is too large for the encryption parameters
+        @throws std::invalid_argument if the size of relin_keys is too small
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void multiply_many_parallel(
+            const std::vector<Ciphertext> &encrypteds, const RelinKeys &relin_keys, Ciphertext &destination,
+            std::size_t thread_count);
+
         /**
         Exponentiates a ciphertext. This functions raises encrypted to a power. Dynamic memory allocations in the
         process are allocated from the memory pool pointed to by the given MemoryPoolHandle. The exponentiation is done
-        in a depth-optimal order, and relinearization is performed automatically after every multiplication in the
-        process. In relinearization the given relinearization keys are used.
+        by binary square-and-multiply in a depth-optimal order, following the addition chain returned by
+        ExponentiationChain, and relinearization is performed automatically after every multiplication in the process.
+        In relinearization the given relinearization keys are used.
 
         @param[in] encrypted The ciphertext to exponentiate
         @param[in] exponent The power to raise the ciphertext to
         @param[in] relin_keys The relinearization keys
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
-        @throws std::logic_error if scheme is not scheme_type::bfv
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
         @throws std::invalid_argument if encrypted or relin_keys is not valid for the encryption parameters
         @throws std::invalid_argument if encrypted is not in the default NTT form
         @throws std::invalid_argument if the output scale is too large for the encryption parameters
@@ -619,16 +673,16 @@ namespace seal
         /**
         Exponentiates a ciphertext. This functions raises encrypted to a power and stores the result in the destination
         parameter. Dynamic memory allocations in the process are allocated from the memory pool pointed to by the given
-        MemoryPoolHandle. The exponentiation is done in a depth-optimal order, and relinearization is performed
-        automatically after every multiplication in the process. In relinearization the given relinearization keys are
-        used.
+        MemoryPoolHandle. The exponentiation is done by binary square-and-multiply in a depth-optimal order, following
+        the addition chain returned by ExponentiationChain, and relinearization is performed automatically after every
+        multiplication in the process. In relinearization the given relinearization keys are used.
 
         @param[in] encrypted The ciphertext to exponentiate
         @param[in] exponent The power to raise the ciphertext to
         @param[in] relin_keys The relinearization keys
         @param[out] destination The ciphertext to overwrite with the power
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
-        @throws std::logic_error if scheme is not scheme_type::bfv
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
         @throws std::invalid_argument if encrypted or relin_keys is not valid for the encryption parameters
         @throws std::invalid_argument if encrypted is not in the default NTT form
         @throws std::invalid_argument if the output scale is too large for the encryption parameters
@@ -646,13 +700,26 @@ namespace seal
             exponentiate_inplace(destination, exponent, relin_keys, std::move(pool));
         }
 
+        /**
+        Returns the addition chain that exponentiate follows for a given exponent. The chain starts with 1 and ends
+        with exponent, and lists the exponents of the powers in the order they are computed. Each element is either
+        twice an earlier element, computed with a squaring, or the sum of two earlier elements, computed with a
+        multiplication. Each step is followed by relinearization. The length of the chain minus one is the number of
+        ciphertext multiplications, and the multiplicative depth is ceil(log2(exponent)).
+
+        @param[in] exponent The power to raise a ciphertext to
+        @throws std::invalid_argument if exponent is zero
+        */
+        SEAL_NODISCARD static std::vector<std::uint64_t> ExponentiationChain(std::uint64_t exponent);
+
         /**
         Adds a ciphertext and a plaintext.
 
         @param[in] encrypted The ciphertext to add
         @param[in] plain The plaintext to add
         @throws std::invalid_argument if encrypted or plain is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted or plain is not in the default NTT form
+        @throws std::invalid_argument if encrypted or plain is not in the default NTT form, except that a BFV encrypted
+        may be in NTT form
         @throws std::invalid_argument if encrypted and plain are at different level or scale
         @throws std::logic_error if result ciphertext is transparent
         */
@@ -667,7 +734,8 @@ namespace seal
         @param[in] plain The plaintext to add
         @param[out] destination The ciphertext to overwrite with the addition result
         @throws std::invalid_argument if encrypted or plain is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted or plain is not in the default NTT form
+        @throws std::invalid_argument if encrypted or plain is not in the default NTT form, except that a BFV encrypted
+        may be in NTT form
         @throws std::invalid_argument if encrypted and plain are at different level or scale
         @throws std::logic_error if result ciphertext is transparent
         */
@@ -683,7 +751,8 @@ namespace seal
         @param[in] encrypted The ciphertext to subtract from
         @param[in] plain The plaintext to subtract
         @throws std::invalid_argument if encrypted or plain is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted or plain is not in the default NTT form
+        @throws std::invalid_argument if encrypted or plain is not in the default NTT form, except that a BFV encrypted
+        may be in NTT form
         @throws std::invalid_argument if encrypted and plain are at different level or scale
         @throws std::logic_error if result ciphertext is transparent
         */
@@ -697,7 +766,8 @@ namespace seal
         @param[in] plain The plaintext to subtract
         @param[out] destination The ciphertext to overwrite with the subtraction result
         @throws std::invalid_argument if encrypted or plain is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted or plain is not in the default NTT form
+        @throws std::invalid_argument if encrypted or plain is not in the default NTT form, except that a BFV encrypted
+        may be in NTT form
         @throws std::invalid_argument if encrypted and plain are at different level or scale
         @throws std::logic_error if result ciphertext is transparent
         */
@@ -715,7 +785,10 @@ namespace seal
         @param[in] plain The plaintext to multiply
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted or plain is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted and plain are in different NTT forms
+        @throws std::invalid_argument if encrypted and plain are in different NTT forms, unless encrypted is a BFV
+        ciphertext in NTT form, in which case plain is transformed to NTT form automatically, or plain is in NTT form
+        and encrypted is a BFV ciphertext at the same level, in which case encrypted is transformed to NTT form and
+        back
         @throws std::invalid_argument if the output scale is too large for the encryption parameters
         @throws std::invalid_argument if pool is uninitialized
         @throws std::logic_error if result ciphertext is transparent
@@ -733,7 +806,10 @@ namespace seal
         @param[out] destination The ciphertext to overwrite with the multiplication result
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted or plain is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted and plain are in different NTT forms
+        @throws std::invalid_argument if encrypted and plain are in different NTT forms, unless encrypted is a BFV
+        ciphertext in NTT form, in which case plain is transformed to NTT form automatically, or plain is in NTT form
+        and encrypted is a BFV ciphertext at the same level, in which case encrypted is transformed to NTT form and
+        back
         @throws std::invalid_argument if the output scale is too large for the encryption parameters
         @throws std::invalid_argument if pool is uninitialized
         @throws std::logic_error if result ciphertext is transparent
@@ -746,6 +822,412 @@ namespace seal
             multiply_plain_inplace(destination, plain, std::move(pool));
         }
 
+        /**
+        Adds a constant to every slot of a BFV or BGV ciphertext. The constant is reduced modulo the plaintext modulus
+        and added directly to the RNS representation of the ciphertext, without encoding a plaintext.
+
+        @param[in] encrypted The ciphertext to add to
+        @param[in] value The constant to add
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void add_const_inplace(Ciphertext &encrypted, std::uint64_t value);
+
+        /**
+        Adds a constant to every slot of a BFV or BGV ciphertext and stores the result in the destination parameter. The
+        constant is reduced modulo the plaintext modulus and added directly to the RNS representation of the ciphertext,
+        without encoding a plaintext.
+
+        @param[in] encrypted The ciphertext to add to
+        @param[in] value The constant to add
+        @param[out] destination The ciphertext to overwrite with the addition result
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void add_const(const Ciphertext &encrypted, std::uint64_t value, Ciphertext &destination)
+        {
+            destination = encrypted;
+            add_const_inplace(destination, value);
+        }
+
+        /**
+        Adds a signed constant to every slot of a BFV or BGV ciphertext. A negative constant is reduced modulo the
+        plaintext modulus to its non-negative representative.
+
+        @param[in] encrypted The ciphertext to add to
+        @param[in] value The constant to add
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void add_const_inplace(Ciphertext &encrypted, std::int64_t value);
+
+        /**
+        Adds a constant of any other integral type, such as an int literal, to every slot of a BFV or BGV ciphertext.
+        Signed values are added as std::int64_t and unsigned values as std::uint64_t.
+
+        @param[in] encrypted The ciphertext to add to
+        @param[in] value The constant to add
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+        inline void add_const_inplace(Ciphertext &encrypted, T value)
+        {
+            add_const_inplace(encrypted, static_cast<const_integer_type<T>>(value));
+        }
+
+        /**
+        Adds a constant of integral type to every slot of a BFV or BGV ciphertext and stores the result in the
+        destination parameter. Signed values are added as std::int64_t and unsigned values as std::uint64_t.
+
+        @param[in] encrypted The ciphertext to add to
+        @param[in] value The constant to add
+        @param[out] destination The ciphertext to overwrite with the addition result
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+        inline void add_const(const Ciphertext &encrypted, T value, Ciphertext &destination)
+        {
+            destination = encrypted;
+            add_const_inplace(destination, static_cast<const_integer_type<T>>(value));
+        }
+
+        /**
+        Adds a real constant to every slot of a CKKS ciphertext. The constant is scaled by the scale of encrypted,
+        rounded, and added directly to the RNS representation of the ciphertext, without encoding a plaintext.
+
+        @param[in] encrypted The ciphertext to add to
+        @param[in] value The constant to add
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is not in NTT form
+        @throws std::invalid_argument if the scaled value is too large for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void add_const_inplace(Ciphertext &encrypted, double value);
+
+        /**
+        Adds a real constant to every slot of a CKKS ciphertext and stores the result in the destination parameter.
+        The constant is scaled by the scale of encrypted, rounded, and added directly to the RNS representation of the
+        ciphertext, without encoding a plaintext.
+
+        @param[in] encrypted The ciphertext to add to
+        @param[in] value The constant to add
+        @param[out] destination The ciphertext to overwrite with the addition result
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is not in NTT form
+        @throws std::invalid_argument if the scaled value is too large for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void add_const(const Ciphertext &encrypted, double value, Ciphertext &destination)
+        {
+            destination = encrypted;
+            add_const_inplace(destination, value);
+        }
+
+        /**
+        Subtracts a constant from every slot of a BFV or BGV ciphertext. The constant is reduced modulo the plaintext
+        modulus.
+
+        @param[in] encrypted The ciphertext to subtract from
+        @param[in] value The constant to subtract
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void sub_const_inplace(Ciphertext &encrypted, std::uint64_t value);
+
+        /**
+        Subtracts a constant from every slot of a BFV or BGV ciphertext and stores the result in the destination
+        parameter. The constant is reduced modulo the plaintext modulus.
+
+        @param[in] encrypted The ciphertext to subtract from
+        @param[in] value The constant to subtract
+        @param[out] destination The ciphertext to overwrite with the subtraction result
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void sub_const(const Ciphertext &encrypted, std::uint64_t value, Ciphertext &destination)
+        {
+            destination = encrypted;
+            sub_const_inplace(destination, value);
+        }
+
+        /**
+        Subtracts a signed constant from every slot of a BFV or BGV ciphertext. A negative constant is reduced modulo
+        the plaintext modulus to its non-negative representative.
+
+        @param[in] encrypted The ciphertext to subtract from
+        @param[in] value The constant to subtract
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void sub_const_inplace(Ciphertext &encrypted, std::int64_t value);
+
+        /**
+        Subtracts a constant of any other integral type, such as an int literal, from every slot of a BFV or BGV
+        ciphertext. Signed values are subtracted as std::int64_t and unsigned values as std::uint64_t.
+
+        @param[in] encrypted The ciphertext to subtract from
+        @param[in] value The constant to subtract
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+        inline void sub_const_inplace(Ciphertext &encrypted, T value)
+        {
+            sub_const_inplace(encrypted, static_cast<const_integer_type<T>>(value));
+        }
+
+        /**
+        Subtracts a constant of integral type from every slot of a BFV or BGV ciphertext and stores the result in the
+        destination parameter. Signed values are subtracted as std::int64_t and unsigned values as std::uint64_t.
+
+        @param[in] encrypted The ciphertext to subtract from
+        @param[in] value The constant to subtract
+        @param[out] destination The ciphertext to overwrite with the subtraction result
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+        inline void sub_const(const Ciphertext &encrypted, T value, Ciphertext &destination)
+        {
+            destination = encrypted;
+            sub_const_inplace(destination, static_cast<const_integer_type<T>>(value));
+        }
+
+        /**
+        Subtracts a real constant from every slot of a CKKS ciphertext. The constant is scaled by the scale of
+        encrypted.
+
+        @param[in] encrypted The ciphertext to subtract from
+        @param[in] value The constant to subtract
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is not in NTT form
+        @throws std::invalid_argument if the scaled value is too large for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void sub_const_inplace(Ciphertext &encrypted, double value)
+        {
+            add_const_inplace(encrypted, -value);
+        }
+
+        /**
+        Subtracts a real constant from every slot of a CKKS ciphertext and stores the result in the destination
+        parameter. The constant is scaled by the scale of encrypted.
+
+        @param[in] encrypted The ciphertext to subtract from
+        @param[in] value The constant to subtract
+        @param[out] destination The ciphertext to overwrite with the subtraction result
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is not in NTT form
+        @throws std::invalid_argument if the scaled value is too large for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void sub_const(const Ciphertext &encrypted, double value, Ciphertext &destination)
+        {
+            destination = encrypted;
+            add_const_inplace(destination, -value);
+        }
+
+        /**
+        Multiplies every slot of a BFV or BGV ciphertext by a constant. The constant is reduced modulo the plaintext
+        modulus, and each RNS component of the ciphertext is multiplied by it directly, without encoding a plaintext.
+        Constants in the upper half of the plaintext modulus are applied as negative numbers, so the noise grows by at
+        most a factor of half the plaintext modulus. This works for ciphertexts both in and out of NTT form.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] value The constant to multiply with
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if value is zero modulo the plaintext modulus
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void multiply_const_inplace(Ciphertext &encrypted, std::uint64_t value);
+
+        /**
+        Multiplies every slot of a BFV or BGV ciphertext by a constant and stores the result in the destination
+        parameter. The constant is reduced modulo the plaintext modulus, and each RNS component of the ciphertext is
+        multiplied by it directly, without encoding a plaintext.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] value The constant to multiply with
+        @param[out] destination The ciphertext to overwrite with the multiplication result
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if value is zero modulo the plaintext modulus
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void multiply_const(const Ciphertext &encrypted, std::uint64_t value, Ciphertext &destination)
+        {
+            destination = encrypted;
+            multiply_const_inplace(destination, value);
+        }
+
+        /**
+        Multiplies every slot of a BFV or BGV ciphertext by a signed constant. A negative constant is reduced modulo
+        the plaintext modulus to its non-negative representative.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] value The constant to multiply with
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if value is zero modulo the plaintext modulus
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void multiply_const_inplace(Ciphertext &encrypted, std::int64_t value);
+
+        /**
+        Multiplies every slot of a BFV or BGV ciphertext by a constant of any other integral type, such as an int
+        literal. Signed values are applied as std::int64_t and unsigned values as std::uint64_t.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] value The constant to multiply with
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if value is zero modulo the plaintext modulus
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+        inline void multiply_const_inplace(Ciphertext &encrypted, T value)
+        {
+            multiply_const_inplace(encrypted, static_cast<const_integer_type<T>>(value));
+        }
+
+        /**
+        Multiplies every slot of a BFV or BGV ciphertext by a constant of integral type and stores the result in the
+        destination parameter. Signed values are applied as std::int64_t and unsigned values as std::uint64_t.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] value The constant to multiply with
+        @param[out] destination The ciphertext to overwrite with the multiplication result
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if value is zero modulo the plaintext modulus
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+        inline void multiply_const(const Ciphertext &encrypted, T value, Ciphertext &destination)
+        {
+            destination = encrypted;
+            multiply_const_inplace(destination, static_cast<const_integer_type<T>>(value));
+        }
+
+        /**
+        Multiplies every slot of a CKKS ciphertext by a real constant. The constant is scaled by the given scale,
+        rounded, and each RNS component of the ciphertext is multiplied by it directly, without encoding a plaintext.
+        The result has the product of the two scales, exactly as if the constant had been encoded with the given scale
+        and multiplied with multiply_plain.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] value The constant to multiply with
+        @param[in] scale The scale to encode the constant at
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is not in NTT form
+        @throws std::invalid_argument if the scaled value is too large for the encryption parameters
+        @throws std::invalid_argument if the output scale is too large for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void multiply_const_inplace(Ciphertext &encrypted, double value, double scale);
+
+        /**
+        Multiplies every slot of a CKKS ciphertext by a real constant and stores the result in the destination
+        parameter. The constant is scaled by the given scale, rounded, and each RNS component of the ciphertext is
+        multiplied by it directly, without encoding a plaintext.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] value The constant to multiply with
+        @param[in] scale The scale to encode the constant at
+        @param[out] destination The ciphertext to overwrite with the multiplication result
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is not in NTT form
+        @throws std::invalid_argument if the scaled value is too large for the encryption parameters
+        @throws std::invalid_argument if the output scale is too large for the encryption parameters
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void multiply_const(const Ciphertext &encrypted, double value, double scale, Ciphertext &destination)
+        {
+            destination = encrypted;
+            multiply_const_inplace(destination, value, scale);
+        }
+
+        /**
+        Adds a plaintext to each of several ciphertexts. The plaintext is scaled once, and the ciphertexts are then
+        processed on up to thread_count threads. The result is the same as calling add_plain_inplace on each ciphertext.
+
+        @param[in] encrypteds The ciphertexts to add to
+        @param[in] plain The plaintext to add
+        @param[in] thread_count The maximum number of threads to use
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::invalid_argument if encrypteds or plain is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypteds do not all have the same parameters, NTT form, and scale
+        @throws std::invalid_argument if encrypteds or plain is not in the default NTT form, except that BFV encrypteds
+        may be in NTT form
+        @throws std::invalid_argument if encrypteds and plain are at different level or scale
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void add_plain_batch_inplace(
+            std::vector<Ciphertext> &encrypteds, const Plaintext &plain, std::size_t thread_count = 1)
+        {
+            add_plain_batch_internal(encrypteds, plain, false, thread_count);
+        }
+
+        /**
+        Subtracts a plaintext from each of several ciphertexts. The plaintext is scaled once, and the ciphertexts are
+        then processed on up to thread_count threads. The result is the same as calling sub_plain_inplace on each
+        ciphertext.
+
+        @param[in] encrypteds The ciphertexts to subtract from
+        @param[in] plain The plaintext to subtract
+        @param[in] thread_count The maximum number of threads to use
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::invalid_argument if encrypteds or plain is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypteds do not all have the same parameters, NTT form, and scale
+        @throws std::invalid_argument if encrypteds or plain is not in the default NTT form, except that BFV encrypteds
+        may be in NTT form
+        @throws std::invalid_argument if encrypteds and plain are at different level or scale
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void sub_plain_batch_inplace(
+            std::vector<Ciphertext> &encrypteds, const Plaintext &plain, std::size_t thread_count = 1)
+        {
+            add_plain_batch_internal(encrypteds, plain, true, thread_count);
+        }
+
+        /**
+        Multiplies each of several ciphertexts with a plaintext. A plaintext that is not in NTT form is transformed to
+        NTT form only once, and the ciphertexts are then processed on up to thread_count threads. The result is the
+        same as calling multiply_plain_inplace on each ciphertext.
+
+        @param[in] encrypteds The ciphertexts to multiply
+        @param[in] plain The plaintext to multiply with
+        @param[in] thread_count The maximum number of threads to use
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::invalid_argument if encrypteds or plain is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypteds do not all have the same parameters, NTT form, and scale
+        @throws std::invalid_argument if encrypteds and plain are in different NTT forms, unless encrypteds are BFV
+        ciphertexts
+        @throws std::invalid_argument if the output scale is too large for the encryption parameters
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void multiply_plain_batch_inplace(
+            std::vector<Ciphertext> &encrypteds, const Plaintext &plain, std::size_t thread_count = 1);
+
         /**
         Transforms a plaintext to NTT domain. This functions applies the Number Theoretic Transform to a plaintext by
         first embedding integers modulo the plaintext modulus to integers modulo the coefficient modulus and then
@@ -932,7 +1414,7 @@ namespace seal
         @param[in] steps The number of steps to rotate (negative left, positive right)
         @param[in] galois_keys The Galois keys
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
-        @throws std::logic_error if scheme is not scheme_type::bfv
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
         @throws std::logic_error if the encryption parameters do not support batching
         @throws std::invalid_argument if encrypted or galois_keys is not valid for
         the encryption parameters
@@ -950,7 +1432,8 @@ namespace seal
             Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys,
             MemoryPoolHandle pool = MemoryManager::GetPool())
         {
-            if (context_.key_context_data()->parms().scheme() != scheme_type::bfv)
+            auto scheme = context_.key_context_data()->parms().scheme();
+            if (scheme != scheme_type::bfv && scheme != scheme_type::bgv)
             {
                 throw std::logic_error("unsupported scheme");
             }
@@ -969,7 +1452,7 @@ namespace seal
         @param[in] galois_keys The Galois keys
         @param[out] destination The ciphertext to overwrite with the rotated result
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
-        @throws std::logic_error if scheme is not scheme_type::bfv
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
         @throws std::logic_error if the encryption parameters do not support batching
         @throws std::invalid_argument if encrypted or galois_keys is not valid for
         the encryption parameters
@@ -1001,7 +1484,7 @@ namespace seal
         @param[in] galois_keys The Galois keys
         @param[out] destination The ciphertext to overwrite with the rotated result
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
-        @throws std::logic_error if scheme is not scheme_type::bfv
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
         @throws std::logic_error if the encryption parameters do not support batching
         @throws std::invalid_argument if encrypted or galois_keys is not valid for
         the encryption parameters
@@ -1017,7 +1500,8 @@ namespace seal
         inline void rotate_columns_inplace(
             Ciphertext &encrypted, const GaloisKeys &galois_keys, MemoryPoolHandle pool = MemoryManager::GetPool())
         {
-            if (context_.key_context_data()->parms().scheme() != scheme_type::bfv)
+            auto scheme = context_.key_context_data()->parms().scheme();
+            if (scheme != scheme_type::bfv && scheme != scheme_type::bgv)
             {
                 throw std::logic_error("unsupported scheme");
             }
@@ -1035,7 +1519,7 @@ namespace seal
         @param[in] galois_keys The Galois keys
         @param[out] destination The ciphertext to overwrite with the rotated result
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
-        @throws std::logic_error if scheme is not scheme_type::bfv
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
         @throws std::logic_error if the encryption parameters do not support batching
         @throws std::invalid_argument if encrypted or galois_keys is not valid for
         the encryption parameters
@@ -1124,6 +1608,99 @@ namespace seal
             rotate_vector_inplace(destination, steps, galois_keys, std::move(pool));
         }
 
+        /**
+        Rotates a CKKS ciphertext by several numbers of steps at once and writes the results to the destinations
+        parameter, as if rotate_vector was called for each of them. The first half of key switching, which decomposes
+        the ciphertext and transforms the parts to NTT form, does not depend on the rotation, so it is computed once
+        and shared by all rotations ("hoisting"). This makes all but the first rotation considerably cheaper, which
+        is useful for example in the baby steps of linear transformations. A Galois key must be present for every
+        non-zero number of steps, since the rotations cannot be composed from other rotations. Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The numbers of steps to rotate (negative right, positive left)
+        @param[in] galois_keys The Galois keys
+        @param[out] destinations The ciphertexts to overwrite with the rotated results, one for each number of steps
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for the encryption parameters
+        @throws std::invalid_argument if galois_keys do not correspond to the top level parameters in the current
+        context
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if steps has too big absolute value
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void rotate_vector_hoisted(
+            const Ciphertext &encrypted, const std::vector<int> &steps, const GaloisKeys &galois_keys,
+            std::vector<Ciphertext> &destinations, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Rotates the plaintext matrix rows of each of several ciphertexts cyclically by the same number of steps. The
+        Galois element is computed once, and the ciphertexts are then processed on up to thread_count threads. The
+        result is the same as calling rotate_rows_inplace on each ciphertext.
+
+        @param[in] encrypteds The ciphertexts to rotate
+        @param[in] steps The number of steps to rotate (negative left, positive right)
+        @param[in] galois_keys The Galois keys
+        @param[in] thread_count The maximum number of threads to use
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::invalid_argument if encrypteds or galois_keys is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypteds do not all have the same parameters, NTT form, and scale
+        @throws std::invalid_argument if encrypteds have size larger than 2
+        @throws std::invalid_argument if steps has too big absolute value
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void rotate_rows_batch_inplace(
+            std::vector<Ciphertext> &encrypteds, int steps, const GaloisKeys &galois_keys,
+            std::size_t thread_count = 1)
+        {
+            auto scheme = context_.key_context_data()->parms().scheme();
+            if (scheme != scheme_type::bfv && scheme != scheme_type::bgv)
+            {
+                throw std::logic_error("unsupported scheme");
+            }
+            rotate_batch_internal(encrypteds, steps, galois_keys, thread_count);
+        }
+
+        /**
+        Rotates the plaintext vector of each of several ciphertexts cyclically by the same number of steps. The Galois
+        element is computed once, and the ciphertexts are then processed on up to thread_count threads. The result is
+        the same as calling rotate_vector_inplace on each ciphertext.
+
+        @param[in] encrypteds The ciphertexts to rotate
+        @param[in] steps The number of steps to rotate (negative left, positive right)
+        @param[in] galois_keys The Galois keys
+        @param[in] thread_count The maximum number of threads to use
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::invalid_argument if thread_count is zero
+        @throws std::invalid_argument if encrypteds or galois_keys is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypteds do not all have the same parameters, NTT form, and scale
+        @throws std::invalid_argument if encrypteds are not in the default NTT form
+        @throws std::invalid_argument if encrypteds have size larger than 2
+        @throws std::invalid_argument if steps has too big absolute value
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void rotate_vector_batch_inplace(
+            std::vector<Ciphertext> &encrypteds, int steps, const GaloisKeys &galois_keys,
+            std::size_t thread_count = 1)
+        {
+            if (context_.key_context_data()->parms().scheme() != scheme_type::ckks)
+            {
+                throw std::logic_error("unsupported scheme");
+            }
+            rotate_batch_internal(encrypteds, steps, galois_keys, thread_count);
+        }
+
         /**
         Complex conjugates plaintext slot values. When using the CKKS scheme, this function complex conjugates all
         values in the underlying plaintext. Dynamic memory allocations in the process are allocated from the memory pool
@@ -1198,6 +1775,13 @@ namespace seal
 
         Evaluator &operator=(Evaluator &&assign) = delete;
 
+        // The type that integral constants of type T are handled as
+        template <typename T>
+        using const_integer_type = std::conditional_t<std::is_signed<T>::value, std::int64_t, std::uint64_t>;
+
+        // Reduces a signed constant modulo the plaintext modulus of encrypted
+        SEAL_NODISCARD std::uint64_t reduce_const(const Ciphertext &encrypted, std::int64_t value) const;
+
         void bfv_multiply(Ciphertext &encrypted1, const Ciphertext &encrypted2, MemoryPoolHandle pool);
 
         void ckks_multiply(Ciphertext &encrypted1, const Ciphertext &encrypted2, MemoryPoolHandle pool);
@@ -1206,6 +1790,10 @@ namespace seal
 
         void ckks_square(Ciphertext &encrypted, MemoryPoolHandle pool);
 
+        void bgv_multiply(Ciphertext &encrypted1, const Ciphertext &encrypted2, MemoryPoolHandle pool);
+
+        void bgv_square(Ciphertext &encrypted, MemoryPoolHandle pool);
+
         void relinearize_internal(
             Ciphertext &encrypted, const RelinKeys &relin_keys, std::size_t destination_size, MemoryPoolHandle pool);
 
@@ -1217,6 +1805,17 @@ namespace seal
 
         void rotate_internal(Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, MemoryPoolHandle pool);
 
+        void rotate_batch_internal(
+            std::vector<Ciphertext> &encrypteds, int steps, const GaloisKeys &galois_keys, std::size_t thread_count);
+
+        void add_plain_batch_internal(
+            std::vector<Ciphertext> &encrypteds, const Plaintext &plain, bool subtract, std::size_t thread_count);
+
+        // Checks that encrypteds are valid and share parameters, NTT form, and scale. Returns their context data, or
+        // nullptr if encrypteds is empty.
+        std::shared_ptr<const SEALContext::ContextData> verify_batch(
+            const std::vector<Ciphertext> &encrypteds, std::size_t thread_count) const;
+
         inline void conjugate_internal(Ciphertext &encrypted, const GaloisKeys &galois_keys, MemoryPoolHandle pool)
         {
             // Verify parameters.
@@ -1239,9 +1838,16 @@ namespace seal
             apply_galois_inplace(encrypted, galois_tool->get_elt_from_step(0), galois_keys, std::move(pool));
         }
 
+        // If decomposed_target is given, it holds the key switching decomposition of the target as computed by
+        // rotate_vector_hoisted, and target_iter is not used
         void switch_key_inplace(
             Ciphertext &encrypted, util::ConstRNSIter target_iter, const KSwitchKeys &kswitch_keys,
-            std::size_t key_index, MemoryPoolHandle pool = MemoryManager::GetPool());
+            std::size_t key_index, MemoryPoolHandle pool = MemoryManager::GetPool(),
+            const std::uint64_t *decomposed_target = nullptr);
+
+        void switch_key_inplace(
+            Ciphertext &encrypted, util::ConstRNSIter target_iter, const std::vector<PublicKey> &key_vector,
+            const std::uint64_t *packed_key, MemoryPoolHandle pool, const std::uint64_t *decomposed_target = nullptr);
 
         void multiply_plain_normal(Ciphertext &encrypted, const Plaintext &plain, MemoryPoolHandle pool);
 
@@ -8,6 +8,9 @@
 #include "seal/memorymanager.h"
 #include "seal/util/defines.h"
 #include "seal/util/galois.h"
+#include <functional>
+#include <memory>
+#include <stdexcept>
 #include <vector>
 
 namespace seal
@@ -25,6 +28,13 @@ namespace seal
     scheme Galois keys can enable cyclic vector rotations, as well as a complex
     conjugation operation.
 
+    @par Lazy Loading
+    Galois keys created with a seed store only half of the key data when serialized.
+    Loading them with load_lazy keeps them in this compact form, and each key is
+    expanded only when Evaluator first needs it. A bounded number of expanded keys
+    are cached with least-recently-used eviction. This reduces the resident memory
+    when only some of the keys are used, at the cost of expanding a key again after
+    it has been evicted. While lazily loaded, data() holds only empty placeholders.
 
     @par Thread Safety
     In general, reading from GaloisKeys is thread-safe as long as no other thread is
@@ -59,6 +69,10 @@ namespace seal
         SEAL_NODISCARD inline bool has_key(std::uint32_t galois_elt) const
         {
             std::size_t index = get_index(galois_elt);
+            if (lazy_keys_)
+            {
+                return lazy_keys_->has_key(index);
+            }
             return data().size() > index && !data()[index].empty();
         }
 
@@ -68,10 +82,113 @@ namespace seal
 
         @param[in] galois_elt The Galois element
         @throws std::invalid_argument if the key corresponding to galois_elt does not exist
+        @throws std::logic_error if the GaloisKeys was loaded lazily
         */
         SEAL_NODISCARD inline const auto &key(std::uint32_t galois_elt) const
         {
+            if (lazy_keys_)
+            {
+                throw std::logic_error("GaloisKeys is loaded lazily");
+            }
             return KSwitchKeys::data(get_index(galois_elt));
         }
+
+        /**
+        Returns whether the GaloisKeys was loaded with load_lazy.
+        */
+        SEAL_NODISCARD inline bool is_lazy() const noexcept
+        {
+            return static_cast<bool>(lazy_keys_);
+        }
+
+        /**
+        Returns the number of expanded keys currently cached. For a GaloisKeys that
+        was not loaded lazily this is always zero.
+        */
+        SEAL_NODISCARD inline std::size_t cached_key_count() const
+        {
+            return lazy_keys_ ? lazy_keys_->cached_count() : 0;
+        }
+
+        /**
+        Returns a Galois key from a lazily loaded GaloisKeys, expanding it first if it
+        is not already cached. The returned key remains valid even if it is evicted
+        from the cache.
+
+        @param[in] context The SEALContext
+        @param[in] galois_elt The Galois element
+        @throws std::logic_error if the GaloisKeys was not loaded lazily
+        @throws std::invalid_argument if the key corresponding to galois_elt does not exist
+        @throws std::logic_error if the key data is invalid
+        */
+        SEAL_NODISCARD inline std::shared_ptr<const std::vector<PublicKey>> acquire_key(
+            const SEALContext &context, std::uint32_t galois_elt) const
+        {
+            if (!lazy_keys_)
+            {
+                throw std::logic_error("GaloisKeys is not loaded lazily");
+            }
+            return lazy_keys_->get(context, get_index(galois_elt));
+        }
+
+        /**
+        Loads a GaloisKeys from an input stream overwriting the current GaloisKeys.
+        The keys are kept in serialized form, which for seeded keys is half of the
+        expanded size, and are expanded on first use. At most cache_capacity expanded
+        keys are kept in memory; if cache_capacity is zero, keys are expanded every
+        time they are used. Only the sizes of the keys are checked at this point; the
+        full validity check against the SEALContext happens when a key is expanded.
+
+        @param[in] context The SEALContext
+        @param[in] stream The stream to load the GaloisKeys from
+        @param[in] cache_capacity The maximum number of expanded keys to keep
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::logic_error if the data cannot be loaded by this version of
+        Microsoft SEAL, if the loaded data is invalid, or if decompression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff load_lazy(
+            const SEALContext &context, std::istream &stream, std::size_t cache_capacity = 16)
+        {
+            using namespace std::placeholders;
+            GaloisKeys new_keys;
+            new_keys.pool_ = pool_;
+            auto in_size = Serialization::Load(
+                std::bind(&KSwitchKeys::load_members_lazy, &new_keys, context, _1, cache_capacity), stream);
+            std::swap(*this, new_keys);
+            return in_size;
+        }
+
+        /**
+        Loads a GaloisKeys from a given memory location overwriting the current
+        GaloisKeys. The keys are kept in serialized form, which for seeded keys is
+        half of the expanded size, and are expanded on first use. At most
+        cache_capacity expanded keys are kept in memory; if cache_capacity is zero,
+        keys are expanded every time they are used. Only the sizes of the keys are
+        checked at this point; the full validity check against the SEALContext
+        happens when a key is expanded.
+
+        @param[in] context The SEALContext
+        @param[in] in The memory location to load the GaloisKeys from
+        @param[in] size The number of bytes available in the given memory location
+        @param[in] cache_capacity The maximum number of expanded keys to keep
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if in is null or if size is too small to
+        contain a SEALHeader
+        @throws std::logic_error if the data cannot be loaded by this version of
+        Microsoft SEAL, if the loaded data is invalid, or if decompression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff load_lazy(
+            const SEALContext &context, const seal_byte *in, std::size_t size, std::size_t cache_capacity = 16)
+        {
+            using namespace std::placeholders;
+            GaloisKeys new_keys;
+            new_keys.pool_ = pool_;
+            auto in_size = Serialization::Load(
+                std::bind(&KSwitchKeys::load_members_lazy, &new_keys, context, _1, cache_capacity), in, size);
+            std::swap(*this, new_keys);
+            return in_size;
+        }
     };
 } // namespace seal
@@ -53,7 +53,26 @@ namespace seal
         generate_sk(sk_generated_);
     }
 
-    void KeyGenerator::generate_sk(bool is_initialized)
+    KeyGenerator::KeyGenerator(const SEALContext &context, size_t hamming_weight) : context_(context)
+    {
+        // Verify parameters
+        if (!context_.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+        if (!hamming_weight || hamming_weight > context_.key_context_data()->parms().poly_modulus_degree())
+        {
+            throw invalid_argument("hamming_weight is not valid");
+        }
+
+        // Secret key has not been generated
+        sk_generated_ = false;
+
+        // Generate the secret and public key
+        generate_sk(false, hamming_weight);
+    }
+
+    void KeyGenerator::generate_sk(bool is_initialized, size_t hamming_weight)
     {
         // Extract encryption parameters.
         auto &context_data = *context_.key_context_data();
@@ -71,7 +90,14 @@ namespace seal
 
             // Generate secret key
             RNSIter secret_key(secret_key_.data().data(), coeff_count);
-            sample_poly_ternary(parms.random_generator()->create(), parms, secret_key);
+            if (hamming_weight)
+            {
+                sample_poly_ternary_sparse(parms.random_generator()->create(), parms, hamming_weight, secret_key);
+            }
+            else
+            {
+                sample_poly_ternary(parms.random_generator()->create(), parms, secret_key);
+            }
 
             // Transform the secret s into NTT representation.
             auto ntt_tables = context_data.small_ntt_tables();
@@ -53,6 +53,20 @@ namespace seal
         */
         KeyGenerator(const SEALContext &context, const SecretKey &secret_key);
 
+        /**
+        Creates a KeyGenerator initialized with the specified SEALContext that generates a sparse ternary secret key
+        with exactly hamming_weight nonzero coefficients. Sparse secret keys keep the multiple of the modulus that
+        appears when a ciphertext is decrypted without modular reduction small, which is what CKKS bootstrapping
+        relies on. A small Hamming weight reduces security, which the security level of the encryption parameters
+        does not take into account.
+
+        @param[in] context The SEALContext
+        @param[in] hamming_weight The number of nonzero coefficients in the secret key
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if hamming_weight is zero or larger than the degree of the polynomial modulus
+        */
+        KeyGenerator(const SEALContext &context, std::size_t hamming_weight);
+
         /**
         Returns a const reference to the secret key.
         */
@@ -302,8 +316,10 @@ namespace seal
         @param[in] is_initialized True if the secret key has already been
         initialized so that only the secret_key_array_ should be initialized, for
         example, if the secret key was provided in the constructor
+        @param[in] hamming_weight The number of nonzero coefficients of a sparse
+        secret key, or zero for a uniform ternary secret key
         */
-        void generate_sk(bool is_initialized = false);
+        void generate_sk(bool is_initialized = false, std::size_t hamming_weight = 0);
 
         /**
         Generates new public key matching to existing secret key.
@@ -2,6 +2,11 @@
 // Licensed under the MIT license.
 
 #include "seal/kswitchkeys.h"
+#include "seal/util/common.h"
+#include "seal/util/iterator.h"
+#include "seal/util/uintcore.h"
+#include <algorithm>
+#include <cstdint>
 #include <stdexcept>
 
 using namespace std;
@@ -9,6 +14,11 @@ using namespace seal::util;
 
 namespace seal
 {
+    KSwitchKeys::KSwitchKeys(const KSwitchKeys &copy) : pool_(copy.pool_)
+    {
+        *this = copy;
+    }
+
     KSwitchKeys &KSwitchKeys::operator=(const KSwitchKeys &assign)
     {
         // Check for self-assignment
@@ -20,6 +30,12 @@ namespace seal
         // Copy over fields
         parms_id_ = assign.parms_id_;
 
+        // Lazily loaded and packed keys are immutable apart from the cache, so they can be shared
+        lazy_keys_ = assign.lazy_keys_;
+        packed_keys_ = assign.packed_keys_;
+
+        // Mapped keys are copied to the heap below
+
         // Then copy over keys
         keys_.clear();
         size_t keys_dim1 = assign.keys_.size();
@@ -35,6 +51,7 @@ namespace seal
                 keys_[i][j] = assign.keys_[i][j];
             }
         }
+        mapped_file_.reset();
 
         return *this;
     }
@@ -52,6 +69,14 @@ namespace seal
             // Save the parms_id
             stream.write(reinterpret_cast<const char *>(&parms_id_), sizeof(parms_id_type));
 
+            // Lazily loaded keys are written back in the form they were read in
+            if (lazy_keys_)
+            {
+                lazy_keys_->save_members(stream);
+                stream.exceptions(old_except_mask);
+                return;
+            }
+
             // Save the size of keys_
             stream.write(reinterpret_cast<const char *>(&keys_dim1), sizeof(uint64_t));
 
@@ -141,5 +166,364 @@ namespace seal
         stream.exceptions(old_except_mask);
 
         swap(keys_, new_keys);
+        lazy_keys_.reset();
+        packed_keys_.reset();
+        mapped_file_.reset();
+    }
+
+    void KSwitchKeys::load_members_lazy(const SEALContext &context, istream &stream, size_t cache_capacity)
+    {
+        // Verify parameters
+        if (!context.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+
+        auto new_lazy_keys = make_shared<LazyKeyStore>(cache_capacity, pool_);
+        parms_id_type new_parms_id = parms_id_zero;
+
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on ios_base::badbit and ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            // Read the parms_id; keys must be at the key level
+            stream.read(reinterpret_cast<char *>(&new_parms_id), sizeof(parms_id_type));
+            if (new_parms_id != context.key_parms_id())
+            {
+                throw logic_error("KSwitchKeys data is invalid");
+            }
+
+            new_lazy_keys->load_members(context, stream);
+        }
+        catch (const ios_base::failure &)
+        {
+            stream.exceptions(old_except_mask);
+            throw runtime_error("I/O error");
+        }
+        catch (...)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+        stream.exceptions(old_except_mask);
+
+        // Only empty placeholders; the keys are expanded through lazy_keys_
+        parms_id_ = new_parms_id;
+        keys_.clear();
+        keys_.resize(new_lazy_keys->slot_count());
+        lazy_keys_ = move(new_lazy_keys);
+        packed_keys_.reset();
+        mapped_file_.reset();
+    }
+
+    void KSwitchKeys::pack()
+    {
+        if (lazy_keys_)
+        {
+            throw logic_error("cannot pack lazily loaded keys");
+        }
+
+        // Extra room to align the start of each key to 64 bytes
+        constexpr size_t align_uint64_count = 64 / sizeof(uint64_t);
+
+        auto new_packed_keys = make_shared<vector<PackedKey>>(keys_.size());
+        SEAL_ITERATE(iter(keys_, *new_packed_keys), keys_.size(), [&](auto I) {
+            auto &key_vector = get<0>(I);
+            if (key_vector.empty())
+            {
+                return;
+            }
+
+            auto &first_key = key_vector[0].data();
+            size_t decomp_mod_count = key_vector.size();
+            size_t key_component_count = first_key.size();
+            size_t coeff_count = first_key.poly_modulus_degree();
+            size_t key_modulus_size = first_key.coeff_modulus_size();
+            for (auto &each_key : key_vector)
+            {
+                if (each_key.data().size() != key_component_count ||
+                    each_key.data().poly_modulus_degree() != coeff_count ||
+                    each_key.data().coeff_modulus_size() != key_modulus_size || !is_buffer_valid(each_key))
+                {
+                    throw logic_error("KSwitchKeys data is invalid");
+                }
+            }
+
+            auto &packed_key = get<1>(I);
+            packed_key.allocation = allocate_uint(
+                add_safe(
+                    mul_safe(key_modulus_size, decomp_mod_count, key_component_count, coeff_count),
+                    align_uint64_count),
+                pool_);
+            auto address = reinterpret_cast<uintptr_t>(packed_key.allocation.get());
+            packed_key.data = packed_key.allocation.get() +
+                              ((align_uint64_count - (address / sizeof(uint64_t)) % align_uint64_count) %
+                               align_uint64_count);
+
+            // The order in which Evaluator::switch_key_inplace reads the key
+            uint64_t *dest = packed_key.data;
+            for (size_t rns_index = 0; rns_index < key_modulus_size; rns_index++)
+            {
+                for (auto &each_key : key_vector)
+                {
+                    for (size_t k = 0; k < key_component_count; k++)
+                    {
+                        set_uint(each_key.data().data(k) + rns_index * coeff_count, coeff_count, dest);
+                        dest += coeff_count;
+                    }
+                }
+            }
+        });
+
+        packed_keys_ = move(new_packed_keys);
+    }
+
+    namespace
+    {
+        // "SEALKMAP" in little-endian byte order
+        constexpr uint64_t mapped_keys_magic = 0x50414D4B4C414553ULL;
+
+        constexpr uint64_t mapped_keys_format_version = 1;
+
+        // Key components start at multiples of this in a mapped key file
+        constexpr size_t mapped_keys_alignment = 64;
+
+        struct MappedKeysHeader
+        {
+            uint64_t magic = mapped_keys_magic;
+
+            uint64_t format_version = mapped_keys_format_version;
+
+            parms_id_type parms_id = parms_id_zero;
+
+            uint64_t poly_modulus_degree = 0;
+
+            uint64_t coeff_modulus_size = 0;
+
+            uint64_t key_component_count = 0;
+
+            uint64_t keys_dim1 = 0;
+        };
+
+        SEAL_NODISCARD inline size_t align_mapped_offset(size_t offset)
+        {
+            return mul_safe(
+                add_safe(offset, mapped_keys_alignment - 1) / mapped_keys_alignment, mapped_keys_alignment);
+        }
+    } // namespace
+
+    streamoff KSwitchKeys::save_mapped(ostream &stream) const
+    {
+        if (lazy_keys_)
+        {
+            throw logic_error("cannot save lazily loaded keys in mapped format");
+        }
+
+        // All key components must have the same shape
+        MappedKeysHeader header;
+        header.parms_id = parms_id_;
+        header.keys_dim1 = static_cast<uint64_t>(keys_.size());
+        for (auto &key_dim1 : keys_)
+        {
+            for (auto &key_dim2 : key_dim1)
+            {
+                auto &key = key_dim2.data();
+                if (!header.key_component_count)
+                {
+                    header.poly_modulus_degree = key.poly_modulus_degree();
+                    header.coeff_modulus_size = key.coeff_modulus_size();
+                    header.key_component_count = key.size();
+                }
+                if (key.poly_modulus_degree() != header.poly_modulus_degree ||
+                    key.coeff_modulus_size() != header.coeff_modulus_size ||
+                    key.size() != header.key_component_count || !key.is_ntt_form() || !is_buffer_valid(key))
+                {
+                    throw logic_error("KSwitchKeys data is invalid");
+                }
+            }
+        }
+
+        const char zeros[mapped_keys_alignment]{};
+        size_t offset = 0;
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on ios_base::badbit and ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            stream.write(reinterpret_cast<const char *>(&header), sizeof(MappedKeysHeader));
+            offset += sizeof(MappedKeysHeader);
+            for (auto &key_dim1 : keys_)
+            {
+                uint64_t keys_dim2 = static_cast<uint64_t>(key_dim1.size());
+                stream.write(reinterpret_cast<const char *>(&keys_dim2), sizeof(uint64_t));
+                offset += sizeof(uint64_t);
+            }
+
+            for (auto &key_dim1 : keys_)
+            {
+                for (auto &key_dim2 : key_dim1)
+                {
+                    size_t aligned_offset = align_mapped_offset(offset);
+                    stream.write(zeros, static_cast<streamsize>(aligned_offset - offset));
+
+                    auto &data = key_dim2.data().dyn_array();
+                    size_t data_byte_count = mul_safe(data.size(), sizeof(Ciphertext::ct_coeff_type));
+                    stream.write(reinterpret_cast<const char *>(data.cbegin()), safe_cast<streamsize>(data_byte_count));
+                    offset = add_safe(aligned_offset, data_byte_count);
+                }
+            }
+        }
+        catch (const ios_base::failure &)
+        {
+            stream.exceptions(old_except_mask);
+            throw runtime_error("I/O error");
+        }
+        catch (...)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+        stream.exceptions(old_except_mask);
+
+        return safe_cast<streamoff>(offset);
+    }
+
+    void KSwitchKeys::load_mapped(const SEALContext &context, const string &path)
+    {
+        // Verify parameters
+        if (!context.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+
+        auto mapped_file = make_shared<MappedFile>(path);
+        seal_byte *file_data = mapped_file->data();
+        size_t file_size = mapped_file->size();
+
+        if (file_size < sizeof(MappedKeysHeader))
+        {
+            throw logic_error("mapped key file is invalid");
+        }
+        MappedKeysHeader header;
+        copy_n(file_data, sizeof(MappedKeysHeader), reinterpret_cast<seal_byte *>(&header));
+        if (header.magic != mapped_keys_magic || header.format_version != mapped_keys_format_version)
+        {
+            throw logic_error("mapped key file is invalid");
+        }
+
+        // Check the shape against the key level parameters
+        auto &key_parms = context.key_context_data()->parms();
+        size_t coeff_count = key_parms.poly_modulus_degree();
+        size_t key_modulus_size = key_parms.coeff_modulus().size();
+        size_t decomp_mod_count = context.first_context_data()->parms().coeff_modulus().size();
+        if (header.parms_id != context.key_parms_id() ||
+            (header.keys_dim1 &&
+             (header.poly_modulus_degree != coeff_count || header.coeff_modulus_size != key_modulus_size ||
+              header.key_component_count < SEAL_CIPHERTEXT_SIZE_MIN ||
+              header.key_component_count > SEAL_CIPHERTEXT_SIZE_MAX)) ||
+            header.keys_dim1 > coeff_count)
+        {
+            throw logic_error("mapped key file is invalid");
+        }
+
+        size_t keys_dim1 = static_cast<size_t>(header.keys_dim1);
+        size_t offset = sizeof(MappedKeysHeader);
+        if (file_size < add_safe(offset, mul_safe(keys_dim1, sizeof(uint64_t))))
+        {
+            throw logic_error("mapped key file is invalid");
+        }
+        vector<uint64_t> keys_dim2(keys_dim1);
+        copy_n(file_data + offset, keys_dim1 * sizeof(uint64_t), reinterpret_cast<seal_byte *>(keys_dim2.data()));
+        offset += keys_dim1 * sizeof(uint64_t);
+
+        size_t key_uint64_count =
+            mul_safe(coeff_count, key_modulus_size, safe_cast<size_t>(header.key_component_count));
+        size_t key_byte_count = mul_safe(key_uint64_count, sizeof(uint64_t));
+
+        vector<vector<PublicKey>> new_keys(keys_dim1);
+        for (size_t index = 0; index < keys_dim1; index++)
+        {
+            if (keys_dim2[index] && keys_dim2[index] != decomp_mod_count)
+            {
+                throw logic_error("mapped key file is invalid");
+            }
+
+            new_keys[index].reserve(static_cast<size_t>(keys_dim2[index]));
+            for (size_t j = 0; j < keys_dim2[index]; j++)
+            {
+                offset = align_mapped_offset(offset);
+                if (add_safe(offset, key_byte_count) > file_size)
+                {
+                    throw logic_error("mapped key file is invalid");
+                }
+
+                // Alias the mapped data; nothing is read from the file here
+                PublicKey key(pool_);
+                Ciphertext &ct = key.pk_;
+                ct.parms_id_ = header.parms_id;
+                ct.is_ntt_form_ = true;
+                ct.size_ = static_cast<size_t>(header.key_component_count);
+                ct.poly_modulus_degree_ = coeff_count;
+                ct.coeff_modulus_size_ = key_modulus_size;
+                auto key_data = reinterpret_cast<Ciphertext::ct_coeff_type *>(file_data + offset);
+                ct.data_ = DynArray<Ciphertext::ct_coeff_type>(
+                    Pointer<Ciphertext::ct_coeff_type>::Aliasing(key_data), key_uint64_count, false, pool_);
+                new_keys[index].emplace_back(move(key));
+
+                offset += key_byte_count;
+            }
+        }
+
+        // Validate the metadata before overwriting the current keys
+        KSwitchKeys new_kswitch_keys;
+        new_kswitch_keys.pool_ = pool_;
+        new_kswitch_keys.parms_id_ = header.parms_id;
+        new_kswitch_keys.mapped_file_ = move(mapped_file);
+        new_kswitch_keys.keys_ = move(new_keys);
+        if (!is_metadata_valid_for(new_kswitch_keys, context) || !is_buffer_valid(new_kswitch_keys))
+        {
+            throw logic_error("mapped key file is invalid");
+        }
+
+        swap(parms_id_, new_kswitch_keys.parms_id_);
+        swap(mapped_file_, new_kswitch_keys.mapped_file_);
+        swap(keys_, new_kswitch_keys.keys_);
+        lazy_keys_.reset();
+        packed_keys_.reset();
+    }
+
+    template <typename Advise>
+    void KSwitchKeys::advise_mapped(size_t index, Advise advise) const noexcept
+    {
+        if (!mapped_file_ || index >= keys_.size())
+        {
+            return;
+        }
+
+        auto file_begin = reinterpret_cast<uintptr_t>(mapped_file_->data());
+        auto file_end = file_begin + mapped_file_->size();
+        for (auto &key : keys_[index])
+        {
+            auto &data = key.data().dyn_array();
+            auto key_begin = reinterpret_cast<uintptr_t>(data.cbegin());
+            if (key_begin >= file_begin && key_begin < file_end)
+            {
+                advise(
+                    static_cast<size_t>(key_begin - file_begin), data.size() * sizeof(Ciphertext::ct_coeff_type));
+            }
+        }
+    }
+
+    void KSwitchKeys::prefetch_mapped(size_t index) const noexcept
+    {
+        advise_mapped(index, [this](size_t offset, size_t length) { mapped_file_->prefetch(offset, length); });
+    }
+
+    void KSwitchKeys::evict_mapped(size_t index) const noexcept
+    {
+        advise_mapped(index, [this](size_t offset, size_t length) { mapped_file_->evict(offset, length); });
     }
 } // namespace seal
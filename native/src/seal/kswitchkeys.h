@@ -8,7 +8,11 @@
 #include "seal/publickey.h"
 #include "seal/valcheck.h"
 #include "seal/version.h"
+#include "seal/util/lazykeystore.h"
+#include "seal/util/mappedfile.h"
 #include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace seal
@@ -46,11 +50,13 @@ namespace seal
         KSwitchKeys() = default;
 
         /**
-        Creates a new KSwitchKeys instance by copying a given instance.
+        Creates a new KSwitchKeys instance by copying a given instance. As
+        with copy assignment, memory-mapped keys are copied to the heap and
+        the copy does not refer to the mapped file.
 
         @param[in] copy The KSwitchKeys to copy from
         */
-        KSwitchKeys(const KSwitchKeys &copy) = default;
+        KSwitchKeys(const KSwitchKeys &copy);
 
         /**
         Creates a new KSwitchKeys instance by moving a given instance.
@@ -79,16 +85,27 @@ namespace seal
         */
         SEAL_NODISCARD inline std::size_t size() const noexcept
         {
+            if (lazy_keys_)
+            {
+                std::size_t res = 0;
+                for (std::size_t index = 0; index < lazy_keys_->slot_count(); index++)
+                {
+                    res += lazy_keys_->has_key(index) ? 1 : 0;
+                }
+                return res;
+            }
             return std::accumulate(keys_.cbegin(), keys_.cend(), std::size_t(0), [](std::size_t res, auto &next_key) {
                 return res + (next_key.empty() ? 0 : 1);
             });
         }
 
         /**
-        Returns a reference to the KSwitchKeys data.
+        Returns a reference to the KSwitchKeys data. The keys may be modified through
+        the returned reference, so this releases the packed copy created by pack.
         */
         SEAL_NODISCARD inline auto &data() noexcept
         {
+            packed_keys_.reset();
             return keys_;
         }
 
@@ -101,7 +118,9 @@ namespace seal
         }
 
         /**
-        Returns a reference to a keyswitching key at a given index.
+        Returns a reference to a keyswitching key at a given index. The key may be
+        modified through the returned reference, so this releases the packed copy
+        created by pack.
 
         @param[in] index The index of the keyswitching key
         @throws std::invalid_argument if the key at the given index does not exist
@@ -112,6 +131,7 @@ namespace seal
             {
                 throw std::invalid_argument("keyswitching key does not exist");
             }
+            packed_keys_.reset();
             return keys_[index];
         }
 
@@ -161,22 +181,29 @@ namespace seal
         SEAL_NODISCARD inline std::streamoff save_size(
             compr_mode_type compr_mode = Serialization::compr_mode_default) const
         {
-            std::size_t total_key_size = util::mul_safe(keys_.size(), sizeof(std::uint64_t)); // keys_dim2
-            for (auto &key_dim1 : keys_)
+            std::size_t total_key_size = 0;
+            if (lazy_keys_)
             {
-                for (auto &key_dim2 : key_dim1)
+                // Includes keys_dim1 and all keys_dim2
+                total_key_size = lazy_keys_->save_size();
+            }
+            else
+            {
+                total_key_size = util::add_safe(
+                    sizeof(std::uint64_t),                                // keys_dim1
+                    util::mul_safe(keys_.size(), sizeof(std::uint64_t))); // keys_dim2
+                for (auto &key_dim1 : keys_)
                 {
-                    total_key_size = util::add_safe(
-                        total_key_size, util::safe_cast<std::size_t>(key_dim2.save_size(compr_mode_type::none)));
+                    for (auto &key_dim2 : key_dim1)
+                    {
+                        total_key_size = util::add_safe(
+                            total_key_size, util::safe_cast<std::size_t>(key_dim2.save_size(compr_mode_type::none)));
+                    }
                 }
             }
 
-            std::size_t members_size = Serialization::ComprSizeEstimate(
-                util::add_safe(
-                    sizeof(parms_id_),
-                    sizeof(std::uint64_t), // keys_dim1
-                    total_key_size),
-                compr_mode);
+            std::size_t members_size =
+                Serialization::ComprSizeEstimate(util::add_safe(sizeof(parms_id_), total_key_size), compr_mode);
 
             return util::safe_cast<std::streamoff>(util::add_safe(sizeof(Serialization::SEALHeader), members_size));
         }
@@ -316,6 +343,111 @@ namespace seal
             return in_size;
         }
 
+        /**
+        Creates a copy of the keyswitching keys in a layout that Evaluator can read
+        sequentially. Each key is stored in a single 64-byte aligned buffer, with the
+        components of its decomposition interleaved in the order that keyswitching
+        reads them: for each RNS modulus, for each decomposition component, the
+        polynomials of that component. Evaluator uses the packed copy automatically
+        when it is present.
+
+        The packed copy doubles the memory used by the keys. Non-const access through
+        data() and loading new keys discard the packed copy, so it never goes stale;
+        read the keys through a const reference to keep it.
+
+        @throws std::logic_error if the KSwitchKeys was loaded lazily
+        @throws std::logic_error if the keys are not consistent in size
+        */
+        void pack();
+
+        /**
+        Releases the packed copy of the keyswitching keys created by pack.
+        */
+        inline void unpack() noexcept
+        {
+            packed_keys_.reset();
+        }
+
+        /**
+        Returns whether a packed copy of the keyswitching keys exists.
+        */
+        SEAL_NODISCARD inline bool is_packed() const noexcept
+        {
+            return static_cast<bool>(packed_keys_);
+        }
+
+        /**
+        Returns a pointer to the packed copy of the keyswitching key at a given index,
+        or nullptr if there is no packed copy of it.
+
+        @param[in] index The index of the keyswitching key
+        */
+        SEAL_NODISCARD inline const std::uint64_t *packed_data(std::size_t index) const noexcept
+        {
+            if (!packed_keys_ || index >= packed_keys_->size())
+            {
+                return nullptr;
+            }
+            return (*packed_keys_)[index].data;
+        }
+
+        /**
+        Writes the KSwitchKeys to an output stream in a format that can be memory-mapped
+        with load_mapped. The key data is written uncompressed, in NTT form, and each
+        key component starts at a 64-byte aligned offset. The output stream must have
+        the "binary" flag set.
+
+        @param[out] stream The stream to save the KSwitchKeys to
+        @throws std::logic_error if the KSwitchKeys was loaded lazily
+        @throws std::logic_error if the keys are not consistent in size
+        @throws std::runtime_error if I/O operations failed
+        */
+        std::streamoff save_mapped(std::ostream &stream) const;
+
+        /**
+        Memory-maps a file written by save_mapped and overwrites the current KSwitchKeys
+        with a view of it. No key data is copied: the pages are loaded on first access
+        and are shared with other processes mapping the same file. The file must remain
+        unchanged while mapped. Only the metadata is verified against the given
+        SEALContext, so this function should not be used unless the file comes from a
+        fully trusted source. The key data can be modified through data(); a written page
+        is copied to private memory and the file itself is never changed.
+
+        @param[in] context The SEALContext
+        @param[in] path The path of the file to map
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::logic_error if memory mapping is not supported on this platform
+        @throws std::logic_error if the file is not valid for the encryption parameters
+        @throws std::runtime_error if the file cannot be opened or mapped
+        */
+        void load_mapped(const SEALContext &context, const std::string &path);
+
+        /**
+        Returns whether the KSwitchKeys is a view of a memory-mapped file.
+        */
+        SEAL_NODISCARD inline bool is_mapped() const noexcept
+        {
+            return static_cast<bool>(mapped_file_);
+        }
+
+        /**
+        Hints that the memory-mapped keyswitching key at a given index will be used soon,
+        so its pages can be read ahead. Does nothing if the KSwitchKeys is not mapped.
+
+        @param[in] index The index of the keyswitching key
+        */
+        void prefetch_mapped(std::size_t index) const noexcept;
+
+        /**
+        Releases the memory pages of the memory-mapped keyswitching key at a given index.
+        The key stays usable and is read back from the file when it is next accessed,
+        so any modifications made to it are discarded. Does nothing if the KSwitchKeys
+        is not mapped.
+
+        @param[in] index The index of the keyswitching key
+        */
+        void evict_mapped(std::size_t index) const noexcept;
+
         /**
         Returns the currently used MemoryPoolHandle.
         */
@@ -325,17 +457,48 @@ namespace seal
         }
 
     private:
+        struct PackedKey
+        {
+            util::Pointer<std::uint64_t> allocation;
+
+            // Start of the key data within allocation; 64-byte aligned
+            std::uint64_t *data = nullptr;
+        };
+
         void save_members(std::ostream &stream) const;
 
         void load_members(const SEALContext &context, std::istream &stream, SEALVersion version);
 
+        void load_members_lazy(const SEALContext &context, std::istream &stream, std::size_t cache_capacity);
+
         MemoryPoolHandle pool_ = MemoryManager::GetPool();
 
+        template <typename Advise>
+        void advise_mapped(std::size_t index, Advise advise) const noexcept;
+
         parms_id_type parms_id_ = parms_id_zero;
 
+        /**
+        The memory-mapped file that keys_ points into when loaded with load_mapped.
+        Declared before keys_ so that the mapping outlives the keys.
+        */
+        std::shared_ptr<util::MappedFile> mapped_file_{};
+
         /**
         The vector of keyswitching keys.
         */
         std::vector<std::vector<PublicKey>> keys_{};
+
+        /**
+        The keyswitching keys in serialized form when loaded lazily; keys_ then
+        only holds empty placeholders.
+        */
+        std::shared_ptr<util::LazyKeyStore> lazy_keys_{};
+
+        /**
+        The keyswitching keys in the layout created by pack; immutable once created
+        and therefore shared between copies.
+        */
+        std::shared_ptr<const std::vector<PackedKey>> packed_keys_{};
     };
 } // namespace seal
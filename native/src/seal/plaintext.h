@@ -38,13 +38,13 @@ namespace seal
     the desired capacity to the constructor as an extra argument, or by calling
     the reserve function at any time.
 
-    When the scheme is scheme_type::bfv each coefficient of a plaintext is a 64-bit
-    word, but when the scheme is scheme_type::ckks the plaintext is by default
-    stored in an NTT transformed form with respect to each of the primes in the
-    coefficient modulus. Thus, the size of the allocation that is needed is the
-    size of the coefficient modulus (number of primes) times the degree of the
-    polynomial modulus. In addition, a valid CKKS plaintext also store the parms_id
-    for the corresponding encryption parameters.
+    When the scheme is scheme_type::bfv or scheme_type::bgv each coefficient of
+    a plaintext is a 64-bit word, but when the scheme is scheme_type::ckks the
+    plaintext is by default stored in an NTT transformed form with respect to
+    each of the primes in the coefficient modulus. Thus, the size of the
+    allocation that is needed is the size of the coefficient modulus (number of
+    primes) times the degree of the polynomial modulus. In addition, a valid CKKS
+    plaintext also store the parms_id for the corresponding encryption parameters.
 
     @par Thread Safety
     In general, reading from plaintext is thread-safe as long as no other thread
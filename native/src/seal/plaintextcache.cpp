@@ -0,0 +1,209 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/plaintextcache.h"
+#include "seal/util/common.h"
+#include "seal/util/polycore.h"
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    size_t PlaintextCache::CacheKeyHash::operator()(const CacheKey &key) const noexcept
+    {
+        uint64_t result = static_cast<uint64_t>(hash<parms_id_type>()(key.parms_id));
+        result = 31 * result + key.source_id;
+        result = 31 * result + static_cast<uint64_t>(hash<double>()(key.scale));
+        return static_cast<size_t>(result);
+    }
+
+    PlaintextCache::PlaintextCache(
+        const SEALContext &context, size_t capacity, cache_eviction_policy eviction, MemoryPoolHandle pool)
+        : context_(context), encoder_(context), capacity_(capacity), eviction_(eviction), pool_(move(pool))
+    {
+        if (!pool_)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+        switch (eviction_)
+        {
+        case cache_eviction_policy::lru:
+            /* fall through */
+
+        case cache_eviction_policy::fifo:
+            /* fall through */
+
+        case cache_eviction_policy::none:
+            break;
+
+        default:
+            throw invalid_argument("unsupported eviction policy");
+        }
+    }
+
+    shared_ptr<const Plaintext> PlaintextCache::get_internal(
+        source_id_type source_id, double max_value, parms_id_type parms_id, double scale,
+        const encode_function &encode)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_.get_context_data(parms_id);
+        if (!context_data_ptr || context_data_ptr->chain_index() > context_.first_context_data()->chain_index())
+        {
+            throw invalid_argument("parms_id is not valid for encryption parameters");
+        }
+
+        CacheKey key{ source_id, parms_id, scale };
+
+        // Coefficients of the encoding are bounded in absolute value by scale * max_value, so this many bits
+        // (including the sign bit) are enough at any level
+        int coeff_bit_count = static_cast<int>(ceil(log2(max<>(scale * max_value + 1, 1.0)))) + 1;
+        bool can_derive = coeff_bit_count < context_data_ptr->total_coeff_modulus_bit_count();
+
+        // Look for the plaintext itself or for the nearest level above from which it can be derived
+        shared_ptr<const Plaintext> source;
+        {
+            auto lock = locker_.acquire_write();
+            auto result = find(key);
+            if (result)
+            {
+                return result;
+            }
+            if (can_derive)
+            {
+                for (auto level = context_data_ptr->prev_context_data(); level && !source;
+                     level = level->prev_context_data())
+                {
+                    if (level->chain_index() > context_.first_context_data()->chain_index())
+                    {
+                        break;
+                    }
+                    source = find(CacheKey{ source_id, level->parms_id(), scale });
+                }
+            }
+        }
+
+        if (!can_derive)
+        {
+            auto plain = make_shared<Plaintext>(pool_);
+            encode(parms_id, *plain);
+            return insert(key, move(plain));
+        }
+
+        if (!source)
+        {
+            // Encode at the first level and cache the result for all levels below
+            auto first_parms_id = context_.first_parms_id();
+            auto plain = make_shared<Plaintext>(pool_);
+            encode(first_parms_id, *plain);
+            source = insert(CacheKey{ source_id, first_parms_id, scale }, move(plain));
+            if (parms_id == first_parms_id)
+            {
+                return source;
+            }
+        }
+
+        // Keep the RNS components of the primes that remain at the requested level
+        size_t coeff_count = context_data_ptr->parms().poly_modulus_degree();
+        size_t coeff_modulus_size = context_data_ptr->parms().coeff_modulus().size();
+        auto plain = make_shared<Plaintext>(pool_);
+        plain->resize(mul_safe(coeff_count, coeff_modulus_size));
+        set_poly(source->data(), coeff_count, coeff_modulus_size, plain->data());
+        plain->parms_id() = parms_id;
+        plain->scale() = scale;
+        return insert(key, move(plain));
+    }
+
+    shared_ptr<const Plaintext> PlaintextCache::find(const CacheKey &key)
+    {
+        auto it = entries_.find(key);
+        if (it == entries_.end())
+        {
+            return nullptr;
+        }
+        if (eviction_ == cache_eviction_policy::lru)
+        {
+            order_.splice(order_.begin(), order_, it->second.second);
+        }
+        return it->second.first;
+    }
+
+    shared_ptr<const Plaintext> PlaintextCache::insert(const CacheKey &key, shared_ptr<const Plaintext> plain)
+    {
+        size_t plain_size = mul_safe(plain->coeff_count(), sizeof(Plaintext::pt_coeff_type));
+        if (plain_size > capacity_)
+        {
+            return plain;
+        }
+
+        auto lock = locker_.acquire_write();
+
+        // Another thread may have added the same plaintext concurrently
+        auto result = find(key);
+        if (result)
+        {
+            return result;
+        }
+
+        if (size_ + plain_size > capacity_)
+        {
+            if (eviction_ == cache_eviction_policy::none)
+            {
+                return plain;
+            }
+            while (size_ + plain_size > capacity_)
+            {
+                erase_entry(prev(order_.end()));
+            }
+        }
+
+        order_.push_front(key);
+        entries_.emplace(key, make_pair(plain, order_.begin()));
+        size_ += plain_size;
+        return plain;
+    }
+
+    void PlaintextCache::erase_entry(list<CacheKey>::iterator order_it)
+    {
+        auto it = entries_.find(*order_it);
+        size_ -= it->second.first->coeff_count() * sizeof(Plaintext::pt_coeff_type);
+        entries_.erase(it);
+        order_.erase(order_it);
+    }
+
+    void PlaintextCache::erase(source_id_type source_id)
+    {
+        auto lock = locker_.acquire_write();
+        for (auto it = order_.begin(); it != order_.end();)
+        {
+            auto next_it = next(it);
+            if (it->source_id == source_id)
+            {
+                erase_entry(it);
+            }
+            it = next_it;
+        }
+    }
+
+    void PlaintextCache::clear()
+    {
+        auto lock = locker_.acquire_write();
+        entries_.clear();
+        order_.clear();
+        size_ = 0;
+    }
+
+    size_t PlaintextCache::size() const
+    {
+        auto lock = locker_.acquire_read();
+        return size_;
+    }
+
+    size_t PlaintextCache::entry_count() const
+    {
+        auto lock = locker_.acquire_read();
+        return entries_.size();
+    }
+} // namespace seal
@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/ckks.h"
+#include "seal/context.h"
+#include "seal/encryptionparams.h"
+#include "seal/memorymanager.h"
+#include "seal/plaintext.h"
+#include "seal/util/defines.h"
+#include "seal/util/locks.h"
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace seal
+{
+    /**
+    Determines which entries a PlaintextCache removes when a new plaintext does not fit.
+    */
+    enum class cache_eviction_policy : std::uint8_t
+    {
+        // Removes the entries that were requested least recently
+        lru = 0x0,
+
+        // Removes the entries that were added first
+        fifo = 0x1,
+
+        // Keeps all entries and does not cache the new plaintext
+        none = 0x2
+    };
+
+    /**
+    Caches CKKS plaintexts of vectors that are encoded repeatedly, such as constants and model weights, at the levels
+    and scales they are requested at. Each vector is identified by a source id chosen by the caller, which must
+    change whenever the contents of the vector change.
+
+    @par Levels
+    A plaintext in NTT form at a lower level holds a prefix of the RNS components of the same plaintext at a higher
+    level, so when a plaintext is missing it is derived from a cached plaintext at a higher level by dropping RNS
+    components, as Evaluator::mod_switch_to_inplace does, rather than encoded again. When no such plaintext is
+    cached, the vector is encoded once at the first level, the first level plaintext is cached as well, and the
+    requested level is derived from it. A lower level can hold only smaller coefficients; when the size of the
+    values and the scale do not guarantee that the coefficients fit in the requested level, the vector is instead
+    encoded at that level directly, which fails exactly when encode fails.
+
+    @par Memory
+    The cache holds at most capacity bytes of plaintext data. When a new plaintext does not fit, entries are removed
+    according to the cache_eviction_policy. Plaintexts are returned as shared pointers, so removing an entry never
+    invalidates a plaintext that is still in use.
+
+    @par Thread Safety
+    All member functions are thread-safe. Vectors are encoded without holding the lock, so two threads that miss the
+    same entry at the same time may both encode it.
+    */
+    class PlaintextCache
+    {
+    public:
+        /**
+        Identifies a source vector.
+        */
+        using source_id_type = std::uint64_t;
+
+        /**
+        Creates an empty PlaintextCache for the specified SEALContext.
+
+        @param[in] context The SEALContext
+        @param[in] capacity The maximum number of bytes of plaintext data to keep
+        @param[in] eviction The policy to use when a new plaintext does not fit
+        @param[in] pool The MemoryPoolHandle to allocate the plaintexts from
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if scheme is not scheme_type::ckks
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        PlaintextCache(
+            const SEALContext &context, std::size_t capacity,
+            cache_eviction_policy eviction = cache_eviction_policy::lru,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Returns the plaintext encoding a vector of real or complex numbers at the given level and scale, encoding or
+        deriving it first if it is not cached. The result is the same as calling CKKSEncoder::encode with the same
+        arguments.
+
+        @tparam T Vector value type (double or std::complex<double>)
+        @param[in] source_id The id of the vector
+        @param[in] values The vector, which is only read if the plaintext is not cached
+        @param[in] parms_id The parms_id of the level of the plaintext
+        @param[in] scale The scale of the plaintext
+        @throws std::invalid_argument if values has invalid size
+        @throws std::invalid_argument if parms_id is not valid for the encryption parameters or is at a key level
+        @throws std::invalid_argument if scale is not strictly positive or too large
+        @throws std::invalid_argument if the encoding is too large for the encryption parameters
+        */
+        template <
+            typename T, typename = std::enable_if_t<
+                            std::is_same<std::remove_cv_t<T>, double>::value ||
+                            std::is_same<std::remove_cv_t<T>, std::complex<double>>::value>>
+        SEAL_NODISCARD std::shared_ptr<const Plaintext> get(
+            source_id_type source_id, const std::vector<T> &values, parms_id_type parms_id, double scale)
+        {
+            double max_value = 0;
+            for (auto &value : values)
+            {
+                max_value = std::max<>(max_value, std::abs(value));
+            }
+            return get_internal(
+                source_id, max_value, parms_id, scale, [&](parms_id_type encode_parms_id, Plaintext &destination) {
+                    encoder_.encode(values, encode_parms_id, scale, destination, pool_);
+                });
+        }
+
+        /**
+        Removes all cached plaintexts of a source vector, for example after its contents have changed.
+
+        @param[in] source_id The id of the vector
+        */
+        void erase(source_id_type source_id);
+
+        /**
+        Removes all cached plaintexts.
+        */
+        void clear();
+
+        /**
+        Returns the maximum number of bytes of plaintext data kept in the cache.
+        */
+        SEAL_NODISCARD inline std::size_t capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        /**
+        Returns the eviction policy.
+        */
+        SEAL_NODISCARD inline cache_eviction_policy eviction() const noexcept
+        {
+            return eviction_;
+        }
+
+        /**
+        Returns the number of bytes of plaintext data currently in the cache.
+        */
+        SEAL_NODISCARD std::size_t size() const;
+
+        /**
+        Returns the number of plaintexts currently in the cache.
+        */
+        SEAL_NODISCARD std::size_t entry_count() const;
+
+    private:
+        PlaintextCache(const PlaintextCache &copy) = delete;
+
+        PlaintextCache &operator=(const PlaintextCache &assign) = delete;
+
+        struct CacheKey
+        {
+            source_id_type source_id;
+
+            parms_id_type parms_id;
+
+            double scale;
+
+            SEAL_NODISCARD inline bool operator==(const CacheKey &compare) const noexcept
+            {
+                return source_id == compare.source_id && parms_id == compare.parms_id && scale == compare.scale;
+            }
+        };
+
+        struct CacheKeyHash
+        {
+            SEAL_NODISCARD std::size_t operator()(const CacheKey &key) const noexcept;
+        };
+
+        using encode_function = std::function<void(parms_id_type, Plaintext &)>;
+
+        std::shared_ptr<const Plaintext> get_internal(
+            source_id_type source_id, double max_value, parms_id_type parms_id, double scale,
+            const encode_function &encode);
+
+        // Returns the cached plaintext, or nullptr, and marks it as used; must be called with the lock held
+        std::shared_ptr<const Plaintext> find(const CacheKey &key);
+
+        // Adds a plaintext, evicting entries as needed, and returns the cached plaintext if another thread added the
+        // same key in the meantime
+        std::shared_ptr<const Plaintext> insert(const CacheKey &key, std::shared_ptr<const Plaintext> plain);
+
+        void erase_entry(std::list<CacheKey>::iterator order_it);
+
+        SEALContext context_;
+
+        CKKSEncoder encoder_;
+
+        std::size_t capacity_;
+
+        cache_eviction_policy eviction_;
+
+        MemoryPoolHandle pool_;
+
+        mutable util::ReaderWriterLocker locker_;
+
+        std::size_t size_ = 0;
+
+        // The next entry to evict is at the back
+        std::list<CacheKey> order_{};
+
+        std::unordered_map<
+            CacheKey, std::pair<std::shared_ptr<const Plaintext>, std::list<CacheKey>::iterator>, CacheKeyHash>
+            entries_{};
+    };
+} // namespace seal
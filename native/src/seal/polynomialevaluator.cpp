@@ -0,0 +1,553 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/polynomialevaluator.h"
+#include "seal/util/common.h"
+#include "seal/util/uintarithsmallmod.h"
+#include "seal/util/uintcore.h"
+#include "seal/valcheck.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    namespace
+    {
+        // Number of ciphertext multiplications in the recursive splitting of a dense polynomial
+        size_t split_multiplication_count(size_t degree, size_t baby_step_count)
+        {
+            if (degree < baby_step_count)
+            {
+                return 0;
+            }
+            size_t giant_step = baby_step_count;
+            while ((giant_step << 1) <= degree)
+            {
+                giant_step <<= 1;
+            }
+            size_t quotient_degree = degree - giant_step;
+            return (quotient_degree ? 1 : 0) + split_multiplication_count(quotient_degree, baby_step_count) +
+                   split_multiplication_count(giant_step - 1, baby_step_count);
+        }
+
+        // Index of the largest giant step that does not exceed the degree
+        size_t giant_step_index(size_t degree, size_t baby_step_count)
+        {
+            size_t giant_index = 0;
+            while ((baby_step_count << (giant_index + 1)) <= degree)
+            {
+                giant_index++;
+            }
+            return giant_index;
+        }
+    } // namespace
+
+    template <typename T>
+    struct PolynomialEvaluator::Term
+    {
+        // Constants stay unencrypted until they are combined with a ciphertext
+        bool is_constant = true;
+
+        T constant{};
+
+        Ciphertext encrypted{};
+    };
+
+    PolynomialEvaluator::PolynomialEvaluator(const SEALContext &context) : context_(context), evaluator_(context)
+    {
+        // Verify parameters
+        if (!context_.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+
+        switch (context_.first_context_data()->parms().scheme())
+        {
+        case scheme_type::bfv:
+            /* fall through */
+
+        case scheme_type::bgv:
+            break;
+
+        case scheme_type::ckks:
+            is_ckks_ = true;
+            break;
+
+        default:
+            throw invalid_argument("unsupported scheme");
+        }
+    }
+
+    void PolynomialEvaluator::evaluate(
+        const Ciphertext &encrypted, const vector<double> &coeffs, poly_basis_type basis, const RelinKeys &relin_keys,
+        Ciphertext &destination, MemoryPoolHandle pool)
+    {
+        if (!is_ckks_)
+        {
+            throw logic_error("unsupported scheme");
+        }
+        evaluate_internal(encrypted, coeffs, basis, relin_keys, destination, move(pool));
+    }
+
+    void PolynomialEvaluator::evaluate(
+        const Ciphertext &encrypted, const vector<int64_t> &coeffs, poly_basis_type basis, const RelinKeys &relin_keys,
+        Ciphertext &destination, MemoryPoolHandle pool)
+    {
+        auto &parms = context_.first_context_data()->parms();
+        if (parms.scheme() != scheme_type::bfv && parms.scheme() != scheme_type::bgv)
+        {
+            throw logic_error("unsupported scheme");
+        }
+
+        // Reduce the coefficients modulo the plaintext modulus
+        auto &plain_modulus = parms.plain_modulus();
+        vector<uint64_t> reduced_coeffs;
+        reduced_coeffs.reserve(coeffs.size());
+        for (auto coeff : coeffs)
+        {
+            if (coeff < 0)
+            {
+                uint64_t abs_coeff = static_cast<uint64_t>(-(coeff + 1)) + 1;
+                reduced_coeffs.push_back(negate_uint_mod(barrett_reduce_64(abs_coeff, plain_modulus), plain_modulus));
+            }
+            else
+            {
+                reduced_coeffs.push_back(barrett_reduce_64(static_cast<uint64_t>(coeff), plain_modulus));
+            }
+        }
+        evaluate_internal(encrypted, move(reduced_coeffs), basis, relin_keys, destination, move(pool));
+    }
+
+    size_t PolynomialEvaluator::MultiplicationCount(size_t degree)
+    {
+        if (degree < 1)
+        {
+            throw invalid_argument("polynomial degree must be at least 1");
+        }
+
+        size_t baby_step_count = BabyStepCount(degree);
+        size_t count = min(baby_step_count, degree) - 1;
+        for (size_t giant_step = baby_step_count << 1; giant_step <= degree; giant_step <<= 1)
+        {
+            count++;
+        }
+        return count + split_multiplication_count(degree, baby_step_count);
+    }
+
+    size_t PolynomialEvaluator::BabyStepCount(size_t degree) noexcept
+    {
+        // Smallest power of two that is at least sqrt(degree + 1)
+        size_t baby_step_count = 1;
+        while (baby_step_count * baby_step_count < degree + 1)
+        {
+            baby_step_count <<= 1;
+        }
+        return baby_step_count;
+    }
+
+    template <typename T>
+    void PolynomialEvaluator::evaluate_internal(
+        const Ciphertext &encrypted, vector<T> coeffs, poly_basis_type basis, const RelinKeys &relin_keys,
+        Ciphertext &destination, MemoryPoolHandle pool)
+    {
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (basis != poly_basis_type::power && basis != poly_basis_type::chebyshev)
+        {
+            throw invalid_argument("unsupported basis");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        scale_ = encrypted.scale();
+        while (!coeffs.empty() && is_zero(coeffs.back()))
+        {
+            coeffs.pop_back();
+        }
+        if (coeffs.size() < 2)
+        {
+            throw invalid_argument("polynomial degree must be at least 1");
+        }
+        size_t degree = coeffs.size() - 1;
+        size_t baby_step_count = BabyStepCount(degree);
+
+        // baby_steps[i] holds x^(i + 1), or T_(i + 1)(x) in the Chebyshev basis. The last one is only needed as the
+        // first giant step, so it is not computed if there are no giant steps.
+        vector<Ciphertext> baby_steps{ encrypted };
+        for (size_t i = 2; i <= min(baby_step_count, degree); i++)
+        {
+            // Split i = a + b with a the largest power of two below i; this keeps the depth at ceil(log2(i))
+            size_t a = size_t(1) << (get_significant_bit_count(static_cast<uint64_t>(i - 1)) - 1);
+            size_t b = i - a;
+
+            Ciphertext step(pool);
+            if (basis == poly_basis_type::power)
+            {
+                multiply_relin(baby_steps[a - 1], baby_steps[b - 1], relin_keys, step, pool);
+                rescale(step, pool);
+            }
+            else
+            {
+                // T_(a + b) = 2 T_a T_b - T_(a - b)
+                chebyshev_product(
+                    baby_steps[a - 1], baby_steps[b - 1], a == b ? nullptr : &baby_steps[a - b - 1], relin_keys, step,
+                    pool);
+            }
+            baby_steps.emplace_back(move(step));
+        }
+
+        // giant_steps[j] holds x^(k 2^j), or T_(k 2^j)(x) in the Chebyshev basis, where k is baby_step_count
+        vector<Ciphertext> giant_steps;
+        if (degree >= baby_step_count)
+        {
+            giant_steps.push_back(baby_steps.back());
+            while ((baby_step_count << giant_steps.size()) <= degree)
+            {
+                Ciphertext step(pool);
+                if (basis == poly_basis_type::power)
+                {
+                    multiply_relin(giant_steps.back(), giant_steps.back(), relin_keys, step, pool);
+                    rescale(step, pool);
+                }
+                else
+                {
+                    // T_(2n) = 2 T_n^2 - 1
+                    chebyshev_product(giant_steps.back(), giant_steps.back(), nullptr, relin_keys, step, pool);
+                }
+                giant_steps.emplace_back(move(step));
+            }
+        }
+
+        auto result =
+            evaluate_recursive(coeffs, basis, baby_steps, giant_steps, baby_step_count, scale_, relin_keys, pool);
+        if (result.is_constant)
+        {
+            // Only possible when leading coefficients vanish modulo an even plaintext modulus
+            throw invalid_argument("polynomial is constant modulo the plaintext modulus");
+        }
+        destination = move(result.encrypted);
+    }
+
+    template <typename T>
+    PolynomialEvaluator::Term<T> PolynomialEvaluator::evaluate_recursive(
+        const vector<T> &coeffs, poly_basis_type basis, const vector<Ciphertext> &baby_steps,
+        const vector<Ciphertext> &giant_steps, size_t baby_step_count, double target_scale,
+        const RelinKeys &relin_keys, MemoryPoolHandle pool)
+    {
+        size_t degree = coeffs.size() - 1;
+        if (degree < baby_step_count)
+        {
+            return linear_combination(coeffs, baby_steps, target_scale, pool);
+        }
+
+        size_t giant_index = giant_step_index(degree, baby_step_count);
+        auto &giant_step = giant_steps[giant_index];
+        vector<T> quotient;
+        vector<T> remainder;
+        split(coeffs, basis, baby_step_count << giant_index, quotient, remainder);
+
+        // The quotient is evaluated at the scale that brings its product with the giant step to target_scale. The
+        // product is rescaled at the lower of the two levels.
+        double quotient_scale = target_scale;
+        if (is_ckks_)
+        {
+            auto quotient_level = output_level(quotient, basis, baby_steps, giant_steps, baby_step_count);
+            auto product_level = context_.get_context_data(giant_step.parms_id());
+            if (quotient_level && quotient_level->chain_index() < product_level->chain_index())
+            {
+                product_level = quotient_level;
+            }
+            quotient_scale = product_scale(*product_level, target_scale) / giant_step.scale();
+        }
+        auto quotient_term = evaluate_recursive(
+            quotient, basis, baby_steps, giant_steps, baby_step_count, quotient_scale, relin_keys, pool);
+        auto remainder_term = evaluate_recursive(
+            remainder, basis, baby_steps, giant_steps, baby_step_count, target_scale, relin_keys, pool);
+
+        if (quotient_term.is_constant && is_zero(quotient_term.constant))
+        {
+            return remainder_term;
+        }
+
+        Term<T> result;
+        result.is_constant = false;
+        if (quotient_term.is_constant)
+        {
+            result.encrypted = giant_step;
+            multiply_const_inplace(result.encrypted, quotient_term.constant, quotient_scale);
+        }
+        else
+        {
+            multiply_relin(quotient_term.encrypted, giant_step, relin_keys, result.encrypted, pool);
+        }
+        rescale(result.encrypted, pool);
+
+        if (!remainder_term.is_constant)
+        {
+            match_level(result.encrypted, remainder_term.encrypted, pool);
+            evaluator_.add_inplace(result.encrypted, remainder_term.encrypted);
+        }
+        else if (!is_zero(remainder_term.constant))
+        {
+            add_const_inplace(result.encrypted, remainder_term.constant);
+        }
+        return result;
+    }
+
+    template <typename T>
+    PolynomialEvaluator::Term<T> PolynomialEvaluator::linear_combination(
+        const vector<T> &coeffs, const vector<Ciphertext> &baby_steps, double target_scale, MemoryPoolHandle pool)
+    {
+        Term<T> result;
+        result.constant = coeffs[0];
+
+        // All terms are brought to the lowest level among the baby steps used
+        auto lowest = lowest_baby_step(coeffs, baby_steps);
+        if (!lowest)
+        {
+            return result;
+        }
+        auto parms_id = lowest->parms_id();
+
+        // Each coefficient is encoded at the scale that brings the product with its baby step to the same scale,
+        // which the single rescaling then brings to target_scale
+        double terms_scale = is_ckks_ ? product_scale(*context_.get_context_data(parms_id), target_scale) : 1.0;
+        for (size_t i = 1; i < coeffs.size(); i++)
+        {
+            if (is_zero(coeffs[i]))
+            {
+                continue;
+            }
+            Ciphertext term(baby_steps[i - 1], pool);
+            if (term.parms_id() != parms_id)
+            {
+                evaluator_.mod_switch_to_inplace(term, parms_id, pool);
+            }
+            multiply_const_inplace(term, coeffs[i], terms_scale / term.scale());
+            if (result.is_constant)
+            {
+                result.encrypted = move(term);
+                result.is_constant = false;
+            }
+            else
+            {
+                evaluator_.add_inplace(result.encrypted, term);
+            }
+        }
+
+        // With CKKS the constant is added at the scale of the products, before the single rescaling
+        if (!is_zero(result.constant))
+        {
+            add_const_inplace(result.encrypted, result.constant);
+        }
+        rescale(result.encrypted, pool);
+        return result;
+    }
+
+    template <typename T>
+    shared_ptr<const SEALContext::ContextData> PolynomialEvaluator::output_level(
+        const vector<T> &coeffs, poly_basis_type basis, const vector<Ciphertext> &baby_steps,
+        const vector<Ciphertext> &giant_steps, size_t baby_step_count) const
+    {
+        // Mirrors evaluate_recursive and linear_combination
+        size_t degree = coeffs.size() - 1;
+        if (degree < baby_step_count)
+        {
+            auto lowest = lowest_baby_step(coeffs, baby_steps);
+            return lowest ? context_.get_context_data(lowest->parms_id())->next_context_data() : nullptr;
+        }
+
+        size_t giant_index = giant_step_index(degree, baby_step_count);
+        vector<T> quotient;
+        vector<T> remainder;
+        split(coeffs, basis, baby_step_count << giant_index, quotient, remainder);
+
+        auto quotient_level = output_level(quotient, basis, baby_steps, giant_steps, baby_step_count);
+        auto remainder_level = output_level(remainder, basis, baby_steps, giant_steps, baby_step_count);
+        if (!quotient_level && is_zero(quotient[0]))
+        {
+            return remainder_level;
+        }
+
+        auto level = context_.get_context_data(giant_steps[giant_index].parms_id());
+        if (quotient_level && quotient_level->chain_index() < level->chain_index())
+        {
+            level = quotient_level;
+        }
+        level = level->next_context_data();
+        if (remainder_level && remainder_level->chain_index() < level->chain_index())
+        {
+            level = remainder_level;
+        }
+        return level;
+    }
+
+    template <typename T>
+    void PolynomialEvaluator::split(
+        const vector<T> &coeffs, poly_basis_type basis, size_t giant_step, vector<T> &quotient,
+        vector<T> &remainder) const
+    {
+        size_t degree = coeffs.size() - 1;
+        remainder.assign(coeffs.cbegin(), coeffs.cbegin() + static_cast<ptrdiff_t>(giant_step));
+        if (basis == poly_basis_type::power)
+        {
+            quotient.assign(coeffs.cbegin() + static_cast<ptrdiff_t>(giant_step), coeffs.cend());
+        }
+        else
+        {
+            // T_(m + j) = 2 T_j T_m - T_(m - j) for 0 < j < m
+            quotient.resize(degree - giant_step + 1);
+            quotient[0] = coeffs[giant_step];
+            for (size_t i = giant_step + 1; i <= degree; i++)
+            {
+                quotient[i - giant_step] = add_coeff(coeffs[i], coeffs[i]);
+                remainder[2 * giant_step - i] = sub_coeff(remainder[2 * giant_step - i], coeffs[i]);
+            }
+        }
+        for (auto part : { &quotient, &remainder })
+        {
+            while (part->size() > 1 && is_zero(part->back()))
+            {
+                part->pop_back();
+            }
+        }
+    }
+
+    template <typename T>
+    const Ciphertext *PolynomialEvaluator::lowest_baby_step(
+        const vector<T> &coeffs, const vector<Ciphertext> &baby_steps) const
+    {
+        const Ciphertext *lowest = nullptr;
+        size_t lowest_chain_index = 0;
+        for (size_t i = 1; i < coeffs.size(); i++)
+        {
+            if (is_zero(coeffs[i]))
+            {
+                continue;
+            }
+            size_t chain_index = context_.get_context_data(baby_steps[i - 1].parms_id())->chain_index();
+            if (!lowest || chain_index < lowest_chain_index)
+            {
+                lowest = &baby_steps[i - 1];
+                lowest_chain_index = chain_index;
+            }
+        }
+        return lowest;
+    }
+
+    void PolynomialEvaluator::multiply_relin(
+        const Ciphertext &encrypted1, const Ciphertext &encrypted2, const RelinKeys &relin_keys,
+        Ciphertext &destination, MemoryPoolHandle pool)
+    {
+        destination = encrypted1;
+        if (&encrypted1 == &encrypted2)
+        {
+            evaluator_.square_inplace(destination, pool);
+        }
+        else if (encrypted1.parms_id() == encrypted2.parms_id())
+        {
+            evaluator_.multiply_inplace(destination, encrypted2, pool);
+        }
+        else
+        {
+            Ciphertext operand(encrypted2, pool);
+            match_level(destination, operand, pool);
+            evaluator_.multiply_inplace(destination, operand, pool);
+        }
+        evaluator_.relinearize_inplace(destination, relin_keys, pool);
+    }
+
+    void PolynomialEvaluator::chebyshev_product(
+        const Ciphertext &encrypted1, const Ciphertext &encrypted2, const Ciphertext *encrypted3,
+        const RelinKeys &relin_keys, Ciphertext &destination, MemoryPoolHandle pool)
+    {
+        multiply_relin(encrypted1, encrypted2, relin_keys, destination, pool);
+        evaluator_.add_inplace(destination, destination);
+        if (encrypted3)
+        {
+            Ciphertext operand(*encrypted3, pool);
+            match_level(destination, operand, pool);
+            if (is_ckks_)
+            {
+                // Bring the operand to the scale of the product, so that both are rescaled together
+                evaluator_.multiply_const_inplace(operand, 1.0, destination.scale() / operand.scale());
+            }
+            evaluator_.sub_inplace(destination, operand);
+        }
+        else if (is_ckks_)
+        {
+            add_const_inplace(destination, -1.0);
+        }
+        else
+        {
+            add_const_inplace(destination, context_.first_context_data()->parms().plain_modulus().value() - 1);
+        }
+        rescale(destination, pool);
+    }
+
+    void PolynomialEvaluator::match_level(Ciphertext &encrypted1, Ciphertext &encrypted2, MemoryPoolHandle pool)
+    {
+        size_t chain_index1 = context_.get_context_data(encrypted1.parms_id())->chain_index();
+        size_t chain_index2 = context_.get_context_data(encrypted2.parms_id())->chain_index();
+        if (chain_index1 > chain_index2)
+        {
+            evaluator_.mod_switch_to_inplace(encrypted1, encrypted2.parms_id(), pool);
+        }
+        else if (chain_index2 > chain_index1)
+        {
+            evaluator_.mod_switch_to_inplace(encrypted2, encrypted1.parms_id(), pool);
+        }
+    }
+
+    void PolynomialEvaluator::rescale(Ciphertext &encrypted, MemoryPoolHandle pool)
+    {
+        if (is_ckks_)
+        {
+            evaluator_.rescale_to_next_inplace(encrypted, pool);
+        }
+    }
+
+    double PolynomialEvaluator::product_scale(const SEALContext::ContextData &context_data, double target_scale) const
+    {
+        return target_scale * static_cast<double>(context_data.parms().coeff_modulus().back().value());
+    }
+
+    void PolynomialEvaluator::multiply_const_inplace(Ciphertext &encrypted, double value, double scale)
+    {
+        evaluator_.multiply_const_inplace(encrypted, value, scale);
+    }
+
+    void PolynomialEvaluator::multiply_const_inplace(Ciphertext &encrypted, uint64_t value, double)
+    {
+        evaluator_.multiply_const_inplace(encrypted, value);
+    }
+
+    void PolynomialEvaluator::add_const_inplace(Ciphertext &encrypted, double value)
+    {
+        evaluator_.add_const_inplace(encrypted, value);
+    }
+
+    void PolynomialEvaluator::add_const_inplace(Ciphertext &encrypted, uint64_t value)
+    {
+        evaluator_.add_const_inplace(encrypted, value);
+    }
+
+    uint64_t PolynomialEvaluator::add_coeff(uint64_t a, uint64_t b) const noexcept
+    {
+        return add_uint_mod(a, b, context_.first_context_data()->parms().plain_modulus());
+    }
+
+    uint64_t PolynomialEvaluator::sub_coeff(uint64_t a, uint64_t b) const noexcept
+    {
+        return sub_uint_mod(a, b, context_.first_context_data()->parms().plain_modulus());
+    }
+} // namespace seal
@@ -0,0 +1,238 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/ciphertext.h"
+#include "seal/context.h"
+#include "seal/evaluator.h"
+#include "seal/memorymanager.h"
+#include "seal/plaintext.h"
+#include "seal/relinkeys.h"
+#include "seal/util/defines.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace seal
+{
+    /**
+    Describes the basis in which the coefficients of a polynomial are given.
+    */
+    enum class poly_basis_type : std::uint8_t
+    {
+        // Coefficients of the monomials 1, x, x^2, ...
+        power = 0x0,
+
+        // Coefficients of the Chebyshev polynomials of the first kind T_0(x), T_1(x), T_2(x), ...
+        chebyshev = 0x1
+    };
+
+    /**
+    Evaluates polynomials on encrypted data. A polynomial of degree d is evaluated with the baby-step giant-step variant
+    of the Paterson-Stockmeyer algorithm: the baby steps x^1, ..., x^k and the giant steps x^k, x^(2k), x^(4k), ... are
+    computed once, where k is a power of two close to sqrt(d), and the polynomial is split recursively by the giant
+    steps into polynomials of degree less than k. These are evaluated as linear combinations of the baby steps, which
+    only needs plaintext multiplications. In total O(sqrt(d)) ciphertext multiplications are performed, and the
+    multiplicative depth is at most one more than ceil(log2(d + 1)). In the Chebyshev basis the same is done with
+    T_k(x), T_(2k)(x), ... as giant steps, which is numerically much better behaved for the high-degree approximations
+    of functions on [-1, 1] that are common with CKKS.
+
+    @par Levels and Scales
+    Ciphertexts at different levels are switched down to the lower level before they are combined, and every ciphertext
+    multiplication is followed by relinearization and, with CKKS, by rescaling. With CKKS the scale of every
+    intermediate result is the exact scale left by rescaling, so the primes in the coefficient modulus need not be
+    close to the scale. Scales are only aligned where terms are combined: each coefficient is encoded at the scale
+    that brings its product with a baby step to a common scale, a quotient is evaluated at the scale that brings its
+    product with a giant step to the scale of the remainder, and in the Chebyshev recurrence the subtracted term is
+    multiplied by one at the scale of the product before the single rescaling. The result has the scale of the input
+    ciphertext.
+
+    @par Thread Safety
+    A PolynomialEvaluator keeps state while evaluating, so concurrent calls to evaluate must use separate instances.
+
+    @see Evaluator for the individual operations used.
+    */
+    class PolynomialEvaluator
+    {
+    public:
+        /**
+        Creates a PolynomialEvaluator instance initialized with the specified SEALContext.
+
+        @param[in] context The SEALContext
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if the scheme is not scheme_type::bfv, scheme_type::ckks, or scheme_type::bgv
+        */
+        PolynomialEvaluator(const SEALContext &context);
+
+        /**
+        Evaluates a polynomial with real coefficients on a CKKS ciphertext and stores the result in the destination
+        parameter. Trailing zero coefficients are ignored. Dynamic memory allocations in the process are allocated
+        from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to evaluate the polynomial on
+        @param[in] coeffs The coefficients of the polynomial, starting with the constant term
+        @param[in] basis The basis of the coefficients
+        @param[in] relin_keys The relinearization keys
+        @param[out] destination The ciphertext to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::invalid_argument if encrypted or relin_keys is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if the polynomial has degree less than 1
+        @throws std::invalid_argument if encrypted does not have enough levels left
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void evaluate(
+            const Ciphertext &encrypted, const std::vector<double> &coeffs, poly_basis_type basis,
+            const RelinKeys &relin_keys, Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Evaluates a polynomial with integer coefficients on a BFV or BGV ciphertext and stores the result in the
+        destination parameter. The coefficients are reduced modulo the plaintext modulus, and the polynomial is applied
+        to every slot when batching is used, or to the encrypted polynomial otherwise. Trailing zero coefficients are
+        ignored. Dynamic memory allocations in the process are allocated from the memory pool pointed to by the given
+        MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to evaluate the polynomial on
+        @param[in] coeffs The coefficients of the polynomial, starting with the constant term
+        @param[in] basis The basis of the coefficients
+        @param[in] relin_keys The relinearization keys
+        @param[out] destination The ciphertext to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::bfv or scheme_type::bgv
+        @throws std::invalid_argument if encrypted or relin_keys is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if the polynomial has degree less than 1
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void evaluate(
+            const Ciphertext &encrypted, const std::vector<std::int64_t> &coeffs, poly_basis_type basis,
+            const RelinKeys &relin_keys, Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Returns the number of ciphertext multiplications used to evaluate a dense polynomial of a given degree. Sparse
+        polynomials may need fewer.
+
+        @param[in] degree The degree of the polynomial
+        @throws std::invalid_argument if degree is less than 1
+        */
+        SEAL_NODISCARD static std::size_t MultiplicationCount(std::size_t degree);
+
+    private:
+        PolynomialEvaluator(const PolynomialEvaluator &copy) = delete;
+
+        PolynomialEvaluator(PolynomialEvaluator &&source) = delete;
+
+        PolynomialEvaluator &operator=(const PolynomialEvaluator &assign) = delete;
+
+        PolynomialEvaluator &operator=(PolynomialEvaluator &&assign) = delete;
+
+        template <typename T>
+        struct Term;
+
+        template <typename T>
+        void evaluate_internal(
+            const Ciphertext &encrypted, std::vector<T> coeffs, poly_basis_type basis, const RelinKeys &relin_keys,
+            Ciphertext &destination, MemoryPoolHandle pool);
+
+        // The result is at target_scale; with BFV and BGV target_scale is ignored
+        template <typename T>
+        Term<T> evaluate_recursive(
+            const std::vector<T> &coeffs, poly_basis_type basis, const std::vector<Ciphertext> &baby_steps,
+            const std::vector<Ciphertext> &giant_steps, std::size_t baby_step_count, double target_scale,
+            const RelinKeys &relin_keys, MemoryPoolHandle pool);
+
+        template <typename T>
+        Term<T> linear_combination(
+            const std::vector<T> &coeffs, const std::vector<Ciphertext> &baby_steps, double target_scale,
+            MemoryPoolHandle pool);
+
+        // Returns the level of the result of evaluate_recursive without evaluating anything, or nullptr if the result
+        // is a constant; CKKS only
+        template <typename T>
+        std::shared_ptr<const SEALContext::ContextData> output_level(
+            const std::vector<T> &coeffs, poly_basis_type basis, const std::vector<Ciphertext> &baby_steps,
+            const std::vector<Ciphertext> &giant_steps, std::size_t baby_step_count) const;
+
+        // Splits coeffs by the giant step into a quotient and a remainder with trailing zeros removed
+        template <typename T>
+        void split(
+            const std::vector<T> &coeffs, poly_basis_type basis, std::size_t giant_step, std::vector<T> &quotient,
+            std::vector<T> &remainder) const;
+
+        // Returns the lowest baby step with a non-zero coefficient, or nullptr if there is none
+        template <typename T>
+        const Ciphertext *lowest_baby_step(
+            const std::vector<T> &coeffs, const std::vector<Ciphertext> &baby_steps) const;
+
+        // Multiplies and relinearizes without rescaling
+        void multiply_relin(
+            const Ciphertext &encrypted1, const Ciphertext &encrypted2, const RelinKeys &relin_keys,
+            Ciphertext &destination, MemoryPoolHandle pool);
+
+        // Computes 2 * encrypted1 * encrypted2 - encrypted3, or 2 * encrypted1 * encrypted2 - 1 if encrypted3 is null,
+        // and rescales
+        void chebyshev_product(
+            const Ciphertext &encrypted1, const Ciphertext &encrypted2, const Ciphertext *encrypted3,
+            const RelinKeys &relin_keys, Ciphertext &destination, MemoryPoolHandle pool);
+
+        void match_level(Ciphertext &encrypted1, Ciphertext &encrypted2, MemoryPoolHandle pool);
+
+        void rescale(Ciphertext &encrypted, MemoryPoolHandle pool);
+
+        // Returns the scale at which a product at the given level must be for rescaling to bring it to target_scale
+        SEAL_NODISCARD double product_scale(const SEALContext::ContextData &context_data, double target_scale) const;
+
+        void multiply_const_inplace(Ciphertext &encrypted, double value, double scale);
+
+        // The scale is ignored
+        void multiply_const_inplace(Ciphertext &encrypted, std::uint64_t value, double scale);
+
+        void add_const_inplace(Ciphertext &encrypted, double value);
+
+        void add_const_inplace(Ciphertext &encrypted, std::uint64_t value);
+
+        // A coefficient that encodes to zero at the current scale is treated as zero
+        SEAL_NODISCARD bool is_zero(double value) const noexcept
+        {
+            return std::fabs(value * scale_) < 0.5;
+        }
+
+        SEAL_NODISCARD bool is_zero(std::uint64_t value) const noexcept
+        {
+            return value == 0;
+        }
+
+        SEAL_NODISCARD double add_coeff(double a, double b) const noexcept
+        {
+            return a + b;
+        }
+
+        SEAL_NODISCARD std::uint64_t add_coeff(std::uint64_t a, std::uint64_t b) const noexcept;
+
+        SEAL_NODISCARD double sub_coeff(double a, double b) const noexcept
+        {
+            return a - b;
+        }
+
+        SEAL_NODISCARD std::uint64_t sub_coeff(std::uint64_t a, std::uint64_t b) const noexcept;
+
+        SEAL_NODISCARD static std::size_t BabyStepCount(std::size_t degree) noexcept;
+
+        SEALContext context_;
+
+        Evaluator evaluator_;
+
+        bool is_ckks_ = false;
+
+        // Scale of the ciphertext being evaluated, which is also the scale of the result; CKKS only
+        double scale_ = 1.0;
+    };
+} // namespace seal
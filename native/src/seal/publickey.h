@@ -10,6 +10,11 @@
 
 namespace seal
 {
+    namespace util
+    {
+        class LazyKeyStore;
+    }
+
     /**
     Class to store a public key.
 
@@ -27,6 +32,7 @@ namespace seal
     {
         friend class KeyGenerator;
         friend class KSwitchKeys;
+        friend class util::LazyKeyStore;
 
     public:
         /**
@@ -6,17 +6,22 @@
 #include "seal/batchencoder.h"
 #include "seal/ciphertext.h"
 #include "seal/ckks.h"
+#include "seal/ckksbootstrapper.h"
+#include "seal/coeffencoder.h"
 #include "seal/context.h"
 #include "seal/decryptor.h"
 #include "seal/dynarray.h"
 #include "seal/encryptionparams.h"
 #include "seal/encryptor.h"
+#include "seal/evaluationgraph.h"
 #include "seal/evaluator.h"
 #include "seal/galoiskeys.h"
 #include "seal/keygenerator.h"
 #include "seal/memorymanager.h"
 #include "seal/modulus.h"
 #include "seal/plaintext.h"
+#include "seal/plaintextcache.h"
+#include "seal/polynomialevaluator.h"
 #include "seal/publickey.h"
 #include "seal/randomgen.h"
 #include "seal/randomtostd.h"
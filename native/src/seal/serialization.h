@@ -155,8 +155,9 @@ namespace seal
                 return false;
             }
 
-            // Support Microsoft SEAL 3.4 and 3.5
-            if (header.version_major == 3 && (header.version_minor == 4 || header.version_minor == 5))
+            // Support Microsoft SEAL 3.4, 3.5, and 3.6
+            if (header.version_major == 3 &&
+                (header.version_minor == 4 || header.version_minor == 5 || header.version_minor == 6))
             {
                 return true;
             }
@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/fft.h"
+
+using namespace std;
+
+#if defined(SEAL_USE_INTRIN) && defined(__AVX512F__)
+#define SEAL_FFT_USE_AVX512
+#endif
+#if defined(SEAL_USE_INTRIN) && defined(__AVX2__)
+#define SEAL_FFT_USE_AVX2
+#endif
+#if defined(SEAL_FFT_USE_AVX512) || defined(SEAL_FFT_USE_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            // Computes x, y = x + r * y, x - r * y for count values with a fixed root r
+            void forward_butterflies(
+                double *x_real, double *x_imag, double *y_real, double *y_imag, size_t count, double r_real,
+                double r_imag)
+            {
+                size_t j = 0;
+#ifdef SEAL_FFT_USE_AVX512
+                __m512d rr512 = _mm512_set1_pd(r_real);
+                __m512d ri512 = _mm512_set1_pd(r_imag);
+                for (; j + 8 <= count; j += 8)
+                {
+                    __m512d ur = _mm512_loadu_pd(x_real + j);
+                    __m512d ui = _mm512_loadu_pd(x_imag + j);
+                    __m512d yr = _mm512_loadu_pd(y_real + j);
+                    __m512d yi = _mm512_loadu_pd(y_imag + j);
+                    __m512d vr = _mm512_sub_pd(_mm512_mul_pd(yr, rr512), _mm512_mul_pd(yi, ri512));
+                    __m512d vi = _mm512_add_pd(_mm512_mul_pd(yr, ri512), _mm512_mul_pd(yi, rr512));
+                    _mm512_storeu_pd(x_real + j, _mm512_add_pd(ur, vr));
+                    _mm512_storeu_pd(x_imag + j, _mm512_add_pd(ui, vi));
+                    _mm512_storeu_pd(y_real + j, _mm512_sub_pd(ur, vr));
+                    _mm512_storeu_pd(y_imag + j, _mm512_sub_pd(ui, vi));
+                }
+#endif
+#ifdef SEAL_FFT_USE_AVX2
+                __m256d rr256 = _mm256_set1_pd(r_real);
+                __m256d ri256 = _mm256_set1_pd(r_imag);
+                for (; j + 4 <= count; j += 4)
+                {
+                    __m256d ur = _mm256_loadu_pd(x_real + j);
+                    __m256d ui = _mm256_loadu_pd(x_imag + j);
+                    __m256d yr = _mm256_loadu_pd(y_real + j);
+                    __m256d yi = _mm256_loadu_pd(y_imag + j);
+                    __m256d vr = _mm256_sub_pd(_mm256_mul_pd(yr, rr256), _mm256_mul_pd(yi, ri256));
+                    __m256d vi = _mm256_add_pd(_mm256_mul_pd(yr, ri256), _mm256_mul_pd(yi, rr256));
+                    _mm256_storeu_pd(x_real + j, _mm256_add_pd(ur, vr));
+                    _mm256_storeu_pd(x_imag + j, _mm256_add_pd(ui, vi));
+                    _mm256_storeu_pd(y_real + j, _mm256_sub_pd(ur, vr));
+                    _mm256_storeu_pd(y_imag + j, _mm256_sub_pd(ui, vi));
+                }
+#endif
+                for (; j < count; j++)
+                {
+                    double ur = x_real[j];
+                    double ui = x_imag[j];
+                    double vr = y_real[j] * r_real - y_imag[j] * r_imag;
+                    double vi = y_real[j] * r_imag + y_imag[j] * r_real;
+                    x_real[j] = ur + vr;
+                    x_imag[j] = ui + vi;
+                    y_real[j] = ur - vr;
+                    y_imag[j] = ui - vi;
+                }
+            }
+
+            // Computes x, y = s * (x + y), r * (x - y) for count values with a fixed root r; the scalar s is only
+            // applied when Scaled is set
+            template <bool Scaled>
+            void inverse_butterflies(
+                double *x_real, double *x_imag, double *y_real, double *y_imag, size_t count, double r_real,
+                double r_imag, double scalar)
+            {
+                size_t j = 0;
+#ifdef SEAL_FFT_USE_AVX512
+                __m512d rr512 = _mm512_set1_pd(r_real);
+                __m512d ri512 = _mm512_set1_pd(r_imag);
+                __m512d s512 = _mm512_set1_pd(scalar);
+                for (; j + 8 <= count; j += 8)
+                {
+                    __m512d ur = _mm512_loadu_pd(x_real + j);
+                    __m512d ui = _mm512_loadu_pd(x_imag + j);
+                    __m512d vr = _mm512_loadu_pd(y_real + j);
+                    __m512d vi = _mm512_loadu_pd(y_imag + j);
+                    __m512d sr = _mm512_add_pd(ur, vr);
+                    __m512d si = _mm512_add_pd(ui, vi);
+                    __m512d dr = _mm512_sub_pd(ur, vr);
+                    __m512d di = _mm512_sub_pd(ui, vi);
+                    if (Scaled)
+                    {
+                        sr = _mm512_mul_pd(sr, s512);
+                        si = _mm512_mul_pd(si, s512);
+                    }
+                    _mm512_storeu_pd(x_real + j, sr);
+                    _mm512_storeu_pd(x_imag + j, si);
+                    _mm512_storeu_pd(y_real + j, _mm512_sub_pd(_mm512_mul_pd(dr, rr512), _mm512_mul_pd(di, ri512)));
+                    _mm512_storeu_pd(y_imag + j, _mm512_add_pd(_mm512_mul_pd(dr, ri512), _mm512_mul_pd(di, rr512)));
+                }
+#endif
+#ifdef SEAL_FFT_USE_AVX2
+                __m256d rr256 = _mm256_set1_pd(r_real);
+                __m256d ri256 = _mm256_set1_pd(r_imag);
+                __m256d s256 = _mm256_set1_pd(scalar);
+                for (; j + 4 <= count; j += 4)
+                {
+                    __m256d ur = _mm256_loadu_pd(x_real + j);
+                    __m256d ui = _mm256_loadu_pd(x_imag + j);
+                    __m256d vr = _mm256_loadu_pd(y_real + j);
+                    __m256d vi = _mm256_loadu_pd(y_imag + j);
+                    __m256d sr = _mm256_add_pd(ur, vr);
+                    __m256d si = _mm256_add_pd(ui, vi);
+                    __m256d dr = _mm256_sub_pd(ur, vr);
+                    __m256d di = _mm256_sub_pd(ui, vi);
+                    if (Scaled)
+                    {
+                        sr = _mm256_mul_pd(sr, s256);
+                        si = _mm256_mul_pd(si, s256);
+                    }
+                    _mm256_storeu_pd(x_real + j, sr);
+                    _mm256_storeu_pd(x_imag + j, si);
+                    _mm256_storeu_pd(y_real + j, _mm256_sub_pd(_mm256_mul_pd(dr, rr256), _mm256_mul_pd(di, ri256)));
+                    _mm256_storeu_pd(y_imag + j, _mm256_add_pd(_mm256_mul_pd(dr, ri256), _mm256_mul_pd(di, rr256)));
+                }
+#endif
+                for (; j < count; j++)
+                {
+                    double ur = x_real[j];
+                    double ui = x_imag[j];
+                    double vr = y_real[j];
+                    double vi = y_imag[j];
+                    double dr = ur - vr;
+                    double di = ui - vi;
+                    x_real[j] = Scaled ? (ur + vr) * scalar : ur + vr;
+                    x_imag[j] = Scaled ? (ui + vi) * scalar : ui + vi;
+                    y_real[j] = dr * r_real - di * r_imag;
+                    y_imag[j] = dr * r_imag + di * r_real;
+                }
+            }
+        } // namespace
+
+        void multiply_split_complex(
+            double *operand_real, double *operand_imag, const double *root_real, const double *root_imag,
+            size_t count, bool conjugate)
+        {
+            // Multiplying with the conjugate flips the sign of the imaginary parts of the roots
+            double sign = conjugate ? -1.0 : 1.0;
+            size_t j = 0;
+#ifdef SEAL_FFT_USE_AVX512
+            __m512d sign512 = _mm512_set1_pd(sign);
+            for (; j + 8 <= count; j += 8)
+            {
+                __m512d ar = _mm512_loadu_pd(operand_real + j);
+                __m512d ai = _mm512_loadu_pd(operand_imag + j);
+                __m512d br = _mm512_loadu_pd(root_real + j);
+                __m512d bi = _mm512_mul_pd(_mm512_loadu_pd(root_imag + j), sign512);
+                _mm512_storeu_pd(operand_real + j, _mm512_sub_pd(_mm512_mul_pd(ar, br), _mm512_mul_pd(ai, bi)));
+                _mm512_storeu_pd(operand_imag + j, _mm512_add_pd(_mm512_mul_pd(ar, bi), _mm512_mul_pd(ai, br)));
+            }
+#endif
+#ifdef SEAL_FFT_USE_AVX2
+            __m256d sign256 = _mm256_set1_pd(sign);
+            for (; j + 4 <= count; j += 4)
+            {
+                __m256d ar = _mm256_loadu_pd(operand_real + j);
+                __m256d ai = _mm256_loadu_pd(operand_imag + j);
+                __m256d br = _mm256_loadu_pd(root_real + j);
+                __m256d bi = _mm256_mul_pd(_mm256_loadu_pd(root_imag + j), sign256);
+                _mm256_storeu_pd(operand_real + j, _mm256_sub_pd(_mm256_mul_pd(ar, br), _mm256_mul_pd(ai, bi)));
+                _mm256_storeu_pd(operand_imag + j, _mm256_add_pd(_mm256_mul_pd(ar, bi), _mm256_mul_pd(ai, br)));
+            }
+#endif
+            for (; j < count; j++)
+            {
+                double ar = operand_real[j];
+                double ai = operand_imag[j];
+                double br = root_real[j];
+                double bi = root_imag[j] * sign;
+                operand_real[j] = ar * br - ai * bi;
+                operand_imag[j] = ar * bi + ai * br;
+            }
+        }
+
+        void split_transform_to_rev(
+            double *values_real, double *values_imag, int log_n, const double *roots_real, const double *roots_imag)
+        {
+            size_t n = size_t(1) << log_n;
+            size_t gap = n >> 1;
+            size_t root_index = 1;
+            for (size_t m = 1; m < n; m <<= 1, gap >>= 1)
+            {
+                size_t offset = 0;
+                for (size_t i = 0; i < m; i++, root_index++, offset += gap << 1)
+                {
+                    forward_butterflies(
+                        values_real + offset, values_imag + offset, values_real + offset + gap,
+                        values_imag + offset + gap, gap, roots_real[root_index], roots_imag[root_index]);
+                }
+            }
+        }
+
+        void split_transform_from_rev(
+            double *values_real, double *values_imag, int log_n, const double *roots_real, const double *roots_imag,
+            double scalar)
+        {
+            size_t n = size_t(1) << log_n;
+            size_t gap = 1;
+            size_t root_index = 1;
+            for (size_t m = n >> 1; m > 1; m >>= 1, gap <<= 1)
+            {
+                size_t offset = 0;
+                for (size_t i = 0; i < m; i++, root_index++, offset += gap << 1)
+                {
+                    inverse_butterflies<false>(
+                        values_real + offset, values_imag + offset, values_real + offset + gap,
+                        values_imag + offset + gap, gap, roots_real[root_index], roots_imag[root_index], 1.0);
+                }
+            }
+
+            // Merge the multiplication with the scalar into the last iteration
+            inverse_butterflies<true>(
+                values_real, values_imag, values_real + gap, values_imag + gap, gap, roots_real[root_index] * scalar,
+                roots_imag[root_index] * scalar, scalar);
+        }
+    } // namespace util
+} // namespace seal
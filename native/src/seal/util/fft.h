@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/util/defines.h"
+#include <cstddef>
+
+namespace seal
+{
+    namespace util
+    {
+        /*
+        The functions in this file compute on complex numbers stored in split layout: the real parts and the imaginary
+        parts are held in two separate arrays of doubles. In contrast to arrays of std::complex<double>, this allows
+        the butterflies to operate on several values at once. When SEAL_USE_INTRIN is set and the compiler targets
+        AVX2 or AVX-512 (for example with -mavx2 -mfma or -march=native), the butterflies are computed with the
+        corresponding intrinsics; otherwise plain loops are used, which the compiler may still vectorize.
+
+        The transforms follow DWTHandler::transform_to_rev and DWTHandler::transform_from_rev with complex roots, and
+        expect the powers of the root in the same bit-reversed and scrambled orders.
+        */
+
+        /**
+        Multiplies in place each operand[i] with root[i], or with the conjugate of root[i] if conjugate is set.
+
+        @param[in,out] operand_real The real parts of the operand
+        @param[in,out] operand_imag The imaginary parts of the operand
+        @param[in] root_real The real parts of the roots
+        @param[in] root_imag The imaginary parts of the roots
+        @param[in] count The number of values to multiply
+        @param[in] conjugate Whether to multiply with the conjugates of the roots
+        */
+        void multiply_split_complex(
+            double *operand_real, double *operand_imag, const double *root_real, const double *root_imag,
+            std::size_t count, bool conjugate);
+
+        /**
+        Performs in place a fast multiplication with the DWT matrix on complex values in split layout.
+
+        @param[in,out] values_real The real parts; inputs in normal order, outputs in bit-reversed order
+        @param[in,out] values_imag The imaginary parts; inputs in normal order, outputs in bit-reversed order
+        @param[in] log_n log 2 of the DWT size, which must be positive
+        @param[in] roots_real The real parts of the powers of a root in bit-reversed order
+        @param[in] roots_imag The imaginary parts of the powers of a root in bit-reversed order
+        */
+        void split_transform_to_rev(
+            double *values_real, double *values_imag, int log_n, const double *roots_real, const double *roots_imag);
+
+        /**
+        Performs in place a fast multiplication with the inverse DWT matrix on complex values in split layout, and
+        multiplies all outputs with a scalar.
+
+        @param[in,out] values_real The real parts; inputs in bit-reversed order, outputs in normal order
+        @param[in,out] values_imag The imaginary parts; inputs in bit-reversed order, outputs in normal order
+        @param[in] log_n log 2 of the DWT size, which must be positive
+        @param[in] roots_real The real parts of the powers of a root in scrambled order
+        @param[in] roots_imag The imaginary parts of the powers of a root in scrambled order
+        @param[in] scalar The scalar that is multiplied to all output values
+        */
+        void split_transform_from_rev(
+            double *values_real, double *values_imag, int log_n, const double *roots_real, const double *roots_imag,
+            double scalar);
+    } // namespace util
+} // namespace seal
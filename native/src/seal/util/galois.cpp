@@ -4,6 +4,10 @@
 #include "seal/util/galois.h"
 #include "seal/util/numth.h"
 #include "seal/util/uintcore.h"
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
 
 using namespace std;
 
@@ -11,11 +15,92 @@ namespace seal
 {
     namespace util
     {
+        namespace
+        {
+            template <typename T>
+            inline void permute_ntt(const vector<T> &table, ConstCoeffIter operand, CoeffIter result)
+            {
+                SEAL_ITERATE(iter(table.data(), result), table.size(), [&](auto I) { get<1>(I) = operand[get<0>(I)]; });
+            }
+        } // namespace
+
         // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to
         // ensure symbol is created.
         constexpr uint32_t GaloisTool::generator_;
 
-        void GaloisTool::generate_table_ntt(uint32_t galois_elt, Pointer<uint32_t> &result) const
+        shared_ptr<const GaloisTool::PermutationTable> GaloisTool::GetSharedTableNTT(
+            int coeff_count_power, uint32_t galois_elt)
+        {
+            // Tables only depend on the degree and the Galois element, so all contexts can share them. Entries expire
+            // when the last GaloisTool using them is destroyed.
+            static mutex registry_mutex;
+            static map<pair<int, uint32_t>, weak_ptr<const PermutationTable>> registry;
+
+            auto key = make_pair(coeff_count_power, galois_elt);
+            {
+                lock_guard<mutex> lock(registry_mutex);
+                auto it = registry.find(key);
+                if (it != registry.end())
+                {
+                    if (auto table = it->second.lock())
+                    {
+                        return table;
+                    }
+                }
+            }
+
+            size_t coeff_count = size_t(1) << coeff_count_power;
+            vector<uint32_t> indices;
+            indices.reserve(coeff_count);
+            uint32_t coeff_count_minus_one = safe_cast<uint32_t>(coeff_count) - 1;
+            for (size_t i = coeff_count; i < coeff_count << 1; i++)
+            {
+                uint32_t reversed = reverse_bits<uint32_t>(safe_cast<uint32_t>(i), coeff_count_power + 1);
+                uint64_t index_raw = (static_cast<uint64_t>(galois_elt) * static_cast<uint64_t>(reversed)) >> 1;
+                index_raw &= static_cast<uint64_t>(coeff_count_minus_one);
+                indices.push_back(reverse_bits<uint32_t>(static_cast<uint32_t>(index_raw), coeff_count_power));
+            }
+
+            auto new_table = make_shared<PermutationTable>();
+            if (coeff_count_minus_one <= numeric_limits<uint16_t>::max())
+            {
+                new_table->compact.assign(indices.cbegin(), indices.cend());
+            }
+            else
+            {
+                new_table->wide = move(indices);
+            }
+
+            lock_guard<mutex> lock(registry_mutex);
+
+            // Another thread may have created the same table concurrently
+            auto &entry = registry[key];
+            if (auto table = entry.lock())
+            {
+                return table;
+            }
+            shared_ptr<const PermutationTable> result(move(new_table));
+            entry = result;
+            return result;
+        }
+
+        void GaloisTool::precompute_tables_ntt(const vector<uint32_t> &galois_elts)
+        {
+            for (auto galois_elt : galois_elts)
+            {
+                if (!(galois_elt & 1) || (galois_elt >= 2 * static_cast<uint64_t>(coeff_count_)))
+                {
+                    throw invalid_argument("Galois element is not valid");
+                }
+                auto &table = eager_tables_[GetIndexFromElt(galois_elt)];
+                if (!table)
+                {
+                    table = GetSharedTableNTT(coeff_count_power_, galois_elt);
+                }
+            }
+        }
+
+        void GaloisTool::generate_table_ntt(uint32_t galois_elt, shared_ptr<const PermutationTable> &result) const
         {
 #ifdef SEAL_DEBUG
             if (!(galois_elt & 1) || (galois_elt >= 2 * (uint64_t(1) << coeff_count_power_)))
@@ -30,24 +115,14 @@ namespace seal
             }
             reader_lock.unlock();
 
-            auto temp(allocate<uint32_t>(coeff_count_, pool_));
-            auto temp_ptr = temp.get();
-
-            uint32_t coeff_count_minus_one = safe_cast<uint32_t>(coeff_count_) - 1;
-            for (size_t i = coeff_count_; i < coeff_count_ << 1; i++)
-            {
-                uint32_t reversed = reverse_bits<uint32_t>(safe_cast<uint32_t>(i), coeff_count_power_ + 1);
-                uint64_t index_raw = (static_cast<uint64_t>(galois_elt) * static_cast<uint64_t>(reversed)) >> 1;
-                index_raw &= static_cast<uint64_t>(coeff_count_minus_one);
-                *temp_ptr++ = reverse_bits<uint32_t>(static_cast<uint32_t>(index_raw), coeff_count_power_);
-            }
+            auto table = GetSharedTableNTT(coeff_count_power_, galois_elt);
 
             WriterLock writer_lock(permutation_tables_locker_.acquire_write());
             if (result)
             {
                 return;
             }
-            result.acquire(move(temp));
+            result = move(table);
         }
 
         uint32_t GaloisTool::get_elt_from_step(int step) const
@@ -142,7 +217,8 @@ namespace seal
             coeff_count_ = size_t(1) << coeff_count_power_;
 
             // Capacity for coeff_count_ number of tables
-            permutation_tables_ = allocate<Pointer<uint32_t>>(coeff_count_, pool_);
+            eager_tables_.resize(coeff_count_);
+            permutation_tables_.resize(coeff_count_);
         }
 
         void GaloisTool::apply_galois(
@@ -210,11 +286,23 @@ namespace seal
                 throw invalid_argument("Galois element is not valid");
             }
 #endif
-            generate_table_ntt(galois_elt, permutation_tables_[GetIndexFromElt(galois_elt)]);
-            auto table = iter(permutation_tables_[GetIndexFromElt(galois_elt)]);
+            size_t index = GetIndexFromElt(galois_elt);
+            const PermutationTable *table = eager_tables_[index].get();
+            if (!table)
+            {
+                generate_table_ntt(galois_elt, permutation_tables_[index]);
+                table = permutation_tables_[index].get();
+            }
 
             // Perform permutation.
-            SEAL_ITERATE(iter(table, result), coeff_count_, [&](auto I) { get<1>(I) = operand[get<0>(I)]; });
+            if (!table->compact.empty())
+            {
+                permute_ntt(table->compact, operand, result);
+            }
+            else
+            {
+                permute_ntt(table->wide, operand, result);
+            }
         }
     } // namespace util
 } // namespace seal
@@ -7,10 +7,13 @@
 #include "seal/modulus.h"
 #include "seal/util/defines.h"
 #include "seal/util/iterator.h"
+#include "seal/util/locks.h"
 #include "seal/util/pointer.h"
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 namespace seal
 {
@@ -29,6 +32,19 @@ namespace seal
                 initialize(coeff_count_power);
             }
 
+            /**
+            Creates a GaloisTool with the NTT permutation tables for the given Galois elements computed up front.
+            Permutations by these elements never take a lock and never allocate. Tables are shared process-wide
+            between all GaloisTool instances with the same coeff_count_power.
+
+            @throws std::invalid_argument if a Galois element is not valid
+            */
+            GaloisTool(int coeff_count_power, const std::vector<std::uint32_t> &galois_elts, MemoryPoolHandle pool)
+                : GaloisTool(coeff_count_power, std::move(pool))
+            {
+                precompute_tables_ntt(galois_elts);
+            }
+
             void apply_galois(
                 ConstCoeffIter operand, std::uint32_t galois_elt, const Modulus &modulus, CoeffIter result) const;
 
@@ -133,6 +149,15 @@ namespace seal
             */
             SEAL_NODISCARD std::vector<std::uint32_t> get_elts_all() const noexcept;
 
+            /**
+            Returns whether the NTT permutation table for a given Galois element was computed up front.
+            */
+            SEAL_NODISCARD inline bool is_precomputed(std::uint32_t galois_elt) const noexcept
+            {
+                std::size_t index = static_cast<std::size_t>(galois_elt >> 1);
+                return (galois_elt & 1) && index < coeff_count_ && eager_tables_[index];
+            }
+
             /**
             Compute the index in the range of 0 to (coeff_count_ - 1) of a given Galois element.
             */
@@ -156,9 +181,22 @@ namespace seal
 
             GaloisTool &operator=(GaloisTool &&assign) = delete;
 
+            // Indices are stored in 16 bits whenever the degree allows it to halve the table footprint
+            struct PermutationTable
+            {
+                std::vector<std::uint16_t> compact;
+
+                std::vector<std::uint32_t> wide;
+            };
+
             void initialize(int coeff_count_power);
 
-            void generate_table_ntt(std::uint32_t galois_elt, Pointer<std::uint32_t> &result) const;
+            void precompute_tables_ntt(const std::vector<std::uint32_t> &galois_elts);
+
+            void generate_table_ntt(std::uint32_t galois_elt, std::shared_ptr<const PermutationTable> &result) const;
+
+            SEAL_NODISCARD static std::shared_ptr<const PermutationTable> GetSharedTableNTT(
+                int coeff_count_power, std::uint32_t galois_elt);
 
             MemoryPoolHandle pool_;
 
@@ -168,7 +206,10 @@ namespace seal
 
             static constexpr std::uint32_t generator_ = 3;
 
-            mutable Pointer<Pointer<std::uint32_t>> permutation_tables_;
+            // Written only by the constructor, so reads need no locking
+            std::vector<std::shared_ptr<const PermutationTable>> eager_tables_;
+
+            mutable std::vector<std::shared_ptr<const PermutationTable>> permutation_tables_;
 
             mutable util::ReaderWriterLocker permutation_tables_locker_;
         };
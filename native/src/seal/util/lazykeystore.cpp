@@ -0,0 +1,168 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/common.h"
+#include "seal/util/lazykeystore.h"
+#include <stdexcept>
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        shared_ptr<const LazyKeyStore::key_type> LazyKeyStore::get(const SEALContext &context, size_t index) const
+        {
+            if (!has_key(index))
+            {
+                throw invalid_argument("keyswitching key does not exist");
+            }
+
+            // Fast path: the key is already expanded
+            {
+                auto lock = cache_locker_.acquire_write();
+                auto it = cache_.find(index);
+                if (it != cache_.end())
+                {
+                    lru_.splice(lru_.begin(), lru_, it->second.second);
+                    return it->second.first;
+                }
+            }
+
+            // Expand outside of the lock so other keys remain accessible in the meantime
+            auto &serialized_key = serialized_keys_[index];
+            auto new_key = make_shared<key_type>();
+            new_key->reserve(serialized_key.size());
+            for (auto &component : serialized_key)
+            {
+                PublicKey pk(pool_);
+                pk.load(context, component.data(), component.size());
+                new_key->emplace_back(move(pk));
+            }
+            shared_ptr<const key_type> result(move(new_key));
+
+            if (!cache_capacity_)
+            {
+                return result;
+            }
+
+            auto lock = cache_locker_.acquire_write();
+
+            // Another thread may have expanded the same key concurrently
+            auto it = cache_.find(index);
+            if (it != cache_.end())
+            {
+                lru_.splice(lru_.begin(), lru_, it->second.second);
+                return it->second.first;
+            }
+
+            if (cache_.size() >= cache_capacity_)
+            {
+                cache_.erase(lru_.back());
+                lru_.pop_back();
+            }
+            lru_.push_front(index);
+            cache_.emplace(index, make_pair(result, lru_.begin()));
+            return result;
+        }
+
+        size_t LazyKeyStore::cached_count() const
+        {
+            auto lock = cache_locker_.acquire_read();
+            return cache_.size();
+        }
+
+        size_t LazyKeyStore::save_size() const
+        {
+            size_t total_size = sizeof(uint64_t); // keys_dim1
+            for (auto &key_dim1 : serialized_keys_)
+            {
+                total_size = add_safe(total_size, sizeof(uint64_t)); // keys_dim2
+                for (auto &key_dim2 : key_dim1)
+                {
+                    total_size = add_safe(total_size, key_dim2.size());
+                }
+            }
+            return total_size;
+        }
+
+        void LazyKeyStore::save_members(ostream &stream) const
+        {
+            uint64_t keys_dim1 = static_cast<uint64_t>(serialized_keys_.size());
+            stream.write(reinterpret_cast<const char *>(&keys_dim1), sizeof(uint64_t));
+            for (auto &key_dim1 : serialized_keys_)
+            {
+                uint64_t keys_dim2 = static_cast<uint64_t>(key_dim1.size());
+                stream.write(reinterpret_cast<const char *>(&keys_dim2), sizeof(uint64_t));
+                for (auto &key_dim2 : key_dim1)
+                {
+                    // Each component is already a complete serialized PublicKey
+                    stream.write(
+                        reinterpret_cast<const char *>(key_dim2.data()), safe_cast<streamsize>(key_dim2.size()));
+                }
+            }
+        }
+
+        void LazyKeyStore::load_members(const SEALContext &context, istream &stream)
+        {
+            auto &key_parms = context.key_context_data()->parms();
+            size_t decomp_mod_count = context.first_context_data()->parms().coeff_modulus().size();
+
+            // A single key component can never be larger than a full unseeded PublicKey
+            size_t max_component_data_size = add_safe(
+                mul_safe(
+                    size_t(2), key_parms.poly_modulus_degree(), key_parms.coeff_modulus().size(), sizeof(uint64_t)),
+                size_t(256));
+
+            vector<vector<vector<seal_byte>>> new_keys;
+
+            uint64_t keys_dim1 = 0;
+            stream.read(reinterpret_cast<char *>(&keys_dim1), sizeof(uint64_t));
+            if (keys_dim1 > key_parms.poly_modulus_degree())
+            {
+                throw logic_error("KSwitchKeys data is invalid");
+            }
+            new_keys.resize(safe_cast<size_t>(keys_dim1));
+
+            for (auto &key_dim1 : new_keys)
+            {
+                uint64_t keys_dim2 = 0;
+                stream.read(reinterpret_cast<char *>(&keys_dim2), sizeof(uint64_t));
+                if (keys_dim2 && keys_dim2 != decomp_mod_count)
+                {
+                    throw logic_error("KSwitchKeys data is invalid");
+                }
+
+                key_dim1.resize(safe_cast<size_t>(keys_dim2));
+                for (auto &key_dim2 : key_dim1)
+                {
+                    Serialization::SEALHeader header;
+                    Serialization::LoadHeader(stream, header);
+                    if (!Serialization::IsValidHeader(header))
+                    {
+                        throw logic_error("loaded SEALHeader is invalid");
+                    }
+                    size_t max_size = add_safe(
+                        sizeof(Serialization::SEALHeader),
+                        Serialization::ComprSizeEstimate(max_component_data_size, header.compr_mode));
+                    if (header.size < sizeof(Serialization::SEALHeader) || header.size > max_size)
+                    {
+                        throw logic_error("KSwitchKeys data is invalid");
+                    }
+
+                    // Keep the (possibly upgraded) header so the component can be loaded on its own
+                    key_dim2.resize(safe_cast<size_t>(header.size));
+                    Serialization::SaveHeader(header, key_dim2.data(), key_dim2.size());
+                    stream.read(
+                        reinterpret_cast<char *>(key_dim2.data() + sizeof(Serialization::SEALHeader)),
+                        safe_cast<streamsize>(key_dim2.size() - sizeof(Serialization::SEALHeader)));
+                }
+            }
+
+            auto lock = cache_locker_.acquire_write();
+            swap(serialized_keys_, new_keys);
+            lru_.clear();
+            cache_.clear();
+        }
+    } // namespace util
+} // namespace seal
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/context.h"
+#include "seal/memorymanager.h"
+#include "seal/publickey.h"
+#include "seal/serialization.h"
+#include "seal/util/defines.h"
+#include "seal/util/locks.h"
+#include <cstddef>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Stores keyswitching keys in their serialized form and expands them only when
+        they are needed. When the keys were created with a seed (the default for
+        KeyGenerator::create_galois_keys returning Serializable<GaloisKeys>), the
+        serialized form holds only the first polynomial and the seed of each key,
+        which halves the resident memory. Expanded keys are kept in a bounded cache
+        with least-recently-used eviction.
+
+        @par Thread Safety
+        Expanding keys is thread-safe. Loading is not thread-safe and must not be
+        done while other threads access the same LazyKeyStore.
+        */
+        class LazyKeyStore
+        {
+        public:
+            using key_type = std::vector<PublicKey>;
+
+            LazyKeyStore(std::size_t cache_capacity, MemoryPoolHandle pool)
+                : cache_capacity_(cache_capacity), pool_(std::move(pool))
+            {
+                if (!pool_)
+                {
+                    throw std::invalid_argument("pool is uninitialized");
+                }
+            }
+
+            /**
+            Returns the number of key slots, including empty ones.
+            */
+            SEAL_NODISCARD inline std::size_t slot_count() const noexcept
+            {
+                return serialized_keys_.size();
+            }
+
+            /**
+            Returns whether a key is present at a given index.
+            */
+            SEAL_NODISCARD inline bool has_key(std::size_t index) const noexcept
+            {
+                return index < serialized_keys_.size() && !serialized_keys_[index].empty();
+            }
+
+            /**
+            Returns the expanded key at a given index, expanding it first if it is not
+            in the cache. The returned pointer remains valid after eviction.
+
+            @param[in] context The SEALContext
+            @param[in] index The index of the key
+            @throws std::invalid_argument if the key at the given index does not exist
+            @throws std::logic_error if the stored key data is invalid
+            */
+            SEAL_NODISCARD std::shared_ptr<const key_type> get(const SEALContext &context, std::size_t index) const;
+
+            /**
+            Returns the maximum number of expanded keys kept in the cache.
+            */
+            SEAL_NODISCARD inline std::size_t cache_capacity() const noexcept
+            {
+                return cache_capacity_;
+            }
+
+            /**
+            Returns the number of expanded keys currently in the cache.
+            */
+            SEAL_NODISCARD std::size_t cached_count() const;
+
+            /**
+            Returns the number of bytes that save_members writes.
+            */
+            SEAL_NODISCARD std::size_t save_size() const;
+
+            /**
+            Writes the keys in the format of KSwitchKeys::save_members, excluding the
+            parms_id.
+            */
+            void save_members(std::ostream &stream) const;
+
+            /**
+            Reads keys written by KSwitchKeys::save_members, excluding the parms_id,
+            without expanding them. Only the sizes are checked against the given
+            SEALContext; the keys are fully validated when they are expanded.
+            */
+            void load_members(const SEALContext &context, std::istream &stream);
+
+        private:
+            LazyKeyStore(const LazyKeyStore &copy) = delete;
+
+            LazyKeyStore &operator=(const LazyKeyStore &assign) = delete;
+
+            std::size_t cache_capacity_;
+
+            MemoryPoolHandle pool_;
+
+            // Each key component is stored as a self-contained serialized PublicKey
+            std::vector<std::vector<std::vector<seal_byte>>> serialized_keys_{};
+
+            mutable ReaderWriterLocker cache_locker_;
+
+            // Most recently used index is at the front
+            mutable std::list<std::size_t> lru_{};
+
+            mutable std::unordered_map<
+                std::size_t, std::pair<std::shared_ptr<const key_type>, std::list<std::size_t>::iterator>>
+                cache_{};
+        };
+    } // namespace util
+} // namespace seal
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/mappedfile.h"
+#include <algorithm>
+#include <stdexcept>
+#ifdef SEAL_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+#ifdef SEAL_USE_MMAP
+        namespace
+        {
+            // madvise needs a page-aligned start address
+            void page_range(
+                seal_byte *data, size_t size, size_t offset, size_t length, void *&start, size_t &page_length)
+            {
+                if (offset >= size)
+                {
+                    start = nullptr;
+                    page_length = 0;
+                    return;
+                }
+                length = min(length, size - offset);
+                size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                size_t page_offset = offset - offset % page_size;
+                start = data + page_offset;
+                page_length = offset + length - page_offset;
+            }
+        } // namespace
+
+        MappedFile::MappedFile(const string &path)
+        {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                throw runtime_error("failed to open file");
+            }
+
+            struct stat file_stat;
+            if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+            {
+                close(fd);
+                throw runtime_error("failed to read file size");
+            }
+            size_ = static_cast<size_t>(file_stat.st_size);
+
+            // A private writable mapping turns writes into page copies instead of faults
+            void *addr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+            // The mapping stays valid after the descriptor is closed
+            close(fd);
+            if (addr == MAP_FAILED)
+            {
+                throw runtime_error("failed to map file");
+            }
+            data_ = static_cast<seal_byte *>(addr);
+        }
+
+        MappedFile::~MappedFile()
+        {
+            if (data_)
+            {
+                munmap(data_, size_);
+            }
+        }
+
+        void MappedFile::prefetch(size_t offset, size_t length) const noexcept
+        {
+            void *start;
+            size_t page_length;
+            page_range(data_, size_, offset, length, start, page_length);
+            if (page_length)
+            {
+                madvise(start, page_length, MADV_WILLNEED);
+            }
+        }
+
+        void MappedFile::evict(size_t offset, size_t length) const noexcept
+        {
+            void *start;
+            size_t page_length;
+            page_range(data_, size_, offset, length, start, page_length);
+            if (page_length)
+            {
+                madvise(start, page_length, MADV_DONTNEED);
+            }
+        }
+#else
+        MappedFile::MappedFile(SEAL_MAYBE_UNUSED const string &path)
+        {
+            throw logic_error("memory mapping is not supported");
+        }
+
+        MappedFile::~MappedFile()
+        {}
+
+        void MappedFile::prefetch(SEAL_MAYBE_UNUSED size_t offset, SEAL_MAYBE_UNUSED size_t length) const noexcept
+        {}
+
+        void MappedFile::evict(SEAL_MAYBE_UNUSED size_t offset, SEAL_MAYBE_UNUSED size_t length) const noexcept
+        {}
+#endif
+    } // namespace util
+} // namespace seal
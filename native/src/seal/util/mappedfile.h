@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/util/defines.h"
+#include <cstddef>
+#include <string>
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        A copy-on-write memory mapping of an entire file. Unmodified pages come from
+        the page cache, so processes mapping the same file share them. Writing to the
+        mapping gives this process a private copy of the written page; the file itself
+        is never modified. Pages are loaded on first access and can be released again
+        with evict, in which case they are transparently reloaded from the file when
+        accessed next and any writes to them are discarded.
+        */
+        class MappedFile
+        {
+        public:
+            /**
+            Maps the file at the given path into memory.
+
+            @param[in] path The path of the file to map
+            @throws std::logic_error if memory mapping is not supported on this platform
+            @throws std::runtime_error if the file cannot be opened or mapped
+            */
+            explicit MappedFile(const std::string &path);
+
+            ~MappedFile();
+
+            SEAL_NODISCARD inline seal_byte *data() noexcept
+            {
+                return data_;
+            }
+
+            SEAL_NODISCARD inline const seal_byte *data() const noexcept
+            {
+                return data_;
+            }
+
+            SEAL_NODISCARD inline std::size_t size() const noexcept
+            {
+                return size_;
+            }
+
+            /**
+            Hints that the given byte range will be accessed soon.
+            */
+            void prefetch(std::size_t offset, std::size_t length) const noexcept;
+
+            /**
+            Releases the pages backing the given byte range. The pages are read back
+            from the file if the range is accessed again, so writes to them are lost.
+            */
+            void evict(std::size_t offset, std::size_t length) const noexcept;
+
+        private:
+            MappedFile(const MappedFile &copy) = delete;
+
+            MappedFile &operator=(const MappedFile &assign) = delete;
+
+            seal_byte *data_ = nullptr;
+
+            std::size_t size_ = 0;
+        };
+    } // namespace util
+} // namespace seal
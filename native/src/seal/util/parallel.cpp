@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/parallel.h"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        void run_workers(size_t worker_count, const function<void(size_t)> &work)
+        {
+            vector<exception_ptr> errors(worker_count);
+            vector<thread> workers;
+            try
+            {
+                for (size_t t = 0; t < worker_count; t++)
+                {
+                    workers.emplace_back([&, t] {
+                        try
+                        {
+                            work(t);
+                        }
+                        catch (...)
+                        {
+                            errors[t] = current_exception();
+                        }
+                    });
+                }
+            }
+            catch (...)
+            {
+                // Destroying a joinable std::thread terminates, so wait for the workers already started
+                for (auto &worker : workers)
+                {
+                    worker.join();
+                }
+                throw;
+            }
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+            for (auto &error : errors)
+            {
+                if (error)
+                {
+                    rethrow_exception(error);
+                }
+            }
+        }
+
+        void parallel_for(
+            size_t count, size_t thread_count, MemoryPoolHandle pool,
+            const function<void(size_t, MemoryPoolHandle)> &work)
+        {
+            if (thread_count == 0)
+            {
+                throw invalid_argument("thread_count must be positive");
+            }
+
+            size_t worker_count = min(thread_count, count);
+            if (worker_count <= 1)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    work(i, pool);
+                }
+                return;
+            }
+
+            run_workers(worker_count, [&](size_t t) {
+                auto worker_pool = MemoryPoolHandle::New();
+                for (size_t i = t; i < count; i += worker_count)
+                {
+                    work(i, worker_pool);
+                }
+            });
+        }
+    } // namespace util
+} // namespace seal
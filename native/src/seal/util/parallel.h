@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/memorymanager.h"
+#include "seal/util/defines.h"
+#include <cstddef>
+#include <functional>
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Runs work(t) for t = 0, ..., worker_count - 1 on separate threads, waits for all of them, and rethrows the
+        first exception thrown by any of them.
+        */
+        void run_workers(std::size_t worker_count, const std::function<void(std::size_t)> &work);
+
+        /**
+        Runs work(i, pool) for i = 0, ..., count - 1 on up to thread_count threads, which take the indices in turns.
+        Each thread allocates from its own new memory pool, so the memory freed by the work on one index is reused
+        for the next. When only one thread is needed, the work runs on the calling thread with the given pool.
+
+        @throws std::invalid_argument if thread_count is zero
+        */
+        void parallel_for(
+            std::size_t count, std::size_t thread_count, MemoryPoolHandle pool,
+            const std::function<void(std::size_t, MemoryPoolHandle)> &work);
+    } // namespace util
+} // namespace seal
@@ -11,6 +11,10 @@
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/polycore.h"
 #include "seal/util/rlwe.h"
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -37,6 +41,38 @@ namespace seal
             });
         }
 
+        void sample_poly_ternary_sparse(
+            shared_ptr<UniformRandomGenerator> prng, const EncryptionParameters &parms, size_t hamming_weight,
+            uint64_t *destination)
+        {
+            auto coeff_modulus = parms.coeff_modulus();
+            size_t coeff_modulus_size = coeff_modulus.size();
+            size_t coeff_count = parms.poly_modulus_degree();
+            if (hamming_weight > coeff_count)
+            {
+                throw invalid_argument("hamming_weight is too large");
+            }
+
+            RandomToStandardAdapter engine(prng);
+            uniform_int_distribution<uint64_t> sign_dist(0, 1);
+
+            // The first hamming_weight entries of a partial Fisher-Yates shuffle are the nonzero positions
+            vector<size_t> positions(coeff_count);
+            iota(positions.begin(), positions.end(), size_t(0));
+            set_zero_poly(coeff_count, coeff_modulus_size, destination);
+            for (size_t i = 0; i < hamming_weight; i++)
+            {
+                uniform_int_distribution<size_t> position_dist(i, coeff_count - 1);
+                swap(positions[i], positions[position_dist(engine)]);
+
+                uint64_t negative = sign_dist(engine);
+                SEAL_ITERATE(
+                    iter(StrideIter<uint64_t *>(destination + positions[i], coeff_count), coeff_modulus),
+                    coeff_modulus_size,
+                    [&](auto J) { *get<0>(J) = negative ? get<1>(J).value() - 1 : 1; });
+            }
+        }
+
         void sample_poly_normal(
             shared_ptr<UniformRandomGenerator> prng, const EncryptionParameters &parms, uint64_t *destination)
         {
@@ -184,6 +220,7 @@ namespace seal
             destination.resize(context, parms_id, encrypted_size);
             destination.is_ntt_form() = is_ntt_form;
             destination.scale() = 1.0;
+            destination.correction_factor() = 1;
 
             // c[j] = public_key[j] * u + e[j] where e[j] <-- chi, u <-- R_3
 
@@ -219,6 +256,14 @@ namespace seal
                 SEAL_NOISE_SAMPLER(prng, parms, u.get());
                 for (size_t i = 0; i < coeff_modulus_size; i++)
                 {
+                    // In BGV the noise is a multiple of the plain modulus
+                    if (parms.scheme() == scheme_type::bgv)
+                    {
+                        multiply_poly_scalar_coeffmod(
+                            u.get() + i * coeff_count, coeff_count, parms.plain_modulus().value(), coeff_modulus[i],
+                            u.get() + i * coeff_count);
+                    }
+
                     // Addition with e_0, e_1 is in NTT form
                     if (is_ntt_form)
                     {
@@ -269,6 +314,7 @@ namespace seal
             destination.resize(context, parms_id, encrypted_size);
             destination.is_ntt_form() = is_ntt_form;
             destination.scale() = 1.0;
+            destination.correction_factor() = 1;
 
             // Create an instance of a random number generator. We use this for sampling
             // a seed for a second PRNG used for sampling u (the seed can be public
@@ -313,6 +359,15 @@ namespace seal
                 dyadic_product_coeffmod(
                     secret_key.data().data() + i * coeff_count, c1 + i * coeff_count, coeff_count, coeff_modulus[i],
                     c0 + i * coeff_count);
+
+                // In BGV the noise is a multiple of the plain modulus
+                if (parms.scheme() == scheme_type::bgv)
+                {
+                    multiply_poly_scalar_coeffmod(
+                        noise.get() + i * coeff_count, coeff_count, parms.plain_modulus().value(), coeff_modulus[i],
+                        noise.get() + i * coeff_count);
+                }
+
                 if (is_ntt_form)
                 {
                     // Transform the noise e into NTT representation
@@ -8,6 +8,7 @@
 #include "seal/util/uintarithmod.h"
 #include "seal/util/uintarithsmallmod.h"
 #include <algorithm>
+#include <cmath>
 
 using namespace std;
 
@@ -462,6 +463,51 @@ namespace seal
             });
         }
 
+        void BaseConverter::exact_convert_array(ConstRNSIter in, CoeffIter out, MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (obase_.size() != 1)
+            {
+                throw invalid_argument("out base in exact_convert_array must be one");
+            }
+#endif
+            size_t ibase_size = ibase_.size();
+            size_t count = in.poly_modulus_degree();
+            const Modulus &p = obase_[0];
+
+            // prod(ibase) mod p
+            uint64_t q_mod_p = modulo_uint(ibase_.base_prod(), ibase_size, p);
+
+            // Note that the stride size is ibase_size
+            SEAL_ALLOCATE_GET_STRIDE_ITER(temp, uint64_t, count, ibase_size, pool);
+            auto v = allocate<double>(count, pool);
+            fill_n(v.get(), count, 0.0);
+
+            SEAL_ITERATE(
+                iter(in, ibase_.inv_punctured_prod_mod_base_array(), ibase_.base(), size_t(0)), ibase_size,
+                [&](auto I) {
+                    // The current ibase index
+                    size_t ibase_index = get<3>(I);
+                    double divisor = static_cast<double>(get<2>(I).value());
+
+                    SEAL_ITERATE(iter(get<0>(I), temp, v.get()), count, [&](auto J) {
+                        // y_i = x_i * (q / q_i)^(-1) mod q_i
+                        uint64_t y = multiply_uint_mod(get<0>(J), get<1>(I), get<2>(I));
+                        get<1>(J)[ibase_index] = y;
+
+                        // Accumulate y_i / q_i; rounding the sum gives the multiple of q to subtract
+                        get<2>(J) += static_cast<double>(y) / divisor;
+                    });
+                });
+
+            SEAL_ITERATE(iter(out, temp, v.get()), count, [&](auto I) {
+                // sum(y_i * (q / q_i)) - round(sum(y_i / q_i)) * q mod p
+                uint64_t sum = dot_product_mod(get<1>(I), base_change_matrix_[0].get(), ibase_size, p);
+                uint64_t correction = barrett_reduce_64(static_cast<uint64_t>(round(get<2>(I))), p);
+                get<0>(I) = sub_uint_mod(sum, multiply_uint_mod(correction, q_mod_p, p), p);
+            });
+        }
+
         void BaseConverter::initialize()
         {
             // Verify that the size is not too large
@@ -598,6 +644,9 @@ namespace seal
             {
                 // Set up BaseConverter for q --> {t, gamma}
                 base_q_to_t_gamma_conv_ = allocate<BaseConverter>(pool_, *base_q_, *base_t_gamma_, pool_);
+
+                // Set up BaseConverter for q --> {t}
+                base_q_to_t_conv_ = allocate<BaseConverter>(pool_, *base_q_, RNSBase({ t_ }, pool_), pool_);
             }
 
             // Compute prod(B) mod q
@@ -691,6 +740,17 @@ namespace seal
                 }
                 get<0>(I).set(temp, get<1>(I));
             });
+
+            if (!t_.is_zero())
+            {
+                // Compute q[last]^(-1) mod t
+                // This is used by BGV modulus switching
+                if (!try_invert_uint_mod(barrett_reduce_64((*base_q_)[base_q_size - 1].value(), t_), t_, temp))
+                {
+                    throw logic_error("invalid rns bases");
+                }
+                inv_q_last_mod_t_.set(temp, t_);
+            }
         }
 
         void RNSTool::divide_and_round_q_last_inplace(RNSIter input, MemoryPoolHandle pool) const
@@ -807,6 +867,79 @@ namespace seal
             });
         }
 
+        void RNSTool::mod_t_and_divide_q_last_ntt_inplace(
+            RNSIter input, ConstNTTTablesIter rns_ntt_tables, MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (!input)
+            {
+                throw invalid_argument("input cannot be null");
+            }
+            if (input.poly_modulus_degree() != coeff_count_)
+            {
+                throw invalid_argument("input is not valid for encryption parameters");
+            }
+            if (!rns_ntt_tables)
+            {
+                throw invalid_argument("rns_ntt_tables cannot be null");
+            }
+            if (!pool)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+#endif
+            size_t base_q_size = base_q_->size();
+            CoeffIter last_input = input[base_q_size - 1];
+
+            // Convert to non-NTT form
+            inverse_ntt_negacyclic_harvey(last_input, rns_ntt_tables[base_q_size - 1]);
+
+            // With c the centered representative of the last component, find k = -c * q[last]^(-1) mod t in the
+            // centered range, so that delta = c + q[last] * k is small, divisible by t, and congruent to c mod q[last]
+            Modulus last_modulus = (*base_q_)[base_q_size - 1];
+            uint64_t last_half = last_modulus.value() >> 1;
+            uint64_t t_half = t_.value() >> 1;
+            uint64_t last_mod_t = barrett_reduce_64(last_modulus.value(), t_);
+            SEAL_ALLOCATE_GET_COEFF_ITER(k, coeff_count_, pool);
+            SEAL_ITERATE(iter(last_input, k), coeff_count_, [&](auto I) {
+                uint64_t c_mod_t = barrett_reduce_64(get<0>(I), t_);
+                if (get<0>(I) > last_half)
+                {
+                    c_mod_t = sub_uint_mod(c_mod_t, last_mod_t, t_);
+                }
+                get<1>(I) = multiply_uint_mod(negate_uint_mod(c_mod_t, t_), inv_q_last_mod_t_, t_);
+            });
+
+            SEAL_ALLOCATE_GET_COEFF_ITER(delta, coeff_count_, pool);
+            SEAL_ITERATE(iter(input, inv_q_last_mod_q_, base_q_->base(), rns_ntt_tables), base_q_size - 1, [&](auto I) {
+                const Modulus &qi = get<2>(I);
+                uint64_t last_mod_qi = barrett_reduce_64(last_modulus.value(), qi);
+                uint64_t t_mod_qi = barrett_reduce_64(t_.value(), qi);
+                MultiplyUIntModOperand last_mod_qi_operand;
+                last_mod_qi_operand.set(last_mod_qi, qi);
+
+                // delta mod qi in non-NTT form
+                SEAL_ITERATE(iter(last_input, k, delta), coeff_count_, [&](auto J) {
+                    uint64_t c = barrett_reduce_64(get<0>(J), qi);
+                    if (get<0>(J) > last_half)
+                    {
+                        c = sub_uint_mod(c, last_mod_qi, qi);
+                    }
+                    uint64_t k_mod_qi = barrett_reduce_64(get<1>(J), qi);
+                    if (get<1>(J) > t_half)
+                    {
+                        k_mod_qi = sub_uint_mod(k_mod_qi, t_mod_qi, qi);
+                    }
+                    get<2>(J) = add_uint_mod(c, multiply_uint_mod(k_mod_qi, last_mod_qi_operand, qi), qi);
+                });
+                ntt_negacyclic_harvey(delta, get<3>(I));
+
+                // qk^(-1) * ((ct mod qi) - delta) mod qi
+                sub_poly_coeffmod(get<0>(I), delta, coeff_count_, qi, get<0>(I));
+                multiply_poly_scalar_coeffmod(get<0>(I), coeff_count_, get<1>(I), qi, get<0>(I));
+            });
+        }
+
         void RNSTool::fastbconv_sk(ConstRNSIter input, RNSIter destination, MemoryPoolHandle pool) const
         {
 #ifdef SEAL_DEBUG
@@ -1106,5 +1239,29 @@ namespace seal
                 }
             });
         }
+
+        void RNSTool::decrypt_modt(ConstRNSIter phase, CoeffIter destination, MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (phase == nullptr)
+            {
+                throw invalid_argument("phase cannot be null");
+            }
+            if (phase.poly_modulus_degree() != coeff_count_)
+            {
+                throw invalid_argument("phase is not valid for encryption parameters");
+            }
+            if (!destination)
+            {
+                throw invalid_argument("destination cannot be null");
+            }
+            if (!pool)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+#endif
+            // Use exact base conversion rather than convert the centered representative to a multi-precision integer
+            base_q_to_t_conv_->exact_convert_array(phase, destination, pool);
+        }
     } // namespace util
 } // namespace seal
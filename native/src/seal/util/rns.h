@@ -164,6 +164,11 @@ namespace seal
 
             void fast_convert_array(ConstRNSIter in, RNSIter out, MemoryPoolHandle pool) const;
 
+            /**
+            Exact conversion of the centered representatives of the input to an output base of size one
+            */
+            void exact_convert_array(ConstRNSIter in, CoeffIter out, MemoryPoolHandle pool) const;
+
         private:
             BaseConverter(const BaseConverter &copy) = delete;
 
@@ -204,6 +209,13 @@ namespace seal
             void divide_and_round_q_last_ntt_inplace(
                 RNSIter input, ConstNTTTablesIter rns_ntt_tables, MemoryPoolHandle pool) const;
 
+            /**
+            Subtract a multiple of t that is congruent to the input modulo q[last], and divide by q[last]. The input
+            plaintext modulo t is multiplied by q[last]^(-1) mod t. This is the BGV modulus switching.
+            */
+            void mod_t_and_divide_q_last_ntt_inplace(
+                RNSIter input, ConstNTTTablesIter rns_ntt_tables, MemoryPoolHandle pool) const;
+
             /**
             Shenoy-Kumaresan conversion from Bsk to q
             */
@@ -229,11 +241,21 @@ namespace seal
             */
             void decrypt_scale_and_round(ConstRNSIter phase, CoeffIter destination, MemoryPoolHandle pool) const;
 
+            /**
+            Compute |input|_q mod t exactly, where |input|_q is the centered representative
+            */
+            void decrypt_modt(ConstRNSIter phase, CoeffIter destination, MemoryPoolHandle pool) const;
+
             SEAL_NODISCARD inline auto inv_q_last_mod_q() const noexcept
             {
                 return inv_q_last_mod_q_.get();
             }
 
+            SEAL_NODISCARD inline auto &inv_q_last_mod_t() const noexcept
+            {
+                return inv_q_last_mod_t_;
+            }
+
             SEAL_NODISCARD inline auto base_Bsk_ntt_tables() const noexcept
             {
                 return base_Bsk_ntt_tables_.get();
@@ -327,6 +349,9 @@ namespace seal
             // Base converter: q --> {t, gamma}
             Pointer<BaseConverter> base_q_to_t_gamma_conv_;
 
+            // Base converter: q --> {t}
+            Pointer<BaseConverter> base_q_to_t_conv_;
+
             // prod(q)^(-1) mod Bsk
             Pointer<MultiplyUIntModOperand> inv_prod_q_mod_Bsk_;
 
@@ -357,6 +382,9 @@ namespace seal
             // q[last]^(-1) mod q[i] for i = 0..last-1
             Pointer<MultiplyUIntModOperand> inv_q_last_mod_q_;
 
+            // q[last]^(-1) mod t
+            MultiplyUIntModOperand inv_q_last_mod_t_;
+
             // NTTTables for Bsk
             Pointer<NTTTables> base_Bsk_ntt_tables_;
 
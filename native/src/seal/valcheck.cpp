@@ -101,6 +101,17 @@ namespace seal
             return false;
         }
 
+        // Check that correction_factor is 1 in BFV and CKKS, and non-zero and reduced modulo plain_modulus in BGV
+        auto &parms = context_data_ptr->parms();
+        uint64_t correction_factor = in.correction_factor();
+        bool is_correction_factor_valid = parms.scheme() == scheme_type::bgv
+                                              ? correction_factor && correction_factor < parms.plain_modulus().value()
+                                              : correction_factor == 1;
+        if (!is_correction_factor_valid)
+        {
+            return false;
+        }
+
         return true;
     }
 
@@ -3,10 +3,15 @@
 
 #include "seal/batchencoder.h"
 #include "seal/context.h"
+#include "seal/evaluator.h"
 #include "seal/keygenerator.h"
 #include "seal/modulus.h"
+#include <algorithm>
 #include <vector>
 #include "gtest/gtest.h"
+#ifdef SEAL_USE_MSGSL
+#include "gsl/span"
+#endif
 
 using namespace seal;
 using namespace seal::util;
@@ -119,4 +124,166 @@ namespace sealtest
             ASSERT_EQ(0ULL, short_plain_vec2[i]);
         }
     }
+
+    TEST(BatchEncoderTest, BatchUnbatchMany)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 60 }));
+        parms.set_plain_modulus(257);
+
+        SEALContext context(parms, false, sec_level_type::none);
+        BatchEncoder batch_encoder(context);
+
+        vector<vector<uint64_t>> values;
+        vector<vector<int64_t>> values_signed;
+        for (size_t k = 0; k < 5; k++)
+        {
+            // Include a short and an empty matrix
+            size_t size = (k == 1) ? 20 : (k == 3) ? 0 : batch_encoder.slot_count();
+            values.emplace_back();
+            values_signed.emplace_back();
+            for (size_t i = 0; i < size; i++)
+            {
+                values.back().push_back((k * 64 + i) % 257);
+                values_signed.back().push_back(static_cast<int64_t>((k * 64 + i) % 129) * ((i & 1) ? -1 : 1));
+            }
+        }
+
+        for (size_t thread_count : { 1, 3 })
+        {
+            vector<Plaintext> plains;
+            batch_encoder.encode_many(values, plains, thread_count);
+            ASSERT_EQ(values.size(), plains.size());
+            vector<vector<uint64_t>> decoded;
+            batch_encoder.decode_many(plains, decoded, thread_count);
+            ASSERT_EQ(values.size(), decoded.size());
+            for (size_t k = 0; k < values.size(); k++)
+            {
+                Plaintext plain;
+                batch_encoder.encode(values[k], plain);
+                ASSERT_TRUE(plain == plains[k]);
+                vector<uint64_t> expected(values[k]);
+                expected.resize(batch_encoder.slot_count());
+                ASSERT_TRUE(expected == decoded[k]);
+            }
+
+            batch_encoder.encode_many(values_signed, plains, thread_count);
+            vector<vector<int64_t>> decoded_signed;
+            batch_encoder.decode_many(plains, decoded_signed, thread_count);
+            for (size_t k = 0; k < values_signed.size(); k++)
+            {
+                Plaintext plain;
+                batch_encoder.encode(values_signed[k], plain);
+                ASSERT_TRUE(plain == plains[k]);
+                vector<int64_t> expected(values_signed[k]);
+                expected.resize(batch_encoder.slot_count());
+                ASSERT_TRUE(expected == decoded_signed[k]);
+            }
+        }
+
+        vector<Plaintext> plains;
+        ASSERT_THROW(batch_encoder.encode_many(values, plains, 0), invalid_argument);
+        values[2].resize(batch_encoder.slot_count() + 1);
+        ASSERT_THROW(batch_encoder.encode_many(values, plains), logic_error);
+    }
+#ifdef SEAL_USE_MSGSL
+    TEST(BatchEncoderTest, BatchToSpan)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 60 }));
+        parms.set_plain_modulus(257);
+
+        SEALContext context(parms, false, sec_level_type::none);
+        BatchEncoder batch_encoder(context);
+        size_t slots = batch_encoder.slot_count();
+
+        // Short matrices are padded with zeros as in encode to a Plaintext
+        vector<uint64_t> values;
+        vector<int64_t> values_signed;
+        for (size_t i = 0; i < slots - 5; i++)
+        {
+            values.push_back((i * 7) % 257);
+            values_signed.push_back(static_cast<int64_t>(i % 129) * ((i & 1) ? -1 : 1));
+        }
+
+        // Write into the middle of a larger buffer; the rest must stay untouched
+        vector<uint64_t> buffer(3 * slots, 0xFFFFFFFFFFFFFFFFULL);
+        gsl::span<uint64_t> destination(buffer.data() + slots, slots);
+        Plaintext plain;
+        batch_encoder.encode(values, plain);
+        batch_encoder.encode(gsl::span<const uint64_t>(values), destination);
+        ASSERT_TRUE(equal(plain.data(), plain.data() + slots, destination.data()));
+        batch_encoder.encode(values_signed, plain);
+        batch_encoder.encode(gsl::span<const int64_t>(values_signed), destination);
+        ASSERT_TRUE(equal(plain.data(), plain.data() + slots, destination.data()));
+        ASSERT_TRUE(all_of(buffer.begin(), buffer.begin() + static_cast<ptrdiff_t>(slots), [](uint64_t value) {
+            return value == 0xFFFFFFFFFFFFFFFFULL;
+        }));
+        ASSERT_TRUE(all_of(buffer.end() - static_cast<ptrdiff_t>(slots), buffer.end(), [](uint64_t value) {
+            return value == 0xFFFFFFFFFFFFFFFFULL;
+        }));
+
+        ASSERT_THROW(
+            batch_encoder.encode(gsl::span<const uint64_t>(values), gsl::span<uint64_t>(buffer.data(), slots - 1)),
+            invalid_argument);
+        ASSERT_THROW(
+            batch_encoder.encode(
+                gsl::span<const int64_t>(values_signed), gsl::span<uint64_t>(buffer.data(), slots + 1)),
+            invalid_argument);
+        values.resize(slots + 1);
+        ASSERT_THROW(batch_encoder.encode(gsl::span<const uint64_t>(values), destination), logic_error);
+    }
+#endif
+
+    TEST(BatchEncoderTest, BatchToNTTForm)
+    {
+        auto test = [](uint64_t plain_modulus, vector<int> coeff_bit_sizes) {
+            EncryptionParameters parms(scheme_type::bfv);
+            parms.set_poly_modulus_degree(64);
+            parms.set_coeff_modulus(CoeffModulus::Create(64, coeff_bit_sizes));
+            parms.set_plain_modulus(plain_modulus);
+
+            SEALContext context(parms, true, sec_level_type::none);
+            BatchEncoder batch_encoder(context);
+            Evaluator evaluator(context);
+            uint64_t modulus = context.first_context_data()->parms().plain_modulus().value();
+
+            vector<uint64_t> plain_vec;
+            vector<int64_t> plain_vec_signed;
+            for (size_t i = 0; i < batch_encoder.slot_count(); i++)
+            {
+                plain_vec.push_back((i * 0x9E3779B97F4A7C15ULL) % modulus);
+                plain_vec_signed.push_back(static_cast<int64_t>(plain_vec[i] >> 1) * ((i & 1) ? -1 : 1));
+            }
+
+            for (auto context_data = context.key_context_data(); context_data;
+                 context_data = context_data->next_context_data())
+            {
+                auto parms_id = context_data->parms_id();
+                Plaintext plain, expected;
+                batch_encoder.encode(plain_vec, expected);
+                evaluator.transform_to_ntt_inplace(expected, parms_id);
+                batch_encoder.encode(plain_vec, parms_id, plain);
+                ASSERT_TRUE(plain.is_ntt_form());
+                ASSERT_TRUE(plain.parms_id() == parms_id);
+                ASSERT_TRUE(plain == expected);
+
+                batch_encoder.encode(plain_vec_signed, expected);
+                evaluator.transform_to_ntt_inplace(expected, parms_id);
+                batch_encoder.encode(plain_vec_signed, parms_id, plain);
+                ASSERT_TRUE(plain == expected);
+            }
+
+            Plaintext plain;
+            ASSERT_THROW(batch_encoder.encode(plain_vec, parms_id_zero, plain), invalid_argument);
+        };
+
+        // Plaintext modulus smaller than the coefficient modulus primes (fast plain lift)
+        test(257, { 40, 40, 40 });
+
+        // Plaintext modulus larger than the coefficient modulus primes
+        test(PlainModulus::Batching(64, 40).value(), { 30, 30, 30 });
+    }
 } // namespace sealtest
@@ -125,5 +125,28 @@ namespace sealtest
         ASSERT_TRUE(
             is_equal_uint(ctxt.data(), ctxt2.data(), parms.poly_modulus_degree() * parms.coeff_modulus().size() * 2));
         ASSERT_TRUE(ctxt.data() != ctxt2.data());
+
+        // The correction factor of BGV ciphertexts is saved as well
+        parms = EncryptionParameters(scheme_type::bgv);
+        parms.set_poly_modulus_degree(1024);
+        parms.set_coeff_modulus(CoeffModulus::BFVDefault(1024));
+        parms.set_plain_modulus(0xF0F1);
+        context = SEALContext(parms, false);
+        KeyGenerator keygen2(context);
+        keygen2.create_public_key(pk);
+        Encryptor encryptor2(context, pk);
+        encryptor2.encrypt(Plaintext("Ax^10 + 9x^9 + 1"), ctxt);
+        ctxt.correction_factor() = 0xF0F0;
+        ctxt.save(stream);
+        ctxt2.load(context, stream);
+        ASSERT_TRUE(ctxt2.is_ntt_form());
+        ASSERT_EQ(0xF0F0ULL, ctxt2.correction_factor());
+        ASSERT_TRUE(
+            is_equal_uint(ctxt.data(), ctxt2.data(), parms.poly_modulus_degree() * parms.coeff_modulus().size() * 2));
+
+        // Correction factors that are not reduced modulo the plaintext modulus are rejected
+        ctxt.correction_factor() = 0xF0F1;
+        ctxt.save(stream);
+        ASSERT_THROW(ctxt2.load(context, stream), logic_error);
     }
 } // namespace sealtest
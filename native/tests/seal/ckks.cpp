@@ -244,6 +244,238 @@ namespace sealtest
                 }
             }
         }
+        {
+            // Coefficients that need reduction modulo some of the primes but not others
+            size_t slots = 32;
+            parms.set_poly_modulus_degree(slots << 1);
+            parms.set_coeff_modulus(CoeffModulus::Create(slots << 1, { 30, 40, 60 }));
+            SEALContext context(parms, false, sec_level_type::none);
+
+            vector<complex<double>> values(slots);
+            for (size_t i = 0; i < slots; i++)
+            {
+                values[i] = complex<double>(static_cast<double>(i) - 16, static_cast<double>(i % 5));
+            }
+
+            CKKSEncoder encoder(context);
+            double delta = pow(2.0, 45);
+            Plaintext plain;
+            encoder.encode(values, context.first_parms_id(), delta, plain);
+            vector<complex<double>> result;
+            encoder.decode(plain, result);
+
+            for (size_t i = 0; i < slots; ++i)
+            {
+                ASSERT_NEAR(0.0, abs(values[i] - result[i]), 1e-6);
+            }
+        }
+    }
+
+    TEST(CKKSEncoderTest, CKKSEncoderSmallDegreeTest)
+    {
+        // Small degrees exercise the shortest transforms, down to a single slot
+        for (size_t slots : { 1, 2, 4, 8 })
+        {
+            EncryptionParameters parms(scheme_type::ckks);
+            parms.set_poly_modulus_degree(slots << 1);
+            parms.set_coeff_modulus(CoeffModulus::Create(slots << 1, { 40, 40 }));
+            SEALContext context(parms, false, sec_level_type::none);
+            CKKSEncoder encoder(context);
+            double delta = (1ULL << 30);
+
+            vector<complex<double>> values(slots);
+            vector<double> real_values(slots);
+            for (size_t i = 0; i < slots; i++)
+            {
+                values[i] = complex<double>(static_cast<double>(i) + 1, 2 - static_cast<double>(i) / 3);
+                real_values[i] = values[i].real();
+            }
+
+            Plaintext plain;
+            vector<complex<double>> result;
+            encoder.encode(values, delta, plain);
+            encoder.decode(plain, result);
+            for (size_t i = 0; i < slots; i++)
+            {
+                ASSERT_NEAR(0.0, abs(values[i] - result[i]), 1e-6);
+            }
+
+            // Real inputs encode to the same plaintext as complex inputs with zero imaginary parts
+            Plaintext real_plain;
+            vector<double> real_result;
+            encoder.encode(real_values, delta, real_plain);
+            encoder.encode(vector<complex<double>>(real_values.begin(), real_values.end()), delta, plain);
+            ASSERT_TRUE(real_plain == plain);
+            encoder.decode(real_plain, result);
+            encoder.decode(real_plain, real_result);
+            for (size_t i = 0; i < slots; i++)
+            {
+                ASSERT_NEAR(real_values[i], real_result[i], 1e-6);
+                ASSERT_NEAR(0.0, result[i].imag(), 1e-6);
+            }
+        }
+    }
+
+    TEST(CKKSEncoderTest, CKKSEncoderEncodeBatchTest)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slots = 32;
+        parms.set_poly_modulus_degree(slots << 1);
+        parms.set_coeff_modulus(CoeffModulus::Create(slots << 1, { 40, 40, 40 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        CKKSEncoder encoder(context);
+        double delta = (1ULL << 30);
+        auto parms_id = context.first_context_data()->next_context_data()->parms_id();
+
+        vector<vector<double>> values(7);
+        for (size_t k = 0; k < values.size(); k++)
+        {
+            // Vectors of different sizes, including an empty one
+            values[k].resize(k * 5);
+            for (size_t i = 0; i < values[k].size(); i++)
+            {
+                values[k][i] = static_cast<double>(k) - static_cast<double>(i) / 4;
+            }
+        }
+
+        for (size_t thread_count : { 1, 3, 16 })
+        {
+            vector<Plaintext> plains;
+            encoder.encode_batch(values, parms_id, delta, plains, thread_count);
+            ASSERT_EQ(values.size(), plains.size());
+            for (size_t k = 0; k < values.size(); k++)
+            {
+                Plaintext expected;
+                encoder.encode(values[k], parms_id, delta, expected);
+                ASSERT_TRUE(expected == plains[k]);
+                ASSERT_TRUE(parms_id == plains[k].parms_id());
+                ASSERT_EQ(delta, plains[k].scale());
+            }
+        }
+
+        vector<vector<complex<double>>> complex_values{ { { 1, 2 }, { -3, 0.5 } }, { { 0, -1 } } };
+        vector<Plaintext> plains;
+        encoder.encode_batch(complex_values, delta, plains, 2);
+        ASSERT_EQ(2ULL, plains.size());
+        for (size_t k = 0; k < complex_values.size(); k++)
+        {
+            vector<complex<double>> result;
+            encoder.decode(plains[k], result);
+            for (size_t i = 0; i < complex_values[k].size(); i++)
+            {
+                ASSERT_NEAR(0.0, abs(complex_values[k][i] - result[i]), 1e-6);
+            }
+        }
+
+        encoder.encode_batch(vector<vector<double>>{}, delta, plains);
+        ASSERT_TRUE(plains.empty());
+
+        values.push_back(vector<double>(slots + 1));
+        ASSERT_THROW(encoder.encode_batch(values, delta, plains, 2), invalid_argument);
+        values.pop_back();
+        ASSERT_THROW(encoder.encode_batch(values, delta, plains, 0), invalid_argument);
+        ASSERT_THROW(encoder.encode_batch(values, parms_id_zero, delta, plains), invalid_argument);
+        ASSERT_THROW(encoder.encode_batch(values, 0.0, plains), invalid_argument);
+    }
+
+    TEST(CKKSEncoderTest, CKKSEncoderDecodeSlotsTest)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slots = 512;
+        parms.set_poly_modulus_degree(slots << 1);
+        parms.set_coeff_modulus(CoeffModulus::Create(slots << 1, { 50, 40, 40 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        CKKSEncoder encoder(context);
+        double delta = (1ULL << 35);
+
+        vector<complex<double>> values(slots);
+        srand(static_cast<unsigned>(time(NULL)));
+        for (size_t i = 0; i < slots; i++)
+        {
+            values[i] = complex<double>(
+                static_cast<double>(rand() % 32) - 16.0, static_cast<double>(rand() % 32) / 8.0);
+        }
+
+        for (auto context_data = context.first_context_data(); context_data;
+             context_data = context_data->next_context_data())
+        {
+            Plaintext plain;
+            encoder.encode(values, context_data->parms_id(), delta, plain);
+            vector<complex<double>> expected;
+            encoder.decode(plain, expected);
+
+            // A single slot and two slots are evaluated directly, the other ranges use the transform
+            vector<pair<size_t, size_t>> ranges{ { 0, 1 }, { 7, 2 }, { 3, 40 }, { slots - 5, 5 }, { 0, slots },
+                                                 { slots, 0 } };
+            for (auto &range : ranges)
+            {
+                vector<complex<double>> result;
+                encoder.decode(plain, result, range.first, range.second);
+                ASSERT_EQ(range.second, result.size());
+                vector<double> real_result;
+                encoder.decode(plain, real_result, range.first, range.second);
+                ASSERT_EQ(range.second, real_result.size());
+                for (size_t i = 0; i < range.second; i++)
+                {
+                    ASSERT_NEAR(0.0, abs(expected[range.first + i] - result[i]), 1e-6);
+                    ASSERT_NEAR(expected[range.first + i].real(), real_result[i], 1e-6);
+                }
+            }
+
+            vector<double> result;
+            ASSERT_THROW(encoder.decode(plain, result, 0, slots + 1), invalid_argument);
+            ASSERT_THROW(encoder.decode(plain, result, slots, 1), invalid_argument);
+            ASSERT_THROW(encoder.decode(plain, result, slots + 1, 0), invalid_argument);
+        }
+    }
+
+    TEST(CKKSEncoderTest, CKKSEncoderDecodeSmallModulusTest)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slots = 64;
+        parms.set_poly_modulus_degree(slots << 1);
+        parms.set_coeff_modulus(CoeffModulus::Create(slots << 1, { 60, 60, 60 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        CKKSEncoder encoder(context);
+
+        vector<complex<double>> values(slots);
+        srand(static_cast<unsigned>(time(NULL)));
+        for (size_t i = 0; i < slots; i++)
+        {
+            values[i] = complex<double>(
+                static_cast<double>(rand() % 2000) - 1000.0, static_cast<double>(rand() % 2000) / 4.0 - 250.0);
+        }
+
+        // Two primes and then one prime; the larger scale gives coefficients of more than 64 bits
+        auto first_parms_id = context.first_parms_id();
+        auto last_parms_id = context.last_parms_id();
+        ASSERT_EQ(2ULL, context.get_context_data(first_parms_id)->parms().coeff_modulus().size());
+        ASSERT_EQ(1ULL, context.get_context_data(last_parms_id)->parms().coeff_modulus().size());
+        for (auto &level : vector<pair<parms_id_type, double>>{
+                 { first_parms_id, pow(2.0, 40) }, { first_parms_id, pow(2.0, 80) }, { last_parms_id, pow(2.0, 40) } })
+        {
+            Plaintext plain;
+            encoder.encode(values, level.first, level.second, plain);
+
+            vector<complex<double>> result;
+            encoder.decode(plain, result);
+            vector<float> float_result;
+            encoder.decode(plain, float_result);
+            vector<complex<float>> complex_float_result;
+            encoder.decode(plain, complex_float_result);
+            ASSERT_EQ(slots, float_result.size());
+            ASSERT_EQ(slots, complex_float_result.size());
+            for (size_t i = 0; i < slots; i++)
+            {
+                ASSERT_NEAR(0.0, abs(values[i] - result[i]), 1e-6);
+                ASSERT_NEAR(values[i].real(), float_result[i], 1e-3);
+                ASSERT_NEAR(0.0, abs(complex<float>(values[i]) - complex_float_result[i]), 1e-3);
+            }
+
+            encoder.decode(plain, float_result, 5, 1);
+            ASSERT_EQ(1ULL, float_result.size());
+            ASSERT_NEAR(values[5].real(), float_result[0], 1e-3);
+        }
     }
 
     TEST(CKKSEncoderTest, CKKSEncoderEncodeSingleDecodeTest)
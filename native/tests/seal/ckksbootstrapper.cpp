@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/ckks.h"
+#include "seal/ckksbootstrapper.h"
+#include "seal/context.h"
+#include "seal/decryptor.h"
+#include "seal/encryptor.h"
+#include "seal/evaluator.h"
+#include "seal/keygenerator.h"
+#include "seal/modulus.h"
+#include "seal/util/ntt.h"
+#include "seal/util/polycore.h"
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+namespace sealtest
+{
+    TEST(CKKSBootstrapperTest, SparseSecretKey)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40 }));
+        SEALContext context(parms, true, sec_level_type::none);
+
+        ASSERT_THROW(KeyGenerator(context, 0), invalid_argument);
+        ASSERT_THROW(KeyGenerator(context, 65), invalid_argument);
+
+        for (size_t hamming_weight : { 1, 8, 64 })
+        {
+            KeyGenerator keygen(context, hamming_weight);
+            auto &key_context_data = *context.key_context_data();
+            auto &modulus = key_context_data.parms().coeff_modulus()[0];
+            auto poly = allocate_poly(64, 1, MemoryManager::GetPool());
+            set_poly(keygen.secret_key().data().data(), 64, 1, poly.get());
+            inverse_ntt_negacyclic_harvey(poly.get(), key_context_data.small_ntt_tables()[0]);
+
+            size_t nonzero_count = 0;
+            for (size_t i = 0; i < 64; i++)
+            {
+                if (poly[i])
+                {
+                    ASSERT_TRUE(poly[i] == 1 || poly[i] == modulus.value() - 1);
+                    nonzero_count++;
+                }
+            }
+            ASSERT_EQ(hamming_weight, nonzero_count);
+        }
+    }
+
+    TEST(CKKSBootstrapperTest, RotateVectorHoisted)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 60, 40, 40, 60 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(vector<int>{ 1, 3, -5, 0 }, glk);
+
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+        CKKSEncoder encoder(context);
+
+        vector<complex<double>> values(32);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = complex<double>(static_cast<double>(i) / 32, 1 - static_cast<double>(i) / 16);
+        }
+        Plaintext plain;
+        Ciphertext encrypted;
+        encoder.encode(values, context.first_context_data()->next_context_data()->parms_id(), pow(2.0, 40), plain);
+        encryptor.encrypt(plain, encrypted);
+
+        vector<int> steps{ 1, 0, 3, -5, 1 };
+        vector<Ciphertext> rotated;
+        evaluator.rotate_vector_hoisted(encrypted, steps, glk, rotated);
+        ASSERT_EQ(steps.size(), rotated.size());
+        for (size_t k = 0; k < steps.size(); k++)
+        {
+            Ciphertext expected;
+            evaluator.rotate_vector(encrypted, steps[k], glk, expected);
+            vector<complex<double>> result;
+            vector<complex<double>> expected_result;
+            decryptor.decrypt(rotated[k], plain);
+            encoder.decode(plain, result);
+            decryptor.decrypt(expected, plain);
+            encoder.decode(plain, expected_result);
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                ASSERT_NEAR(0, abs(result[i] - expected_result[i]), 0.001);
+            }
+        }
+
+        ASSERT_THROW(evaluator.rotate_vector_hoisted(encrypted, { 1, 2 }, glk, rotated), invalid_argument);
+    }
+
+    TEST(CKKSBootstrapperTest, Bootstrap)
+    {
+        size_t hamming_weight = 8;
+        EncryptionParameters parms(scheme_type::ckks);
+        parms.set_poly_modulus_degree(64);
+        vector<int> bit_sizes{ 60, 40 };
+        bit_sizes.insert(bit_sizes.end(), 12, 60);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, bit_sizes));
+        SEALContext context(parms, true, sec_level_type::none);
+
+        CKKSBootstrapper bootstrapper(context, hamming_weight);
+        ASSERT_EQ(127ULL, bootstrapper.sine_degree());
+        ASSERT_EQ(10ULL, bootstrapper.depth());
+
+        KeyGenerator keygen(context, hamming_weight);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(bootstrapper.galois_steps(), glk);
+
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+        CKKSEncoder encoder(context);
+
+        vector<complex<double>> values(32);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = complex<double>(sin(static_cast<double>(i)), cos(static_cast<double>(3 * i)));
+        }
+        Plaintext plain;
+        Ciphertext encrypted;
+        double scale = pow(2.0, 40);
+        encoder.encode(values, context.last_parms_id(), scale, plain);
+        encryptor.encrypt(plain, encrypted);
+
+        Ciphertext bootstrapped;
+        bootstrapper.bootstrap(encrypted, rlk, glk, bootstrapped);
+        ASSERT_EQ(scale, bootstrapped.scale());
+        ASSERT_TRUE(context.get_context_data(bootstrapped.parms_id())->chain_index() >= 1);
+
+        vector<complex<double>> result;
+        decryptor.decrypt(bootstrapped, plain);
+        encoder.decode(plain, result);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            ASSERT_NEAR(0, abs(result[i] - values[i]), 0.001);
+        }
+
+        // Bootstrapping from a higher level switches to the last level first
+        encoder.encode(values, scale, plain);
+        encryptor.encrypt(plain, encrypted);
+        bootstrapper.bootstrap(encrypted, rlk, glk, encrypted);
+        decryptor.decrypt(encrypted, plain);
+        encoder.decode(plain, result);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            ASSERT_NEAR(0, abs(result[i] - values[i]), 0.001);
+        }
+
+        // Missing Galois keys and insufficient levels are reported
+        GaloisKeys partial_glk;
+        keygen.create_galois_keys(vector<int>{ 1 }, partial_glk);
+        ASSERT_THROW(bootstrapper.bootstrap(encrypted, rlk, partial_glk, bootstrapped), invalid_argument);
+        ASSERT_THROW(CKKSBootstrapper(context, hamming_weight, 4095), invalid_argument);
+        ASSERT_THROW(CKKSBootstrapper(context, 65), invalid_argument);
+    }
+
+    TEST(CKKSBootstrapperTest, ChebyshevCoefficients)
+    {
+        auto coeffs = CKKSBootstrapper::ChebyshevCoefficients([](double x) { return 4 * x * x * x - 3 * x + 1; }, 5);
+        vector<double> expected{ 1, 0, 0, 1, 0, 0 };
+        ASSERT_EQ(expected.size(), coeffs.size());
+        for (size_t k = 0; k < coeffs.size(); k++)
+        {
+            ASSERT_NEAR(expected[k], coeffs[k], 1e-12);
+        }
+    }
+} // namespace sealtest
@@ -0,0 +1,229 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/coeffencoder.h"
+#include "seal/context.h"
+#include "seal/decryptor.h"
+#include "seal/encryptor.h"
+#include "seal/evaluator.h"
+#include "seal/keygenerator.h"
+#include "seal/modulus.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace std;
+
+namespace sealtest
+{
+    TEST(IntegerCoeffEncoderTest, EncodeDecode)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 40 }));
+        parms.set_plain_modulus(1000);
+        SEALContext context(parms, false, sec_level_type::none);
+        IntegerCoeffEncoder encoder(context);
+        ASSERT_EQ(64ULL, encoder.coeff_count());
+
+        vector<int64_t> values{ 3, -1, 0, 500, -500, 7 };
+        Plaintext plain;
+        encoder.encode(values, plain);
+        ASSERT_TRUE(plain.to_string() == "7x^5 + 1F4x^4 + 1F4x^3 + 3E7x^1 + 3");
+        vector<int64_t> result;
+        encoder.decode(plain, result);
+        ASSERT_EQ(64ULL, result.size());
+        for (size_t i = 0; i < result.size(); i++)
+        {
+            // -500 is the same as 500 modulo 1000 and decodes to it
+            int64_t expected = (i < values.size()) ? values[i] : 0;
+            ASSERT_EQ((expected == -500) ? 500 : expected, result[i]);
+        }
+
+        // The i-th value is the coefficient of x^(-i) = -x^(64 - i)
+        encoder.encode_reversed(values, plain);
+        encoder.decode(plain, result);
+        ASSERT_EQ(3, result[0]);
+        ASSERT_EQ(1, result[63]);
+        ASSERT_EQ(0, result[62]);
+        ASSERT_EQ(-7, result[59]);
+
+        vector<uint64_t> unsigned_values{ 999, 0, 1 };
+        encoder.encode(unsigned_values, plain);
+        vector<uint64_t> unsigned_result;
+        encoder.decode(plain, unsigned_result);
+        ASSERT_EQ(64ULL, unsigned_result.size());
+        ASSERT_EQ(999ULL, unsigned_result[0]);
+        ASSERT_EQ(1ULL, unsigned_result[2]);
+
+        ASSERT_THROW(encoder.encode(vector<uint64_t>{ 1000 }, plain), invalid_argument);
+        ASSERT_THROW(encoder.encode(vector<int64_t>{ 501 }, plain), invalid_argument);
+        ASSERT_THROW(encoder.encode(vector<int64_t>(65), plain), invalid_argument);
+    }
+
+    TEST(IntegerCoeffEncoderTest, ConvolveCorrelate)
+    {
+        for (auto scheme : { scheme_type::bfv, scheme_type::bgv })
+        {
+            EncryptionParameters parms(scheme);
+            parms.set_poly_modulus_degree(64);
+            parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40 }));
+            parms.set_plain_modulus(1 << 12);
+            SEALContext context(parms, false, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            IntegerCoeffEncoder encoder(context);
+
+            vector<int64_t> signal(40);
+            for (size_t i = 0; i < signal.size(); i++)
+            {
+                signal[i] = static_cast<int64_t>(i % 7) - 3;
+            }
+            vector<int64_t> kernel{ 2, -1, 0, 3, 1 };
+
+            Plaintext plain;
+            Ciphertext encrypted;
+            vector<int64_t> result;
+            encoder.encode(signal, plain);
+            encryptor.encrypt(plain, encrypted);
+            encoder.convolve_inplace(evaluator, encrypted, kernel);
+            decryptor.decrypt(encrypted, plain);
+            encoder.decode(plain, result);
+            for (size_t i = 0; i < signal.size() + kernel.size() - 1; i++)
+            {
+                int64_t expected = 0;
+                for (size_t j = 0; j < kernel.size(); j++)
+                {
+                    if (i >= j && i - j < signal.size())
+                    {
+                        expected += signal[i - j] * kernel[j];
+                    }
+                }
+                ASSERT_EQ(expected, result[i]);
+            }
+
+            encoder.encode(signal, plain);
+            encryptor.encrypt(plain, encrypted);
+            encoder.correlate_inplace(evaluator, encrypted, kernel);
+            decryptor.decrypt(encrypted, plain);
+            encoder.decode(plain, result);
+            for (size_t i = 0; i + kernel.size() <= signal.size(); i++)
+            {
+                int64_t expected = 0;
+                for (size_t j = 0; j < kernel.size(); j++)
+                {
+                    expected += signal[i + j] * kernel[j];
+                }
+                ASSERT_EQ(expected, result[i]);
+            }
+        }
+    }
+
+    TEST(CKKSCoeffEncoderTest, EncodeDecode)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 60, 40, 60 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        CKKSCoeffEncoder encoder(context);
+        double scale = pow(2.0, 30);
+
+        vector<double> values{ 1.5, -2.25, 0, 100.125 };
+        for (auto context_data = context.first_context_data(); context_data;
+             context_data = context_data->next_context_data())
+        {
+            Plaintext plain;
+            encoder.encode(values, context_data->parms_id(), scale, plain);
+            ASSERT_TRUE(plain.is_ntt_form());
+            ASSERT_EQ(scale, plain.scale());
+            vector<double> result;
+            encoder.decode(plain, result);
+            ASSERT_EQ(64ULL, result.size());
+            for (size_t i = 0; i < result.size(); i++)
+            {
+                ASSERT_NEAR((i < values.size()) ? values[i] : 0.0, result[i], 1e-6);
+            }
+
+            encoder.encode_reversed(values, context_data->parms_id(), scale, plain);
+            encoder.decode(plain, result);
+            ASSERT_NEAR(1.5, result[0], 1e-6);
+            ASSERT_NEAR(2.25, result[63], 1e-6);
+            ASSERT_NEAR(-100.125, result[61], 1e-6);
+        }
+
+        Plaintext plain;
+        ASSERT_THROW(encoder.encode(vector<double>(65), context.first_parms_id(), scale, plain), invalid_argument);
+        ASSERT_THROW(encoder.encode(values, parms_id_zero, scale, plain), invalid_argument);
+        ASSERT_THROW(encoder.encode(vector<double>{ 1e30 }, context.first_parms_id(), scale, plain), invalid_argument);
+    }
+
+    TEST(CKKSCoeffEncoderTest, ConvolveCorrelate)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 60, 40, 60 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        CKKSCoeffEncoder encoder(context);
+        double scale = pow(2.0, 40);
+
+        vector<double> signal(40);
+        for (size_t i = 0; i < signal.size(); i++)
+        {
+            signal[i] = static_cast<double>(i % 5) / 4 - 0.5;
+        }
+        vector<double> kernel{ 0.25, -1, 0.5 };
+
+        Plaintext plain;
+        Ciphertext encrypted;
+        vector<double> result;
+        encoder.encode(signal, context.first_parms_id(), scale, plain);
+        encryptor.encrypt(plain, encrypted);
+        encoder.convolve_inplace(evaluator, encrypted, kernel, scale);
+        evaluator.rescale_to_next_inplace(encrypted);
+        decryptor.decrypt(encrypted, plain);
+        encoder.decode(plain, result);
+        for (size_t i = 0; i < signal.size() + kernel.size() - 1; i++)
+        {
+            double expected = 0;
+            for (size_t j = 0; j < kernel.size(); j++)
+            {
+                if (i >= j && i - j < signal.size())
+                {
+                    expected += signal[i - j] * kernel[j];
+                }
+            }
+            ASSERT_NEAR(expected, result[i], 1e-3);
+        }
+
+        encoder.encode(signal, context.first_parms_id(), scale, plain);
+        encryptor.encrypt(plain, encrypted);
+        encoder.correlate_inplace(evaluator, encrypted, kernel, scale);
+        evaluator.rescale_to_next_inplace(encrypted);
+        decryptor.decrypt(encrypted, plain);
+        encoder.decode(plain, result);
+        for (size_t i = 0; i + kernel.size() <= signal.size(); i++)
+        {
+            double expected = 0;
+            for (size_t j = 0; j < kernel.size(); j++)
+            {
+                expected += signal[i + j] * kernel[j];
+            }
+            ASSERT_NEAR(expected, result[i], 1e-3);
+        }
+    }
+} // namespace sealtest
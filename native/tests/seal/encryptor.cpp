@@ -328,6 +328,55 @@ namespace sealtest
         }
     }
 
+    TEST(EncryptorTest, BGVEncryptDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bgv);
+        Modulus plain_modulus(1 << 6);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+
+        Encryptor encryptor(context, pk, keygen.secret_key());
+        Decryptor decryptor(context, keygen.secret_key());
+
+        Ciphertext encrypted;
+        Plaintext plain;
+        stringstream stream;
+        string hex_poly =
+            "3Fx^63 + 1x^28 + 1x^25 + 1x^21 + 1x^20 + 1x^18 + 1x^14 + 1x^12 + 1x^10 + 1x^9 + 1x^6 + 1x^5 + 1x^4 + 1";
+
+        encryptor.encrypt(Plaintext(hex_poly), encrypted);
+        ASSERT_TRUE(encrypted.is_ntt_form());
+        ASSERT_EQ(1ULL, encrypted.correction_factor());
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(hex_poly, plain.to_string());
+        ASSERT_TRUE(encrypted.parms_id() == context.first_parms_id());
+
+        encryptor.encrypt_symmetric(Plaintext(hex_poly), encrypted);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(hex_poly, plain.to_string());
+
+        encryptor.encrypt_symmetric(Plaintext(hex_poly)).save(stream);
+        encrypted.load(context, stream);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(hex_poly, plain.to_string());
+
+        encryptor.encrypt(Plaintext("0"), encrypted);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ("0", plain.to_string());
+
+        // Asymmetric encryptions of zero at a lower level are switched down from the level above
+        auto next_parms_id = context.first_context_data()->next_context_data()->parms_id();
+        encryptor.encrypt_zero(next_parms_id, encrypted);
+        ASSERT_TRUE(encrypted.parms_id() == next_parms_id);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_TRUE(plain.is_zero());
+    }
+
     TEST(EncryptorTest, BFVEncryptZeroDecrypt)
     {
         EncryptionParameters parms(scheme_type::bfv);
@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/batchencoder.h"
+#include "seal/context.h"
+#include "seal/decryptor.h"
+#include "seal/encryptor.h"
+#include "seal/evaluationgraph.h"
+#include "seal/keygenerator.h"
+#include "seal/modulus.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace std;
+
+namespace sealtest
+{
+    TEST(EvaluationGraphTest, BFVExecuteDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(8);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(8, { 40, 40, 40 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(vector<int>{ 1 }, glk);
+
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        size_t input_count = 6;
+        vector<vector<uint64_t>> input_vecs;
+        vector<Ciphertext> inputs(input_count);
+        for (size_t k = 0; k < input_count; k++)
+        {
+            vector<uint64_t> vec(8);
+            for (size_t i = 0; i < 8; i++)
+            {
+                vec[i] = (k * 8 + i * 3 + 1) % 257;
+            }
+            Plaintext plain;
+            batch_encoder.encode(vec, plain);
+            encryptor.encrypt(plain, inputs[k]);
+            input_vecs.push_back(vec);
+        }
+        Plaintext two("2");
+
+        // Sum over k of rotate(2 * x_k * x_(k + 1)) - x_0, where rotate shifts each row left by one step
+        EvaluationGraph graph(context);
+        vector<EvaluationGraph::handle_type> handles;
+        for (auto &input : inputs)
+        {
+            handles.push_back(graph.input(input));
+        }
+        vector<EvaluationGraph::handle_type> terms;
+        for (size_t k = 0; k + 1 < input_count; k++)
+        {
+            auto product = graph.relinearize(graph.multiply(handles[k], handles[k + 1]), rlk);
+            terms.push_back(graph.rotate_rows(graph.multiply_plain(product, two), 1, glk));
+        }
+        graph.keep(terms[0]);
+        auto sum = terms[0];
+        for (size_t k = 1; k < terms.size(); k++)
+        {
+            sum = graph.add(sum, terms[k]);
+        }
+        auto result = graph.sub(sum, handles[0]);
+        auto square = graph.square(handles[1]);
+        ASSERT_EQ(input_count + 5 * 4 + 4 + 2, graph.size());
+
+        vector<uint64_t> expected_sum(8, 0);
+        vector<uint64_t> expected_term(8, 0);
+        for (size_t i = 0; i < 8; i++)
+        {
+            size_t j = (i & 4) | ((i + 1) & 3);
+            for (size_t k = 0; k + 1 < input_count; k++)
+            {
+                uint64_t term = 2 * input_vecs[k][j] * input_vecs[k + 1][j] % 257;
+                expected_sum[i] = (expected_sum[i] + term) % 257;
+                if (!k)
+                {
+                    expected_term[i] = term;
+                }
+            }
+            expected_sum[i] = (expected_sum[i] + 257 - input_vecs[0][i]) % 257;
+        }
+
+        ASSERT_THROW(static_cast<void>(graph.result(result)), logic_error);
+        for (size_t thread_count : { 1, 2, 4 })
+        {
+            graph.execute(thread_count);
+
+            Plaintext plain;
+            vector<uint64_t> vec;
+            decryptor.decrypt(graph.result(result), plain);
+            batch_encoder.decode(plain, vec);
+            ASSERT_TRUE(vec == expected_sum);
+
+            decryptor.decrypt(graph.result(terms[0]), plain);
+            batch_encoder.decode(plain, vec);
+            ASSERT_TRUE(vec == expected_term);
+
+            ASSERT_EQ(3ULL, graph.result(square).size());
+            ASSERT_TRUE(&graph.result(handles[2]) == &inputs[2]);
+
+            // Intermediate results are released after use
+            ASSERT_THROW(static_cast<void>(graph.result(terms[1])), logic_error);
+            ASSERT_THROW(static_cast<void>(graph.result(sum)), logic_error);
+        }
+
+        ASSERT_THROW(graph.add(result, graph.size()), invalid_argument);
+        ASSERT_THROW(graph.execute(0), invalid_argument);
+
+        // Failures are rethrown by execute
+        graph.rotate_rows(result, 2, glk);
+        ASSERT_THROW(graph.execute(3), invalid_argument);
+        ASSERT_THROW(static_cast<void>(graph.result(result)), logic_error);
+    }
+} // namespace sealtest
@@ -9,10 +9,17 @@
 #include "seal/evaluator.h"
 #include "seal/keygenerator.h"
 #include "seal/modulus.h"
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <ctime>
+#include <fstream>
+#include <limits>
 #include <string>
+#include <thread>
+#include <vector>
 #include "gtest/gtest.h"
 
 using namespace seal;
@@ -921,6 +928,158 @@ namespace sealtest
         ASSERT_TRUE(encrypted1.parms_id() == context.first_parms_id());
     }
 
+    TEST(EvaluatorTest, BFVEncryptConstDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        Modulus plain_modulus(1 << 6);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 40 }));
+
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+
+        Ciphertext encrypted;
+        Plaintext plain;
+
+        encryptor.encrypt(Plaintext("1x^2 + 1"), encrypted);
+        evaluator.add_const_inplace(encrypted, uint64_t(5));
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(plain.to_string(), "1x^2 + 6");
+
+        encryptor.encrypt(Plaintext("1x^2 + 1"), encrypted);
+        evaluator.add_const_inplace(encrypted, uint64_t(0x7F));
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(plain.to_string(), "1x^2");
+
+        encryptor.encrypt(Plaintext("1x^1 + 1"), encrypted);
+        evaluator.sub_const_inplace(encrypted, uint64_t(3));
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(plain.to_string(), "1x^1 + 3E");
+
+        encryptor.encrypt(Plaintext("1x^2 + 3Fx^1 + 2"), encrypted);
+        evaluator.multiply_const_inplace(encrypted, 3);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(plain.to_string(), "3x^2 + 3Dx^1 + 6");
+
+        encryptor.encrypt(Plaintext("1x^1 + 2"), encrypted);
+        evaluator.multiply_const_inplace(encrypted, 0x3F);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(plain.to_string(), "3Fx^1 + 3E");
+
+        // Ciphertexts in NTT form
+        encryptor.encrypt(Plaintext("1x^3 + 2x^1 + 1"), encrypted);
+        evaluator.transform_to_ntt_inplace(encrypted);
+        evaluator.multiply_const_inplace(encrypted, 2);
+        evaluator.add_const_inplace(encrypted, uint64_t(4));
+        evaluator.sub_const_inplace(encrypted, uint64_t(1));
+        ASSERT_TRUE(encrypted.is_ntt_form());
+        evaluator.transform_from_ntt_inplace(encrypted);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(plain.to_string(), "2x^3 + 4x^1 + 5");
+
+        // Integer literals and signed constants, with negative constants reduced modulo the plaintext modulus
+        encryptor.encrypt(Plaintext("1x^1 + 5"), encrypted);
+        evaluator.add_const_inplace(encrypted, 3);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(plain.to_string(), "1x^1 + 8");
+
+        encryptor.encrypt(Plaintext("1x^1 + 5"), encrypted);
+        evaluator.add_const_inplace(encrypted, -7);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(plain.to_string(), "1x^1 + 3E");
+
+        encryptor.encrypt(Plaintext("1x^1 + 5"), encrypted);
+        evaluator.sub_const_inplace(encrypted, 2);
+        evaluator.sub_const_inplace(encrypted, int64_t(-70));
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(plain.to_string(), "1x^1 + 9");
+
+        encryptor.encrypt(Plaintext("1x^1 + 5"), encrypted);
+        evaluator.multiply_const_inplace(encrypted, -1);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(plain.to_string(), "3Fx^1 + 3B");
+
+        Ciphertext destination;
+        encryptor.encrypt(Plaintext("2x^1 + 1"), encrypted);
+        evaluator.add_const(encrypted, 1, destination);
+        evaluator.sub_const(destination, -2, destination);
+        evaluator.multiply_const(destination, 3u, destination);
+        evaluator.multiply_const(destination, numeric_limits<int64_t>::min() + 1, destination);
+        evaluator.add_const(destination, numeric_limits<int64_t>::min(), destination);
+        decryptor.decrypt(destination, plain);
+        ASSERT_EQ(plain.to_string(), "6x^1 + C");
+        evaluator.multiply_const(encrypted, short(-2), destination);
+        decryptor.decrypt(destination, plain);
+        ASSERT_EQ(plain.to_string(), "3Cx^1 + 3E");
+
+        ASSERT_THROW(evaluator.multiply_const_inplace(encrypted, 1 << 6), invalid_argument);
+        ASSERT_THROW(evaluator.multiply_const_inplace(encrypted, -64), invalid_argument);
+        ASSERT_THROW(evaluator.add_const_inplace(encrypted, 1.0), logic_error);
+    }
+
+    TEST(EvaluatorTest, CKKSEncryptConstDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slot_size = 32;
+        parms.set_poly_modulus_degree(slot_size * 2);
+        parms.set_coeff_modulus(CoeffModulus::Create(slot_size * 2, { 60, 60, 40 }));
+
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+
+        CKKSEncoder encoder(context);
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+
+        vector<double> input(slot_size);
+        for (size_t i = 0; i < slot_size; i++)
+        {
+            input[i] = static_cast<double>(i) - 10.5;
+        }
+        const double delta = static_cast<double>(1ULL << 40);
+        Plaintext plain;
+        encoder.encode(input, context.first_parms_id(), delta, plain);
+
+        Ciphertext encrypted;
+        vector<double> output;
+        encryptor.encrypt(plain, encrypted);
+        evaluator.add_const_inplace(encrypted, 0.75);
+        evaluator.sub_const_inplace(encrypted, 2.0);
+        decryptor.decrypt(encrypted, plain);
+        encoder.decode(plain, output);
+        for (size_t i = 0; i < slot_size; i++)
+        {
+            ASSERT_NEAR(input[i] - 1.25, output[i], 0.001);
+        }
+
+        encoder.encode(input, context.first_parms_id(), delta, plain);
+        encryptor.encrypt(plain, encrypted);
+        evaluator.multiply_const_inplace(encrypted, -0.5, delta);
+        ASSERT_DOUBLE_EQ(delta * delta, encrypted.scale());
+        evaluator.add_const_inplace(encrypted, 3.0);
+        decryptor.decrypt(encrypted, plain);
+        encoder.decode(plain, output);
+        for (size_t i = 0; i < slot_size; i++)
+        {
+            ASSERT_NEAR(input[i] * -0.5 + 3.0, output[i], 0.001);
+        }
+
+        ASSERT_THROW(evaluator.multiply_const_inplace(encrypted, 1.0, delta), invalid_argument);
+        ASSERT_THROW(evaluator.add_const_inplace(encrypted, uint64_t(1)), logic_error);
+        ASSERT_THROW(evaluator.add_const_inplace(encrypted, 1), logic_error);
+        ASSERT_THROW(evaluator.multiply_const_inplace(encrypted, -1), logic_error);
+    }
+
     TEST(EvaluatorTest, BFVEncryptMultiplyPlainDecrypt)
     {
         {
@@ -1539,6 +1698,104 @@ namespace sealtest
         ASSERT_TRUE(plain2.to_string() == "1x^40 + 8x^30 + 18x^20 + 20x^10 + 10");
     }
 
+    TEST(EvaluatorTest, PackedKSwitchKeys)
+    {
+        {
+            EncryptionParameters parms(scheme_type::bfv);
+            parms.set_poly_modulus_degree(128);
+            parms.set_plain_modulus(1 << 6);
+            parms.set_coeff_modulus(CoeffModulus::Create(128, { 40, 40, 40, 40 }));
+
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            RelinKeys rlk;
+            keygen.create_relin_keys(rlk);
+            RelinKeys packed_rlk = rlk;
+            packed_rlk.pack();
+            ASSERT_FALSE(rlk.is_packed());
+            ASSERT_TRUE(packed_rlk.is_packed());
+            ASSERT_EQ(0, reinterpret_cast<uintptr_t>(packed_rlk.packed_data(RelinKeys::get_index(2))) % 64);
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+
+            Plaintext plain("1x^10 + 2");
+            Plaintext plain2;
+            Ciphertext encrypted;
+            Ciphertext encrypted2;
+            encryptor.encrypt(plain, encrypted);
+            evaluator.square_inplace(encrypted);
+            evaluator.relinearize(encrypted, rlk, encrypted2);
+            evaluator.relinearize_inplace(encrypted, packed_rlk);
+            ASSERT_EQ(encrypted.dyn_array().size(), encrypted2.dyn_array().size());
+            ASSERT_TRUE(equal(encrypted.data(), encrypted.data() + encrypted.dyn_array().size(), encrypted2.data()));
+            decryptor.decrypt(encrypted, plain2);
+            ASSERT_TRUE(plain2.to_string() == "1x^20 + 4x^10 + 4");
+
+            // Keyswitching at a lower level reads only part of the packed keys
+            encryptor.encrypt(plain, encrypted);
+            evaluator.mod_switch_to_next_inplace(encrypted);
+            evaluator.square_inplace(encrypted);
+            evaluator.relinearize(encrypted, rlk, encrypted2);
+            evaluator.relinearize_inplace(encrypted, packed_rlk);
+            ASSERT_TRUE(equal(encrypted.data(), encrypted.data() + encrypted.dyn_array().size(), encrypted2.data()));
+            decryptor.decrypt(encrypted, plain2);
+            ASSERT_TRUE(plain2.to_string() == "1x^20 + 4x^10 + 4");
+
+            // Reading through a const reference keeps the packed copy
+            const RelinKeys &const_packed_rlk = packed_rlk;
+            ASSERT_FALSE(const_packed_rlk.data().empty());
+            ASSERT_TRUE(packed_rlk.is_packed());
+
+            // Non-const access discards the packed copy, so writes are seen by Evaluator
+            RelinKeys modified_rlk = rlk;
+            modified_rlk.data()[RelinKeys::get_index(2)][0].data().data()[0] ^= 1;
+            packed_rlk.data()[RelinKeys::get_index(2)][0].data().data()[0] ^= 1;
+            ASSERT_FALSE(packed_rlk.is_packed());
+            packed_rlk.pack();
+            ASSERT_TRUE(packed_rlk.is_packed());
+            encryptor.encrypt(plain, encrypted);
+            evaluator.square_inplace(encrypted);
+            evaluator.relinearize(encrypted, modified_rlk, encrypted2);
+            evaluator.relinearize_inplace(encrypted, packed_rlk);
+            ASSERT_TRUE(equal(encrypted.data(), encrypted.data() + encrypted.dyn_array().size(), encrypted2.data()));
+
+            packed_rlk.unpack();
+            ASSERT_FALSE(packed_rlk.is_packed());
+            ASSERT_EQ(nullptr, packed_rlk.packed_data(RelinKeys::get_index(2)));
+        }
+        {
+            EncryptionParameters parms(scheme_type::ckks);
+            parms.set_poly_modulus_degree(64);
+            parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40 }));
+
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            GaloisKeys glk;
+            keygen.create_galois_keys(vector<int>{ 1 }, glk);
+            GaloisKeys packed_glk = glk;
+            packed_glk.pack();
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            CKKSEncoder encoder(context);
+
+            Plaintext plain;
+            Ciphertext encrypted;
+            Ciphertext encrypted2;
+            encoder.encode(vector<double>{ 1.0, 2.0, 3.0, 4.0 }, pow(2.0, 30), plain);
+            encryptor.encrypt(plain, encrypted);
+            evaluator.rotate_vector(encrypted, 1, glk, encrypted2);
+            evaluator.rotate_vector_inplace(encrypted, 1, packed_glk);
+            ASSERT_TRUE(equal(encrypted.data(), encrypted.data() + encrypted.dyn_array().size(), encrypted2.data()));
+        }
+    }
+
     TEST(EvaluatorTest, CKKSEncryptNaiveMultiplyDecrypt)
     {
         EncryptionParameters parms(scheme_type::ckks);
@@ -3595,6 +3852,58 @@ namespace sealtest
         ASSERT_TRUE(product.parms_id() == context.first_parms_id());
     }
 
+    TEST(EvaluatorTest, BFVEncryptMultiplyManyParallelDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        Modulus plain_modulus(1 << 6);
+        parms.set_poly_modulus_degree(128);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(128, { 40, 40, 40, 40 }));
+
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+
+        Ciphertext product;
+        Plaintext plain;
+        vector<Ciphertext> encrypteds;
+        ASSERT_THROW(evaluator.multiply_many_parallel(encrypteds, rlk, product, 2), invalid_argument);
+
+        // Product of 1x^1 + 1 with itself n times has binomial coefficients modulo 64
+        for (size_t count : { 1, 2, 5, 8, 11 })
+        {
+            encrypteds.resize(count);
+            for (auto &encrypted : encrypteds)
+            {
+                encryptor.encrypt(Plaintext("1x^1 + 1"), encrypted);
+            }
+
+            Plaintext expected;
+            evaluator.multiply_many(encrypteds, rlk, product);
+            decryptor.decrypt(product, expected);
+            for (size_t thread_count : { 1, 3, 16 })
+            {
+                evaluator.multiply_many_parallel(encrypteds, rlk, product, thread_count);
+                ASSERT_EQ(2ULL, product.size());
+                ASSERT_TRUE(product.parms_id() == context.first_parms_id());
+                decryptor.decrypt(product, plain);
+                ASSERT_EQ(expected.to_string(), plain.to_string());
+            }
+        }
+        ASSERT_THROW(evaluator.multiply_many_parallel(encrypteds, rlk, product, 0), invalid_argument);
+
+        decryptor.decrypt(product, plain);
+        ASSERT_EQ(
+            plain.to_string(), "1x^11 + Bx^10 + 37x^9 + 25x^8 + Ax^7 + Ex^6 + Ex^5 + Ax^4 + 25x^3 + 37x^2 + Bx^1 + 1");
+    }
+
     TEST(EvaluatorTest, BFVEncryptExponentiateDecrypt)
     {
         EncryptionParameters parms(scheme_type::bfv);
@@ -3644,6 +3953,37 @@ namespace sealtest
         decryptor.decrypt(encrypted, plain);
         ASSERT_EQ(plain.to_string(), "1x^32");
         ASSERT_TRUE(encrypted.parms_id() == context.first_parms_id());
+
+        plain = "2x^1";
+        encryptor.encrypt(plain, encrypted);
+        evaluator.exponentiate_inplace(encrypted, 5, rlk);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(plain.to_string(), "20x^5");
+        ASSERT_TRUE(encrypted.parms_id() == context.first_parms_id());
+        ASSERT_EQ(2ULL, encrypted.size());
+
+        plain = "1x^1";
+        encryptor.encrypt(plain, encrypted);
+        evaluator.exponentiate_inplace(encrypted, 13, rlk);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ(plain.to_string(), "1x^13");
+        ASSERT_TRUE(encrypted.parms_id() == context.first_parms_id());
+    }
+
+    TEST(EvaluatorTest, ExponentiationChain)
+    {
+        ASSERT_THROW(static_cast<void>(Evaluator::ExponentiationChain(0)), invalid_argument);
+        ASSERT_TRUE((Evaluator::ExponentiationChain(1) == vector<uint64_t>{ 1 }));
+        ASSERT_TRUE((Evaluator::ExponentiationChain(2) == vector<uint64_t>{ 1, 2 }));
+        ASSERT_TRUE((Evaluator::ExponentiationChain(3) == vector<uint64_t>{ 1, 2, 3 }));
+        ASSERT_TRUE((Evaluator::ExponentiationChain(8) == vector<uint64_t>{ 1, 2, 4, 8 }));
+        ASSERT_TRUE((Evaluator::ExponentiationChain(12) == vector<uint64_t>{ 1, 2, 4, 8, 12 }));
+        ASSERT_TRUE((Evaluator::ExponentiationChain(13) == vector<uint64_t>{ 1, 2, 4, 5, 8, 13 }));
+
+        // Eight squarings and five multiplications
+        auto chain = Evaluator::ExponentiationChain(500);
+        ASSERT_EQ(500ULL, chain.back());
+        ASSERT_EQ(13ULL, chain.size() - 1);
     }
 
     TEST(EvaluatorTest, BFVEncryptAddManyDecrypt)
@@ -3935,6 +4275,93 @@ namespace sealtest
         ASSERT_TRUE(encrypted.parms_id() == context.first_parms_id());
     }
 
+    TEST(EvaluatorTest, BFVEncryptMultiplyBatchedNTTPlainDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(8);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(8, { 40, 40, 40 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        vector<uint64_t> vec{ 1, 2, 3, 4, 5, 6, 7, 8 };
+        vector<uint64_t> mul_vec{ 3, 0, 1, 2, 256, 5, 1, 128 };
+        vector<uint64_t> expected(8);
+        for (size_t i = 0; i < 8; i++)
+        {
+            expected[i] = vec[i] * mul_vec[i] % 257;
+        }
+
+        Plaintext plain, mul_plain;
+        Ciphertext encrypted;
+        vector<uint64_t> result;
+        batch_encoder.encode(vec, plain);
+        for (auto parms_id : { context.first_parms_id(), context.last_parms_id() })
+        {
+            batch_encoder.encode(mul_vec, parms_id, mul_plain);
+            ASSERT_TRUE(mul_plain.is_ntt_form());
+            ASSERT_TRUE(mul_plain.parms_id() == parms_id);
+
+            // Ciphertext in coefficient form
+            encryptor.encrypt(plain, encrypted);
+            evaluator.mod_switch_to_inplace(encrypted, parms_id);
+            evaluator.multiply_plain_inplace(encrypted, mul_plain);
+            ASSERT_FALSE(encrypted.is_ntt_form());
+            decryptor.decrypt(encrypted, plain);
+            batch_encoder.decode(plain, result);
+            ASSERT_TRUE(result == expected);
+
+            // Ciphertext in NTT form
+            batch_encoder.encode(vec, plain);
+            encryptor.encrypt(plain, encrypted);
+            evaluator.mod_switch_to_inplace(encrypted, parms_id);
+            evaluator.transform_to_ntt_inplace(encrypted);
+            evaluator.multiply_plain_inplace(encrypted, mul_plain);
+            evaluator.transform_from_ntt_inplace(encrypted);
+            decryptor.decrypt(encrypted, plain);
+            batch_encoder.decode(plain, result);
+            ASSERT_TRUE(result == expected);
+
+            // Several ciphertexts in coefficient form
+            batch_encoder.encode(vec, plain);
+            vector<Ciphertext> encrypteds(3);
+            for (auto &curr_encrypted : encrypteds)
+            {
+                encryptor.encrypt(plain, curr_encrypted);
+                evaluator.mod_switch_to_inplace(curr_encrypted, parms_id);
+            }
+            evaluator.multiply_plain_batch_inplace(encrypteds, mul_plain, 2);
+            for (auto &curr_encrypted : encrypteds)
+            {
+                Plaintext curr_plain;
+                decryptor.decrypt(curr_encrypted, curr_plain);
+                batch_encoder.decode(curr_plain, result);
+                ASSERT_TRUE(result == expected);
+            }
+            batch_encoder.encode(vec, plain);
+        }
+
+        // Levels must match, and a mismatch leaves the ciphertexts in coefficient form
+        encryptor.encrypt(plain, encrypted);
+        ASSERT_THROW(evaluator.multiply_plain_inplace(encrypted, mul_plain), invalid_argument);
+        ASSERT_FALSE(encrypted.is_ntt_form());
+        vector<Ciphertext> encrypteds(2, encrypted);
+        ASSERT_THROW(evaluator.multiply_plain_batch_inplace(encrypteds, mul_plain, 2), invalid_argument);
+        for (auto &curr_encrypted : encrypteds)
+        {
+            ASSERT_FALSE(curr_encrypted.is_ntt_form());
+        }
+    }
+
     TEST(EvaluatorTest, BFVEncryptApplyGaloisDecrypt)
     {
         EncryptionParameters parms(scheme_type::bfv);
@@ -4067,65 +4494,423 @@ namespace sealtest
         batch_encoder.decode(plain, plain_vec);
         ASSERT_TRUE((plain_vec == vector<uint64_t>{ 2, 3, 4, 1, 6, 7, 8, 5 }));
     }
-    TEST(EvaluatorTest, BFVEncryptModSwitchToNextDecrypt)
+    TEST(EvaluatorTest, BFVEncryptBatchPlainRotateDecrypt)
     {
-        // The common parameters: the plaintext and the polynomial moduli
-        Modulus plain_modulus(1 << 6);
-
-        // The parameters and the context of the higher level
         EncryptionParameters parms(scheme_type::bfv);
-        parms.set_poly_modulus_degree(128);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(8);
         parms.set_plain_modulus(plain_modulus);
-        parms.set_coeff_modulus(CoeffModulus::Create(128, { 30, 30, 30, 30 }));
+        parms.set_coeff_modulus(CoeffModulus::Create(8, { 40, 40, 40 }));
 
         SEALContext context(parms, true, sec_level_type::none);
         KeyGenerator keygen(context);
-        SecretKey secret_key = keygen.secret_key();
         PublicKey pk;
         keygen.create_public_key(pk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(glk);
 
         Encryptor encryptor(context, pk);
         Evaluator evaluator(context);
         Decryptor decryptor(context, keygen.secret_key());
-        auto parms_id = context.first_parms_id();
+        BatchEncoder batch_encoder(context);
 
-        Ciphertext encrypted(context);
-        Ciphertext encryptedRes;
-        Plaintext plain;
+        vector<uint64_t> add_vec{ 1, 2, 3, 4, 5, 6, 7, 8 };
+        vector<uint64_t> mul_vec{ 3, 0, 1, 2, 256, 5, 1, 1 };
+        Plaintext add_plain, mul_plain;
+        batch_encoder.encode(add_vec, add_plain);
+        batch_encoder.encode(mul_vec, mul_plain);
 
-        plain = 0;
-        encryptor.encrypt(plain, encrypted);
-        evaluator.mod_switch_to_next(encrypted, encryptedRes);
-        decryptor.decrypt(encryptedRes, plain);
-        parms_id = context.get_context_data(parms_id)->next_context_data()->parms_id();
-        ASSERT_TRUE(encryptedRes.parms_id() == parms_id);
-        ASSERT_TRUE(plain.to_string() == "0");
+        for (bool ntt_form : { false, true })
+        {
+            for (size_t thread_count : { 1, 3 })
+            {
+                vector<vector<uint64_t>> expected;
+                vector<Ciphertext> encrypteds;
+                for (uint64_t k = 0; k < 5; k++)
+                {
+                    vector<uint64_t> vec(8);
+                    for (size_t i = 0; i < 8; i++)
+                    {
+                        vec[i] = k * 10 + i;
+                    }
+                    Plaintext plain;
+                    batch_encoder.encode(vec, plain);
+                    encrypteds.emplace_back();
+                    encryptor.encrypt(plain, encrypteds.back());
+
+                    // Slot-wise (v + a) * m - a, multiplied by 2, and each row rotated left by one step
+                    vector<uint64_t> result(8);
+                    for (size_t i = 0; i < 8; i++)
+                    {
+                        size_t j = (i & 4) | ((i + 1) & 3);
+                        result[i] = ((vec[j] + add_vec[j]) * mul_vec[j] + 257 - add_vec[j]) * 2 % 257;
+                    }
+                    expected.push_back(result);
+                }
 
-        evaluator.mod_switch_to_next_inplace(encryptedRes);
-        decryptor.decrypt(encryptedRes, plain);
-        parms_id = context.get_context_data(parms_id)->next_context_data()->parms_id();
-        ASSERT_TRUE(encryptedRes.parms_id() == parms_id);
-        ASSERT_TRUE(plain.to_string() == "0");
+                if (ntt_form)
+                {
+                    for (auto &encrypted : encrypteds)
+                    {
+                        evaluator.transform_to_ntt_inplace(encrypted);
+                    }
+                }
+                evaluator.add_plain_batch_inplace(encrypteds, add_plain, thread_count);
+                evaluator.multiply_plain_batch_inplace(encrypteds, mul_plain, thread_count);
+                evaluator.sub_plain_batch_inplace(encrypteds, add_plain, thread_count);
+                evaluator.multiply_plain_batch_inplace(encrypteds, Plaintext("2"), thread_count);
+                evaluator.rotate_rows_batch_inplace(encrypteds, 1, glk, thread_count);
 
-        parms_id = context.first_parms_id();
-        plain = 1;
-        encryptor.encrypt(plain, encrypted);
-        evaluator.mod_switch_to_next(encrypted, encryptedRes);
-        decryptor.decrypt(encryptedRes, plain);
-        parms_id = context.get_context_data(parms_id)->next_context_data()->parms_id();
-        ASSERT_TRUE(encryptedRes.parms_id() == parms_id);
-        ASSERT_TRUE(plain.to_string() == "1");
+                for (size_t k = 0; k < encrypteds.size(); k++)
+                {
+                    ASSERT_EQ(ntt_form, encrypteds[k].is_ntt_form());
+                    if (ntt_form)
+                    {
+                        evaluator.transform_from_ntt_inplace(encrypteds[k]);
+                    }
+                    Plaintext plain;
+                    vector<uint64_t> vec;
+                    decryptor.decrypt(encrypteds[k], plain);
+                    batch_encoder.decode(plain, vec);
+                    ASSERT_TRUE(vec == expected[k]);
+                }
+            }
+        }
 
-        evaluator.mod_switch_to_next_inplace(encryptedRes);
-        decryptor.decrypt(encryptedRes, plain);
-        parms_id = context.get_context_data(parms_id)->next_context_data()->parms_id();
-        ASSERT_TRUE(encryptedRes.parms_id() == parms_id);
-        ASSERT_TRUE(plain.to_string() == "1");
+        vector<Ciphertext> encrypteds;
+        evaluator.add_plain_batch_inplace(encrypteds, add_plain);
+        ASSERT_THROW(evaluator.add_plain_batch_inplace(encrypteds, add_plain, 0), invalid_argument);
+
+        encrypteds.resize(2);
+        encryptor.encrypt(add_plain, encrypteds[0]);
+        encryptor.encrypt(add_plain, encrypteds[1]);
+        evaluator.mod_switch_to_next_inplace(encrypteds[1]);
+        ASSERT_THROW(evaluator.multiply_plain_batch_inplace(encrypteds, mul_plain), invalid_argument);
+        ASSERT_THROW(evaluator.rotate_rows_batch_inplace(encrypteds, 1, glk), invalid_argument);
+        ASSERT_THROW(evaluator.rotate_vector_batch_inplace(encrypteds, 1, glk), logic_error);
+    }
 
-        parms_id = context.first_parms_id();
-        plain = "1x^127";
-        encryptor.encrypt(plain, encrypted);
-        evaluator.mod_switch_to_next(encrypted, encryptedRes);
+    TEST(EvaluatorTest, CKKSEncryptBatchPlainRotateDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slot_size = 8;
+        parms.set_poly_modulus_degree(slot_size * 2);
+        parms.set_coeff_modulus(CoeffModulus::Create(slot_size * 2, { 60, 60, 40 }));
+
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(glk);
+
+        CKKSEncoder encoder(context);
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+
+        const double delta = static_cast<double>(1ULL << 30);
+        vector<double> add_vec{ 0.5, -1.5, 2.0, 0.0, 1.0, 3.5, -2.5, 4.0 };
+        vector<double> mul_vec{ 2.0, 0.5, -1.0, 3.0, 1.5, -0.5, 0.25, 1.0 };
+        Plaintext add_plain, mul_plain;
+        encoder.encode(add_vec, delta, add_plain);
+        encoder.encode(mul_vec, delta, mul_plain);
+
+        vector<vector<double>> expected;
+        vector<Ciphertext> encrypteds;
+        for (size_t k = 0; k < 5; k++)
+        {
+            vector<double> vec(slot_size);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                vec[i] = static_cast<double>(k) - static_cast<double>(i) * 0.75;
+            }
+            Plaintext plain;
+            encoder.encode(vec, delta, plain);
+            encrypteds.emplace_back();
+            encryptor.encrypt(plain, encrypteds.back());
+
+            // Slot-wise (v - a) * m, rotated left by two steps
+            vector<double> result(slot_size);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                size_t j = (i + 2) % slot_size;
+                result[i] = (vec[j] - add_vec[j]) * mul_vec[j];
+            }
+            expected.push_back(result);
+        }
+
+        evaluator.sub_plain_batch_inplace(encrypteds, add_plain, 2);
+        evaluator.multiply_plain_batch_inplace(encrypteds, mul_plain, 2);
+        evaluator.rotate_vector_batch_inplace(encrypteds, 2, glk, 2);
+
+        for (size_t k = 0; k < encrypteds.size(); k++)
+        {
+            ASSERT_DOUBLE_EQ(delta * delta, encrypteds[k].scale());
+            Plaintext plain;
+            vector<double> vec;
+            decryptor.decrypt(encrypteds[k], plain);
+            encoder.decode(plain, vec);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                ASSERT_NEAR(expected[k][i], vec[i], 0.001);
+            }
+        }
+
+        // Scale mismatch within the batch
+        encrypteds[1].scale() = delta;
+        ASSERT_THROW(evaluator.add_plain_batch_inplace(encrypteds, add_plain), invalid_argument);
+        ASSERT_THROW(evaluator.rotate_rows_batch_inplace(encrypteds, 1, glk), logic_error);
+    }
+
+    TEST(EvaluatorTest, BFVEncryptRotateMatrixLazyGaloisKeysDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(8);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(8, { 40, 40 }));
+
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        stringstream stream;
+        keygen.create_galois_keys().save(stream);
+        GaloisKeys glk;
+        glk.load_lazy(context, stream, 1);
+        ASSERT_TRUE(glk.is_lazy());
+        ASSERT_EQ(0ULL, glk.cached_key_count());
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        Plaintext plain;
+        vector<uint64_t> plain_vec{ 1, 2, 3, 4, 5, 6, 7, 8 };
+        batch_encoder.encode(plain_vec, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        evaluator.rotate_columns_inplace(encrypted, glk);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 5, 6, 7, 8, 1, 2, 3, 4 }));
+        ASSERT_EQ(1ULL, glk.cached_key_count());
+
+        evaluator.rotate_rows_inplace(encrypted, -1, glk);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 8, 5, 6, 7, 4, 1, 2, 3 }));
+        ASSERT_EQ(1ULL, glk.cached_key_count());
+
+        evaluator.rotate_rows_inplace(encrypted, 2, glk);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 6, 7, 8, 5, 2, 3, 4, 1 }));
+
+        // A lazily loaded GaloisKeys saves back to the seeded form
+        GaloisKeys glk2;
+        glk.save(stream);
+        glk2.load(context, stream);
+        ASSERT_FALSE(glk2.is_lazy());
+        evaluator.rotate_columns_inplace(encrypted, glk2);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 2, 3, 4, 1, 6, 7, 8, 5 }));
+    }
+
+    TEST(EvaluatorTest, BFVEncryptRotateMatrixNTTDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(8);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(8, { 40, 40, 40 }));
+
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(glk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        Plaintext plain;
+        vector<uint64_t> plain_vec{ 1, 2, 3, 4, 5, 6, 7, 8 };
+        batch_encoder.encode(plain_vec, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+        evaluator.transform_to_ntt_inplace(encrypted);
+
+        Ciphertext encrypted_result;
+        evaluator.rotate_columns(encrypted, glk, encrypted_result);
+        ASSERT_TRUE(encrypted_result.is_ntt_form());
+        evaluator.transform_from_ntt_inplace(encrypted_result);
+        decryptor.decrypt(encrypted_result, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 5, 6, 7, 8, 1, 2, 3, 4 }));
+
+        evaluator.rotate_rows_inplace(encrypted, -1, glk);
+        ASSERT_TRUE(encrypted.is_ntt_form());
+        encrypted_result = encrypted;
+        evaluator.transform_from_ntt_inplace(encrypted_result);
+        decryptor.decrypt(encrypted_result, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 4, 1, 2, 3, 8, 5, 6, 7 }));
+
+        // Plain multiplication and addition keep the NTT form
+        Plaintext plain2;
+        batch_encoder.encode(vector<uint64_t>{ 2, 2, 2, 2, 3, 3, 3, 3 }, plain2);
+        evaluator.multiply_plain_inplace(encrypted, plain2);
+        ASSERT_TRUE(encrypted.is_ntt_form());
+        batch_encoder.encode(vector<uint64_t>{ 1, 1, 1, 1, 1, 1, 1, 256 }, plain2);
+        evaluator.add_plain_inplace(encrypted, plain2);
+        ASSERT_TRUE(encrypted.is_ntt_form());
+        evaluator.add_inplace(encrypted, encrypted);
+        batch_encoder.encode(vector<uint64_t>{ 0, 1, 0, 1, 0, 1, 0, 1 }, plain2);
+        evaluator.sub_plain_inplace(encrypted, plain2);
+        ASSERT_TRUE(encrypted.is_ntt_form());
+        evaluator.rotate_rows_inplace(encrypted, 1, glk);
+        ASSERT_TRUE(encrypted.is_ntt_form());
+
+        evaluator.transform_from_ntt_inplace(encrypted);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 5, 10, 13, 18, 31, 38, 39, 50 }));
+
+        // Plaintexts in NTT form are only accepted by plain multiplication
+        evaluator.transform_to_ntt_inplace(encrypted);
+        evaluator.transform_to_ntt_inplace(plain2, encrypted.parms_id());
+        ASSERT_THROW(evaluator.add_plain_inplace(encrypted, plain2), invalid_argument);
+        evaluator.multiply_plain_inplace(encrypted, plain2);
+        evaluator.transform_from_ntt_inplace(encrypted);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 0, 10, 0, 18, 0, 38, 0, 50 }));
+
+        // Relinearization still requires the coefficient form
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+        evaluator.square_inplace(encrypted);
+        evaluator.transform_to_ntt_inplace(encrypted);
+        ASSERT_THROW(evaluator.relinearize_inplace(encrypted, rlk), invalid_argument);
+        evaluator.transform_from_ntt_inplace(encrypted);
+        evaluator.relinearize_inplace(encrypted, rlk);
+        ASSERT_EQ(2ULL, encrypted.size());
+    }
+#ifdef SEAL_USE_MMAP
+    TEST(EvaluatorTest, BFVEncryptRotateMatrixMappedGaloisKeysDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(8);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(8, { 40, 40 }));
+
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        string path = "sealtest_evaluator_galoiskeys.map";
+        {
+            GaloisKeys glk;
+            keygen.create_galois_keys(glk);
+            ofstream file(path, ios::binary);
+            glk.save_mapped(file);
+        }
+        GaloisKeys glk;
+        glk.load_mapped(context, path);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        Plaintext plain;
+        vector<uint64_t> plain_vec{ 1, 2, 3, 4, 5, 6, 7, 8 };
+        batch_encoder.encode(plain_vec, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        evaluator.rotate_columns_inplace(encrypted, glk);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 5, 6, 7, 8, 1, 2, 3, 4 }));
+
+        glk.evict_mapped(GaloisKeys::get_index(context.key_context_data()->galois_tool()->get_elt_from_step(-1)));
+        evaluator.rotate_rows_inplace(encrypted, -1, glk);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 8, 5, 6, 7, 4, 1, 2, 3 }));
+
+        remove(path.c_str());
+    }
+#endif
+    TEST(EvaluatorTest, BFVEncryptModSwitchToNextDecrypt)
+    {
+        // The common parameters: the plaintext and the polynomial moduli
+        Modulus plain_modulus(1 << 6);
+
+        // The parameters and the context of the higher level
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(128);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(128, { 30, 30, 30, 30 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        SecretKey secret_key = keygen.secret_key();
+        PublicKey pk;
+        keygen.create_public_key(pk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        auto parms_id = context.first_parms_id();
+
+        Ciphertext encrypted(context);
+        Ciphertext encryptedRes;
+        Plaintext plain;
+
+        plain = 0;
+        encryptor.encrypt(plain, encrypted);
+        evaluator.mod_switch_to_next(encrypted, encryptedRes);
+        decryptor.decrypt(encryptedRes, plain);
+        parms_id = context.get_context_data(parms_id)->next_context_data()->parms_id();
+        ASSERT_TRUE(encryptedRes.parms_id() == parms_id);
+        ASSERT_TRUE(plain.to_string() == "0");
+
+        evaluator.mod_switch_to_next_inplace(encryptedRes);
+        decryptor.decrypt(encryptedRes, plain);
+        parms_id = context.get_context_data(parms_id)->next_context_data()->parms_id();
+        ASSERT_TRUE(encryptedRes.parms_id() == parms_id);
+        ASSERT_TRUE(plain.to_string() == "0");
+
+        parms_id = context.first_parms_id();
+        plain = 1;
+        encryptor.encrypt(plain, encrypted);
+        evaluator.mod_switch_to_next(encrypted, encryptedRes);
+        decryptor.decrypt(encryptedRes, plain);
+        parms_id = context.get_context_data(parms_id)->next_context_data()->parms_id();
+        ASSERT_TRUE(encryptedRes.parms_id() == parms_id);
+        ASSERT_TRUE(plain.to_string() == "1");
+
+        evaluator.mod_switch_to_next_inplace(encryptedRes);
+        decryptor.decrypt(encryptedRes, plain);
+        parms_id = context.get_context_data(parms_id)->next_context_data()->parms_id();
+        ASSERT_TRUE(encryptedRes.parms_id() == parms_id);
+        ASSERT_TRUE(plain.to_string() == "1");
+
+        parms_id = context.first_parms_id();
+        plain = "1x^127";
+        encryptor.encrypt(plain, encrypted);
+        evaluator.mod_switch_to_next(encrypted, encryptedRes);
         decryptor.decrypt(encryptedRes, plain);
         parms_id = context.get_context_data(parms_id)->next_context_data()->parms_id();
         ASSERT_TRUE(encryptedRes.parms_id() == parms_id);
@@ -4297,4 +5082,290 @@ namespace sealtest
         ASSERT_TRUE(encrypted.parms_id() == parms_id);
         ASSERT_TRUE(plain.to_string() == "5x^64 + Ax^5");
     }
+
+    TEST(EvaluatorTest, BFVEncryptMultiplyRelinScratchPool)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+
+        // Temporaries come from a memory pool given explicitly
+        Ciphertext encrypted;
+        encryptor.encrypt(Plaintext("3x^2 + 1"), encrypted);
+        auto pool = MemoryPoolHandle::New();
+        evaluator.square_inplace(encrypted, pool);
+        evaluator.relinearize_inplace(encrypted, rlk, pool);
+        evaluator.mod_switch_to_next_inplace(encrypted, pool);
+        ASSERT_TRUE(pool.alloc_byte_count() > 0);
+        Plaintext plain;
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_TRUE(plain.to_string() == "9x^4 + 6x^2 + 1");
+
+        // With the global memory pool, concurrent evaluations allocate temporaries from their thread-local pools
+        size_t thread_count = 4;
+        vector<Ciphertext> encrypteds(thread_count);
+        vector<size_t> tls_byte_counts(thread_count);
+        vector<thread> workers;
+        for (size_t t = 0; t < thread_count; t++)
+        {
+            encryptor.encrypt(Plaintext(to_string(t + 1) + "x^1"), encrypteds[t]);
+            workers.emplace_back([&, t] {
+                for (int i = 0; i < 3; i++)
+                {
+                    Ciphertext encrypted_t;
+                    encryptor.encrypt(Plaintext("1x^1"), encrypted_t);
+                    evaluator.multiply_inplace(encrypted_t, encrypteds[t]);
+                    evaluator.relinearize_inplace(encrypted_t, rlk);
+                    if (!i)
+                    {
+                        encrypteds[t] = encrypted_t;
+                    }
+                }
+                tls_byte_counts[t] = MemoryPoolHandle::ThreadLocal().alloc_byte_count();
+            });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        for (size_t t = 0; t < thread_count; t++)
+        {
+            ASSERT_TRUE(tls_byte_counts[t] > 0);
+            ASSERT_TRUE(encrypteds[t].pool() == MemoryManager::GetPool());
+            decryptor.decrypt(encrypteds[t], plain);
+            ASSERT_TRUE(plain.to_string() == to_string(t + 1) + "x^2");
+        }
+    }
+
+    TEST(EvaluatorTest, BGVEncryptAddSubDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bgv);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+
+        Ciphertext encrypted1;
+        Ciphertext encrypted2;
+        Plaintext plain;
+
+        encryptor.encrypt(Plaintext("1x^28 + 1x^25 + 1x^21 + 1x^20 + 100x^2 + 1"), encrypted1);
+        encryptor.encrypt(Plaintext("1x^18 + 1x^14 + 2x^2 + 3"), encrypted2);
+        evaluator.add_inplace(encrypted1, encrypted2);
+        decryptor.decrypt(encrypted1, plain);
+        ASSERT_EQ("1x^28 + 1x^25 + 1x^21 + 1x^20 + 1x^18 + 1x^14 + 1x^2 + 4", plain.to_string());
+        ASSERT_EQ(1ULL, encrypted1.correction_factor());
+
+        evaluator.sub_inplace(encrypted1, encrypted2);
+        decryptor.decrypt(encrypted1, plain);
+        ASSERT_EQ("1x^28 + 1x^25 + 1x^21 + 1x^20 + 100x^2 + 1", plain.to_string());
+
+        evaluator.negate_inplace(encrypted2);
+        decryptor.decrypt(encrypted2, plain);
+        ASSERT_EQ("100x^18 + 100x^14 + FFx^2 + FE", plain.to_string());
+
+        // Modulus switching and multiplication change the correction factor, which addition and subtraction balance
+        Ciphertext encrypted3;
+        encryptor.encrypt(Plaintext("5x^3 + 2"), encrypted1);
+        encryptor.encrypt(Plaintext("1x^3 + 7"), encrypted2);
+        encryptor.encrypt(Plaintext("2"), encrypted3);
+        evaluator.mod_switch_to_next_inplace(encrypted1);
+        evaluator.mod_switch_to_next_inplace(encrypted2);
+        evaluator.mod_switch_to_next_inplace(encrypted3);
+        ASSERT_NE(1ULL, encrypted1.correction_factor());
+        ASSERT_EQ(encrypted1.correction_factor(), encrypted2.correction_factor());
+        evaluator.multiply_inplace(encrypted2, encrypted3);
+        ASSERT_NE(encrypted1.correction_factor(), encrypted2.correction_factor());
+
+        evaluator.add(encrypted1, encrypted2, encrypted3);
+        decryptor.decrypt(encrypted3, plain);
+        ASSERT_EQ("7x^3 + 10", plain.to_string());
+        evaluator.sub(encrypted2, encrypted1, encrypted3);
+        decryptor.decrypt(encrypted3, plain);
+        ASSERT_EQ("FEx^3 + C", plain.to_string());
+    }
+
+    TEST(EvaluatorTest, BGVEncryptMultiplyRelinModSwitchDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bgv);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 50, 50, 50, 50 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        vector<uint64_t> vec1(64);
+        vector<uint64_t> vec2(64);
+        vector<uint64_t> expected(64);
+        for (size_t i = 0; i < 64; i++)
+        {
+            vec1[i] = (i * 7 + 3) % 257;
+            vec2[i] = (256 - i * 5) % 257;
+            expected[i] = vec1[i] * vec1[i] % 257 * vec2[i] % 257;
+        }
+
+        Plaintext plain1;
+        Plaintext plain2;
+        batch_encoder.encode(vec1, plain1);
+        batch_encoder.encode(vec2, plain2);
+        Ciphertext encrypted1;
+        Ciphertext encrypted2;
+        encryptor.encrypt(plain1, encrypted1);
+        encryptor.encrypt(plain2, encrypted2);
+
+        int budget = decryptor.invariant_noise_budget(encrypted1);
+        ASSERT_TRUE(budget > 0);
+
+        evaluator.square_inplace(encrypted1);
+        ASSERT_EQ(3ULL, encrypted1.size());
+        evaluator.relinearize_inplace(encrypted1, rlk);
+        ASSERT_EQ(2ULL, encrypted1.size());
+        ASSERT_TRUE(decryptor.invariant_noise_budget(encrypted1) < budget);
+        evaluator.mod_switch_to_next_inplace(encrypted1);
+        evaluator.mod_switch_to_next_inplace(encrypted2);
+        evaluator.multiply_inplace(encrypted1, encrypted2);
+        evaluator.relinearize_inplace(encrypted1, rlk);
+        evaluator.mod_switch_to_next_inplace(encrypted1);
+        ASSERT_TRUE(encrypted1.parms_id() == context.last_parms_id());
+        ASSERT_TRUE(decryptor.invariant_noise_budget(encrypted1) > 0);
+
+        Plaintext plain;
+        vector<uint64_t> result;
+        decryptor.decrypt(encrypted1, plain);
+        batch_encoder.decode(plain, result);
+        ASSERT_TRUE(result == expected);
+
+        ASSERT_THROW(evaluator.rescale_to_next_inplace(encrypted1), logic_error);
+    }
+
+    TEST(EvaluatorTest, BGVEncryptPlainConstDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bgv);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(8);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(8, { 40, 40, 40 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        Plaintext plain;
+        Plaintext plain_vec2;
+        vector<uint64_t> vec1{ 1, 2, 3, 4, 5, 6, 7, 8 };
+        vector<uint64_t> vec2{ 256, 10, 0, 1, 2, 3, 100, 200 };
+        batch_encoder.encode(vec1, plain);
+        batch_encoder.encode(vec2, plain_vec2);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        // Operate on a ciphertext with a nontrivial correction factor
+        evaluator.mod_switch_to_next_inplace(encrypted);
+        ASSERT_NE(1ULL, encrypted.correction_factor());
+
+        vector<uint64_t> result;
+        evaluator.add_plain_inplace(encrypted, plain_vec2);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, result);
+        ASSERT_TRUE((result == vector<uint64_t>{ 0, 12, 3, 5, 7, 9, 107, 208 }));
+
+        evaluator.sub_plain_inplace(encrypted, plain_vec2);
+        evaluator.multiply_plain_inplace(encrypted, plain_vec2);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, result);
+        ASSERT_TRUE((result == vector<uint64_t>{ 256, 20, 0, 4, 10, 18, 186, 58 }));
+
+        evaluator.add_const_inplace(encrypted, uint64_t(2));
+        evaluator.multiply_const_inplace(encrypted, 256);
+        evaluator.sub_const_inplace(encrypted, uint64_t(1));
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, result);
+        ASSERT_TRUE((result == vector<uint64_t>{ 255, 234, 254, 250, 244, 236, 68, 196 }));
+
+        Plaintext plain_ntt = plain_vec2;
+        evaluator.transform_to_ntt_inplace(plain_ntt, encrypted.parms_id());
+        ASSERT_THROW(evaluator.add_plain_inplace(encrypted, plain_ntt), invalid_argument);
+    }
+
+    TEST(EvaluatorTest, BGVEncryptRotateMatrixDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bgv);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(8);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(8, { 40, 40, 40 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(glk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        Plaintext plain;
+        vector<uint64_t> plain_vec{ 1, 2, 3, 4, 5, 6, 7, 8 };
+        batch_encoder.encode(plain_vec, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        evaluator.rotate_columns_inplace(encrypted, glk);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 5, 6, 7, 8, 1, 2, 3, 4 }));
+
+        evaluator.rotate_rows_inplace(encrypted, -1, glk);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 8, 5, 6, 7, 4, 1, 2, 3 }));
+
+        evaluator.mod_switch_to_next_inplace(encrypted);
+        evaluator.rotate_rows_inplace(encrypted, 2, glk);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 6, 7, 8, 5, 2, 3, 4, 1 }));
+    }
 } // namespace sealtest
@@ -7,6 +7,9 @@
 #include "seal/modulus.h"
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/uintcore.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
 #include <vector>
 #include "gtest/gtest.h"
 
@@ -203,4 +206,152 @@ namespace sealtest
             compare_kswitchkeys(keys, test_keys, secret_key, context);
         }
     }
+
+    TEST(GaloisKeysTest, GaloisKeysLazyLoad)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(65537);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 60, 60 }));
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+
+        stringstream stream;
+        auto seeded_keys = keygen.create_galois_keys(vector<int>{ 1, 2 });
+        auto seeded_size = seeded_keys.save(stream, compr_mode_type::none);
+        GaloisKeys lazy_keys;
+        lazy_keys.load_lazy(context, stream, 1);
+        ASSERT_TRUE(lazy_keys.is_lazy());
+        ASSERT_EQ(2ULL, lazy_keys.size());
+        ASSERT_TRUE(lazy_keys.parms_id() == context.key_parms_id());
+
+        auto galois_tool = context.key_context_data()->galois_tool();
+        uint32_t elt1 = galois_tool->get_elt_from_step(1);
+        uint32_t elt2 = galois_tool->get_elt_from_step(2);
+        ASSERT_TRUE(lazy_keys.has_key(elt1));
+        ASSERT_TRUE(lazy_keys.has_key(elt2));
+        ASSERT_FALSE(lazy_keys.has_key(galois_tool->get_elt_from_step(3)));
+        ASSERT_THROW(static_cast<void>(lazy_keys.key(elt1)), logic_error);
+
+        // Expanded keys match eagerly loaded keys
+        GaloisKeys keys;
+        seeded_keys.save(stream);
+        keys.load(context, stream);
+        auto key1 = lazy_keys.acquire_key(context, elt1);
+        ASSERT_EQ(keys.key(elt1).size(), key1->size());
+        for (size_t i = 0; i < key1->size(); i++)
+        {
+            ASSERT_EQ(keys.key(elt1)[i].data().dyn_array().size(), (*key1)[i].data().dyn_array().size());
+            ASSERT_TRUE(is_equal_uint(
+                keys.key(elt1)[i].data().data(), (*key1)[i].data().data(), (*key1)[i].data().dyn_array().size()));
+        }
+        ASSERT_EQ(1ULL, lazy_keys.cached_key_count());
+
+        // Evicting does not invalidate keys that are still held
+        auto key2 = lazy_keys.acquire_key(context, elt2);
+        ASSERT_EQ(1ULL, lazy_keys.cached_key_count());
+        ASSERT_EQ(keys.key(elt1).size(), key1->size());
+        ASSERT_EQ(keys.key(elt2).size(), key2->size());
+
+        // Saving writes back the seeded form
+        ASSERT_EQ(seeded_size, lazy_keys.save(stream, compr_mode_type::none));
+        GaloisKeys test_keys;
+        test_keys.load(context, stream);
+        ASSERT_EQ(keys.size(), test_keys.size());
+
+        // Copies share the seeded data
+        GaloisKeys copy_keys = lazy_keys;
+        ASSERT_TRUE(copy_keys.is_lazy());
+        ASSERT_TRUE(copy_keys.has_key(elt2));
+    }
+
+#ifdef SEAL_USE_MMAP
+    TEST(GaloisKeysTest, GaloisKeysSaveLoadMapped)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(65537);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 60, 60 }));
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+
+        GaloisKeys keys;
+        keygen.create_galois_keys(vector<int>{ 1, -3 }, keys);
+
+        string path = "sealtest_galoiskeys.map";
+        {
+            ofstream file(path, ios::binary);
+            keys.save_mapped(file);
+        }
+
+        GaloisKeys mapped_keys;
+        mapped_keys.load_mapped(context, path);
+        ASSERT_TRUE(mapped_keys.is_mapped());
+        ASSERT_TRUE(keys.parms_id() == mapped_keys.parms_id());
+        ASSERT_EQ(keys.size(), mapped_keys.size());
+        ASSERT_EQ(keys.data().size(), mapped_keys.data().size());
+        for (size_t j = 0; j < keys.data().size(); j++)
+        {
+            ASSERT_EQ(keys.data()[j].size(), mapped_keys.data()[j].size());
+            for (size_t i = 0; i < keys.data()[j].size(); i++)
+            {
+                auto &key = keys.data()[j][i].data();
+                auto &mapped_key = mapped_keys.data()[j][i].data();
+                ASSERT_TRUE(mapped_key.is_ntt_form());
+                ASSERT_EQ(0, reinterpret_cast<uintptr_t>(mapped_key.data()) % 64);
+                ASSERT_EQ(key.dyn_array().size(), mapped_key.dyn_array().size());
+                ASSERT_TRUE(is_equal_uint(key.data(), mapped_key.data(), key.dyn_array().size()));
+            }
+        }
+
+        // Evicted keys are read back from the file
+        auto index = GaloisKeys::get_index(context.key_context_data()->galois_tool()->get_elt_from_step(1));
+        mapped_keys.evict_mapped(index);
+        ASSERT_TRUE(is_equal_uint(
+            keys.data()[index][0].data().data(), mapped_keys.data()[index][0].data().data(),
+            keys.data()[index][0].data().dyn_array().size()));
+        mapped_keys.prefetch_mapped(index);
+
+        // Writes go to a private copy of the page and never reach the file
+        auto &key = keys.data()[index][0].data();
+        auto mapped_data = mapped_keys.data()[index][0].data().data();
+        mapped_data[0] ^= 1;
+        ASSERT_EQ(key.data()[0] ^ 1, mapped_data[0]);
+        GaloisKeys other_mapped_keys;
+        other_mapped_keys.load_mapped(context, path);
+        ASSERT_TRUE(
+            is_equal_uint(key.data(), other_mapped_keys.data()[index][0].data().data(), key.dyn_array().size()));
+
+        // Evicting discards the write
+        mapped_keys.evict_mapped(index);
+        ASSERT_TRUE(is_equal_uint(key.data(), mapped_data, key.dyn_array().size()));
+
+        // Copies do not refer to the file
+        GaloisKeys copy_constructed_keys(mapped_keys);
+        ASSERT_FALSE(copy_constructed_keys.is_mapped());
+        ASSERT_TRUE(mapped_keys.is_mapped());
+        GaloisKeys copy_keys;
+        copy_keys = mapped_keys;
+        ASSERT_FALSE(copy_keys.is_mapped());
+        mapped_keys = GaloisKeys();
+        ASSERT_FALSE(mapped_keys.is_mapped());
+        ASSERT_TRUE(is_equal_uint(
+            keys.data()[index][0].data().data(), copy_keys.data()[index][0].data().data(),
+            keys.data()[index][0].data().dyn_array().size()));
+        ASSERT_TRUE(is_equal_uint(
+            keys.data()[index][0].data().data(), copy_constructed_keys.data()[index][0].data().data(),
+            keys.data()[index][0].data().dyn_array().size()));
+
+        // Keys for other parameters are rejected
+        EncryptionParameters parms2(scheme_type::bfv);
+        parms2.set_poly_modulus_degree(64);
+        parms2.set_plain_modulus(65537);
+        parms2.set_coeff_modulus(CoeffModulus::Create(64, { 50, 60 }));
+        SEALContext context2(parms2, false, sec_level_type::none);
+        ASSERT_THROW(mapped_keys.load_mapped(context2, path), logic_error);
+        ASSERT_FALSE(mapped_keys.is_mapped());
+
+        remove(path.c_str());
+    }
+#endif
 } // namespace sealtest
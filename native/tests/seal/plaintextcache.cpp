@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/ckks.h"
+#include "seal/context.h"
+#include "seal/modulus.h"
+#include "seal/plaintextcache.h"
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace std;
+
+namespace sealtest
+{
+    TEST(PlaintextCacheTest, DeriveLevels)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        parms.set_poly_modulus_degree(32);
+        parms.set_coeff_modulus(CoeffModulus::Create(32, { 50, 40, 40, 50 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        CKKSEncoder encoder(context);
+        size_t plain_bytes = 32 * sizeof(uint64_t);
+
+        vector<double> weights(16);
+        for (size_t i = 0; i < weights.size(); i++)
+        {
+            weights[i] = static_cast<double>(i) / 3 - 2;
+        }
+        vector<complex<double>> constants(16, complex<double>(0.5, -1.5));
+        double scale = pow(2.0, 30);
+        auto first_parms_id = context.first_parms_id();
+        auto second_parms_id = context.first_context_data()->next_context_data()->parms_id();
+        auto last_parms_id = context.last_parms_id();
+
+        PlaintextCache cache(context, 100 * plain_bytes);
+        ASSERT_EQ(cache_eviction_policy::lru, cache.eviction());
+
+        // A lower level is derived from the first level, which is cached along the way
+        auto plain = cache.get(1, weights, last_parms_id, scale);
+        ASSERT_EQ(2ULL, cache.entry_count());
+        ASSERT_EQ(4 * plain_bytes, cache.size());
+        Plaintext expected;
+        encoder.encode(weights, last_parms_id, scale, expected);
+        ASSERT_TRUE(expected == *plain);
+        ASSERT_TRUE(last_parms_id == plain->parms_id());
+        ASSERT_EQ(scale, plain->scale());
+
+        // Hits return the same plaintext
+        ASSERT_TRUE(plain == cache.get(1, weights, last_parms_id, scale));
+        ASSERT_EQ(2ULL, cache.entry_count());
+
+        auto first_plain = cache.get(1, weights, first_parms_id, scale);
+        encoder.encode(weights, first_parms_id, scale, expected);
+        ASSERT_TRUE(expected == *first_plain);
+        ASSERT_EQ(2ULL, cache.entry_count());
+
+        auto second_plain = cache.get(1, weights, second_parms_id, scale);
+        encoder.encode(weights, second_parms_id, scale, expected);
+        ASSERT_TRUE(expected == *second_plain);
+        ASSERT_EQ(3ULL, cache.entry_count());
+
+        // Different scales and sources are separate entries
+        auto scaled_plain = cache.get(1, weights, second_parms_id, scale * 2);
+        encoder.encode(weights, second_parms_id, scale * 2, expected);
+        ASSERT_TRUE(expected == *scaled_plain);
+        auto constant_plain = cache.get(2, constants, second_parms_id, scale);
+        encoder.encode(constants, second_parms_id, scale, expected);
+        ASSERT_TRUE(expected == *constant_plain);
+        ASSERT_EQ(7ULL, cache.entry_count());
+
+        cache.erase(1);
+        ASSERT_EQ(2ULL, cache.entry_count());
+        ASSERT_EQ(5 * plain_bytes, cache.size());
+        ASSERT_TRUE(constant_plain == cache.get(2, constants, second_parms_id, scale));
+
+        // Values too large for a lower level are encoded at that level, where encoding fails
+        vector<double> large_values(16, pow(2.0, 60));
+        ASSERT_NO_THROW(plain = cache.get(3, large_values, first_parms_id, scale));
+        ASSERT_THROW(plain = cache.get(3, large_values, last_parms_id, scale), invalid_argument);
+
+        cache.clear();
+        ASSERT_EQ(0ULL, cache.entry_count());
+        ASSERT_EQ(0ULL, cache.size());
+
+        ASSERT_THROW(plain = cache.get(1, weights, context.key_parms_id(), scale), invalid_argument);
+        ASSERT_THROW(plain = cache.get(1, weights, parms_id_zero, scale), invalid_argument);
+        ASSERT_THROW(plain = cache.get(1, vector<double>(17), first_parms_id, scale), invalid_argument);
+    }
+
+    TEST(PlaintextCacheTest, Eviction)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        parms.set_poly_modulus_degree(32);
+        parms.set_coeff_modulus(CoeffModulus::Create(32, { 50, 40, 40, 50 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        size_t plain_bytes = 32 * sizeof(uint64_t);
+        double scale = pow(2.0, 30);
+        auto first_parms_id = context.first_parms_id();
+        vector<double> values(16, 1.0);
+
+        // Each first level plaintext has three RNS components
+        PlaintextCache lru_cache(context, 7 * plain_bytes, cache_eviction_policy::lru);
+        auto plain1 = lru_cache.get(1, values, first_parms_id, scale);
+        auto plain2 = lru_cache.get(2, values, first_parms_id, scale);
+        ASSERT_TRUE(plain1 == lru_cache.get(1, values, first_parms_id, scale));
+        auto plain3 = lru_cache.get(3, values, first_parms_id, scale);
+        ASSERT_EQ(2ULL, lru_cache.entry_count());
+        ASSERT_TRUE(plain1 == lru_cache.get(1, values, first_parms_id, scale));
+        ASSERT_FALSE(plain2 == lru_cache.get(2, values, first_parms_id, scale));
+
+        PlaintextCache fifo_cache(context, 7 * plain_bytes, cache_eviction_policy::fifo);
+        plain1 = fifo_cache.get(1, values, first_parms_id, scale);
+        plain2 = fifo_cache.get(2, values, first_parms_id, scale);
+        ASSERT_TRUE(plain1 == fifo_cache.get(1, values, first_parms_id, scale));
+        plain3 = fifo_cache.get(3, values, first_parms_id, scale);
+        ASSERT_TRUE(plain2 == fifo_cache.get(2, values, first_parms_id, scale));
+        ASSERT_FALSE(plain1 == fifo_cache.get(1, values, first_parms_id, scale));
+
+        PlaintextCache none_cache(context, 7 * plain_bytes, cache_eviction_policy::none);
+        plain1 = none_cache.get(1, values, first_parms_id, scale);
+        plain2 = none_cache.get(2, values, first_parms_id, scale);
+        plain3 = none_cache.get(3, values, first_parms_id, scale);
+        ASSERT_EQ(2ULL, none_cache.entry_count());
+        ASSERT_TRUE(plain1 == none_cache.get(1, values, first_parms_id, scale));
+        ASSERT_FALSE(plain3 == none_cache.get(3, values, first_parms_id, scale));
+
+        // Evicted plaintexts remain valid, and nothing is cached without capacity
+        ASSERT_EQ(3 * 32ULL, plain3->coeff_count());
+        PlaintextCache empty_cache(context, 0);
+        plain1 = empty_cache.get(1, values, context.last_parms_id(), scale);
+        ASSERT_EQ(0ULL, empty_cache.entry_count());
+        ASSERT_TRUE(context.last_parms_id() == plain1->parms_id());
+    }
+} // namespace sealtest
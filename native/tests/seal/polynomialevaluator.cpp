@@ -0,0 +1,286 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/batchencoder.h"
+#include "seal/ckks.h"
+#include "seal/context.h"
+#include "seal/decryptor.h"
+#include "seal/encryptor.h"
+#include "seal/keygenerator.h"
+#include "seal/modulus.h"
+#include "seal/polynomialevaluator.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace std;
+
+namespace sealtest
+{
+    namespace
+    {
+        // Evaluates a polynomial in the given basis modulo t
+        uint64_t evaluate_mod(const vector<int64_t> &coeffs, poly_basis_type basis, uint64_t x, uint64_t t)
+        {
+            uint64_t result = 0;
+            uint64_t prev = 1;
+            uint64_t curr = x % t;
+            for (size_t i = 0; i < coeffs.size(); i++)
+            {
+                uint64_t term = 1;
+                if (basis == poly_basis_type::power)
+                {
+                    for (size_t j = 0; j < i; j++)
+                    {
+                        term = (term * x) % t;
+                    }
+                }
+                else if (i == 0)
+                {
+                    term = 1;
+                }
+                else
+                {
+                    term = curr;
+                    uint64_t next = (2 * x % t * curr % t + t - prev) % t;
+                    prev = curr;
+                    curr = next;
+                }
+                int64_t signed_t = static_cast<int64_t>(t);
+                uint64_t coeff = static_cast<uint64_t>(coeffs[i] % signed_t + signed_t) % t;
+                result = (result + coeff * term) % t;
+            }
+            return result;
+        }
+
+        double evaluate_real(const vector<double> &coeffs, poly_basis_type basis, double x)
+        {
+            double result = 0;
+            double prev = 1;
+            double curr = x;
+            for (size_t i = 0; i < coeffs.size(); i++)
+            {
+                double term = 1;
+                if (basis == poly_basis_type::power)
+                {
+                    term = pow(x, static_cast<double>(i));
+                }
+                else if (i > 0)
+                {
+                    term = curr;
+                    double next = 2 * x * curr - prev;
+                    prev = curr;
+                    curr = next;
+                }
+                result += coeffs[i] * term;
+            }
+            return result;
+        }
+    } // namespace
+
+    TEST(PolynomialEvaluatorTest, MultiplicationCount)
+    {
+        ASSERT_THROW(static_cast<void>(PolynomialEvaluator::MultiplicationCount(0)), invalid_argument);
+        ASSERT_EQ(0ULL, PolynomialEvaluator::MultiplicationCount(1));
+        ASSERT_EQ(1ULL, PolynomialEvaluator::MultiplicationCount(2));
+        ASSERT_EQ(4ULL, PolynomialEvaluator::MultiplicationCount(7));
+        ASSERT_EQ(16ULL, PolynomialEvaluator::MultiplicationCount(63));
+
+        // Far fewer than the degree for high-degree polynomials
+        ASSERT_TRUE(PolynomialEvaluator::MultiplicationCount(1023) < 100);
+    }
+
+    TEST(PolynomialEvaluatorTest, BFVEvaluateDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        size_t poly_modulus_degree = 64;
+        parms.set_poly_modulus_degree(poly_modulus_degree);
+        parms.set_plain_modulus(PlainModulus::Batching(poly_modulus_degree, 20));
+        parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 60, 60, 60, 60, 60 }));
+        SEALContext context(parms, false, sec_level_type::none);
+        uint64_t t = parms.plain_modulus().value();
+
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+
+        BatchEncoder encoder(context);
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+        PolynomialEvaluator evaluator(context);
+
+        vector<uint64_t> input(poly_modulus_degree);
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            input[i] = (i * 7919 + 3) % t;
+        }
+        Plaintext plain;
+        encoder.encode(input, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        vector<vector<int64_t>> polys{ { 3, 1 },
+                                       { 0, 0, 1 },
+                                       { 5, -2, 0, 7 },
+                                       { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 },
+                                       { -4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9 } };
+        for (auto basis : { poly_basis_type::power, poly_basis_type::chebyshev })
+        {
+            for (auto &coeffs : polys)
+            {
+                Ciphertext result;
+                evaluator.evaluate(encrypted, coeffs, basis, rlk, result);
+                ASSERT_TRUE(decryptor.invariant_noise_budget(result) > 0);
+
+                Plaintext plain_result;
+                decryptor.decrypt(result, plain_result);
+                vector<uint64_t> output;
+                encoder.decode(plain_result, output);
+                for (size_t i = 0; i < input.size(); i++)
+                {
+                    ASSERT_EQ(evaluate_mod(coeffs, basis, input[i], t), output[i]);
+                }
+            }
+        }
+
+        Ciphertext result;
+        ASSERT_THROW(
+            evaluator.evaluate(encrypted, vector<int64_t>{ 5 }, poly_basis_type::power, rlk, result), invalid_argument);
+        ASSERT_THROW(
+            evaluator.evaluate(encrypted, vector<double>{ 1.0, 1.0 }, poly_basis_type::power, rlk, result),
+            logic_error);
+    }
+
+    TEST(PolynomialEvaluatorTest, CKKSEvaluateDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slot_count = 32;
+        parms.set_poly_modulus_degree(slot_count * 2);
+        parms.set_coeff_modulus(CoeffModulus::Create(slot_count * 2, { 60, 40, 40, 40, 40, 40, 40, 40, 60 }));
+        SEALContext context(parms, true, sec_level_type::none);
+
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+
+        CKKSEncoder encoder(context);
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+        PolynomialEvaluator evaluator(context);
+
+        vector<double> input(slot_count);
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            input[i] = -1.0 + 2.0 * static_cast<double>(i) / static_cast<double>(slot_count - 1);
+        }
+        double scale = pow(2.0, 40);
+        Plaintext plain;
+        encoder.encode(input, scale, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        vector<vector<double>> polys{ { 0.5, -1.0 }, { 0.1, 0.2, -0.3, 0.4, -0.5, 0.6, -0.7, 0.8 } };
+
+        // Sparse polynomial of degree 15
+        polys.emplace_back(16, 0.0);
+        polys.back()[0] = 0.25;
+        polys.back()[2] = -0.5;
+        polys.back()[15] = 0.3;
+
+        // Dense polynomial of degree 27
+        polys.emplace_back();
+        for (size_t i = 0; i < 28; i++)
+        {
+            polys.back().push_back(0.05 * static_cast<double>((i * 7) % 11) - 0.25);
+        }
+        for (auto basis : { poly_basis_type::power, poly_basis_type::chebyshev })
+        {
+            for (auto &coeffs : polys)
+            {
+                Ciphertext result;
+                evaluator.evaluate(encrypted, coeffs, basis, rlk, result);
+                ASSERT_DOUBLE_EQ(scale, result.scale());
+
+                Plaintext plain_result;
+                decryptor.decrypt(result, plain_result);
+                vector<double> output;
+                encoder.decode(plain_result, output);
+                for (size_t i = 0; i < slot_count; i++)
+                {
+                    ASSERT_NEAR(evaluate_real(coeffs, basis, input[i]), output[i], 0.01);
+                }
+            }
+        }
+
+        // Not enough levels for a polynomial of degree 256
+        vector<double> coeffs(257, 0.0);
+        coeffs.back() = 1.0;
+        Ciphertext result;
+        ASSERT_THROW(evaluator.evaluate(encrypted, coeffs, poly_basis_type::power, rlk, result), invalid_argument);
+        ASSERT_THROW(
+            evaluator.evaluate(encrypted, vector<int64_t>{ 1, 1 }, poly_basis_type::power, rlk, result), logic_error);
+    }
+
+    TEST(PolynomialEvaluatorTest, CKKSEvaluateDecryptPrimesFarFromScale)
+    {
+        // Every rescaling divides by about 4 times the scale, so the scales of intermediate results keep shrinking
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slot_count = 32;
+        parms.set_poly_modulus_degree(slot_count * 2);
+        parms.set_coeff_modulus(CoeffModulus::Create(slot_count * 2, { 60, 42, 42, 42, 42, 42, 60 }));
+        SEALContext context(parms, true, sec_level_type::none);
+
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+
+        CKKSEncoder encoder(context);
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+        PolynomialEvaluator evaluator(context);
+
+        vector<double> input(slot_count);
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            input[i] = -1.0 + 2.0 * static_cast<double>(i) / static_cast<double>(slot_count - 1);
+        }
+        double scale = pow(2.0, 40);
+        Plaintext plain;
+        encoder.encode(input, scale, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        vector<vector<double>> polys{ { 0.1, 0.2, -0.3, 0.4, -0.5, 0.6, -0.7, 0.8 } };
+        polys.emplace_back(16, 0.0);
+        polys.back()[1] = 0.5;
+        polys.back()[3] = -0.25;
+        polys.back()[15] = 0.3;
+        for (auto basis : { poly_basis_type::power, poly_basis_type::chebyshev })
+        {
+            for (auto &coeffs : polys)
+            {
+                Ciphertext result;
+                evaluator.evaluate(encrypted, coeffs, basis, rlk, result);
+                ASSERT_DOUBLE_EQ(scale, result.scale());
+
+                Plaintext plain_result;
+                decryptor.decrypt(result, plain_result);
+                vector<double> output;
+                encoder.decode(plain_result, output);
+                for (size_t i = 0; i < slot_count; i++)
+                {
+                    ASSERT_NEAR(evaluate_real(coeffs, basis, input[i]), output[i], 0.01);
+                }
+            }
+        }
+    }
+} // namespace sealtest
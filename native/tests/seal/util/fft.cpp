@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/ckks.h"
+#include "seal/util/croots.h"
+#include "seal/util/fft.h"
+#include "seal/util/uintcore.h"
+#include <complex>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+namespace sealtest
+{
+    namespace util
+    {
+        TEST(FFTTest, SplitTransformMatchesDWTHandler)
+        {
+            using FFTHandler = DWTHandler<complex<double>, complex<double>, double>;
+            FFTHandler fft_handler(Arithmetic<complex<double>, complex<double>, double>{});
+            mt19937_64 engine(0);
+            uniform_real_distribution<double> dist(-1.0, 1.0);
+
+            for (int log_n = 1; log_n <= 6; log_n++)
+            {
+                size_t n = size_t(1) << log_n;
+                ComplexRoots complex_roots(n << 2, MemoryManager::GetPool());
+                vector<complex<double>> roots(n);
+                vector<complex<double>> inv_roots(n);
+                vector<double> roots_split(n << 1, 0);
+                vector<double> inv_roots_split(n << 1, 0);
+                for (size_t i = 1; i < n; i++)
+                {
+                    roots[i] = complex_roots.get_root(reverse_bits(i, log_n) << 1);
+                    inv_roots[i] = conj(complex_roots.get_root((reverse_bits(i - 1, log_n) + 1) << 1));
+                    roots_split[i] = roots[i].real();
+                    roots_split[i + n] = roots[i].imag();
+                    inv_roots_split[i] = inv_roots[i].real();
+                    inv_roots_split[i + n] = inv_roots[i].imag();
+                }
+
+                vector<complex<double>> values(n);
+                vector<double> values_split(n << 1);
+                for (size_t i = 0; i < n; i++)
+                {
+                    values[i] = complex<double>(dist(engine), dist(engine));
+                    values_split[i] = values[i].real();
+                    values_split[i + n] = values[i].imag();
+                }
+
+                fft_handler.transform_to_rev(values.data(), log_n, roots.data());
+                split_transform_to_rev(
+                    values_split.data(), values_split.data() + n, log_n, roots_split.data(), roots_split.data() + n);
+                for (size_t i = 0; i < n; i++)
+                {
+                    ASSERT_NEAR(values[i].real(), values_split[i], 1e-12);
+                    ASSERT_NEAR(values[i].imag(), values_split[i + n], 1e-12);
+                }
+
+                double scalar = 1.0 / static_cast<double>(n);
+                fft_handler.transform_from_rev(values.data(), log_n, inv_roots.data(), &scalar);
+                split_transform_from_rev(
+                    values_split.data(), values_split.data() + n, log_n, inv_roots_split.data(),
+                    inv_roots_split.data() + n, scalar);
+                for (size_t i = 0; i < n; i++)
+                {
+                    ASSERT_NEAR(values[i].real(), values_split[i], 1e-12);
+                    ASSERT_NEAR(values[i].imag(), values_split[i + n], 1e-12);
+                }
+
+                multiply_split_complex(
+                    values_split.data(), values_split.data() + n, roots_split.data(), roots_split.data() + n, n, true);
+                for (size_t i = 0; i < n; i++)
+                {
+                    complex<double> expected = values[i] * conj(roots[i]);
+                    ASSERT_NEAR(expected.real(), values_split[i], 1e-12);
+                    ASSERT_NEAR(expected.imag(), values_split[i + n], 1e-12);
+                }
+            }
+        }
+    } // namespace util
+} // namespace sealtest
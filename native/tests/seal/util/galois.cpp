@@ -111,5 +111,54 @@ namespace sealtest
                 ASSERT_EQ(out_true[i], out[i]);
             }
         }
+
+        TEST(GaloisToolTest, ApplyGaloisNTTPrecomputed)
+        {
+            EncryptionParameters parms(scheme_type::ckks);
+            parms.set_poly_modulus_degree(8);
+            parms.set_coeff_modulus({ 17 });
+            ASSERT_THROW(SEALContext(parms, false, sec_level_type::none, { 2 }), invalid_argument);
+            ASSERT_THROW(SEALContext(parms, false, sec_level_type::none, { 17 }), invalid_argument);
+
+            SEALContext context(parms, false, sec_level_type::none, { 3, 15 });
+            auto galois_tool = context.key_context_data()->galois_tool();
+            ASSERT_TRUE(galois_tool->is_precomputed(3));
+            ASSERT_TRUE(galois_tool->is_precomputed(15));
+            ASSERT_FALSE(galois_tool->is_precomputed(5));
+            ASSERT_FALSE(galois_tool->is_precomputed(4));
+            ASSERT_FALSE(galois_tool->is_precomputed(17));
+
+            uint64_t in[8]{ 0, 1, 2, 3, 4, 5, 6, 7 };
+            uint64_t out[8];
+            uint64_t out_true[8]{ 4, 5, 7, 6, 1, 0, 2, 3 };
+            galois_tool->apply_galois_ntt(in, 3, out);
+            for (size_t i = 0; i < 8; i++)
+            {
+                ASSERT_EQ(out_true[i], out[i]);
+            }
+
+            // Precomputed and lazily generated tables agree, also when indices do not fit in 16 bits
+            auto pool = MemoryManager::GetPool();
+            for (int coeff_count_power : { 3, 17 })
+            {
+                size_t coeff_count = size_t(1) << coeff_count_power;
+                uint32_t galois_elt = static_cast<uint32_t>(2 * coeff_count - 1);
+                GaloisTool lazy_tool(coeff_count_power, pool);
+                GaloisTool eager_tool(coeff_count_power, { galois_elt }, pool);
+                ASSERT_FALSE(lazy_tool.is_precomputed(galois_elt));
+                ASSERT_TRUE(eager_tool.is_precomputed(galois_elt));
+
+                vector<uint64_t> values(coeff_count);
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    values[i] = i;
+                }
+                vector<uint64_t> lazy_out(coeff_count);
+                vector<uint64_t> eager_out(coeff_count);
+                lazy_tool.apply_galois_ntt(values.data(), galois_elt, lazy_out.data());
+                eager_tool.apply_galois_ntt(values.data(), galois_elt, eager_out.data());
+                ASSERT_TRUE(lazy_out == eager_out);
+            }
+        }
     } // namespace util
 } // namespace sealtest
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/msgsl-populate"
+  "CMakeFiles/msgsl-populate-complete"
+  "msgsl-populate-prefix/src/msgsl-populate-stamp/msgsl-populate-build"
+  "msgsl-populate-prefix/src/msgsl-populate-stamp/msgsl-populate-configure"
+  "msgsl-populate-prefix/src/msgsl-populate-stamp/msgsl-populate-download"
+  "msgsl-populate-prefix/src/msgsl-populate-stamp/msgsl-populate-install"
+  "msgsl-populate-prefix/src/msgsl-populate-stamp/msgsl-populate-mkdir"
+  "msgsl-populate-prefix/src/msgsl-populate-stamp/msgsl-populate-patch"
+  "msgsl-populate-prefix/src/msgsl-populate-stamp/msgsl-populate-test"
+  "msgsl-populate-prefix/src/msgsl-populate-stamp/msgsl-populate-update"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/msgsl-populate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/thirdparty/msgsl-src"
+  "/root/repo/thirdparty/msgsl-build"
+  "/root/repo/thirdparty/msgsl-subbuild/msgsl-populate-prefix"
+  "/root/repo/thirdparty/msgsl-subbuild/msgsl-populate-prefix/tmp"
+  "/root/repo/thirdparty/msgsl-subbuild/msgsl-populate-prefix/src/msgsl-populate-stamp"
+  "/root/repo/thirdparty/msgsl-subbuild/msgsl-populate-prefix/src"
+  "/root/repo/thirdparty/msgsl-subbuild/msgsl-populate-prefix/src/msgsl-populate-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/thirdparty/msgsl-subbuild/msgsl-populate-prefix/src/msgsl-populate-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/thirdparty/msgsl-subbuild/msgsl-populate-prefix/src/msgsl-populate-stamp${cfgdir}") # cfgdir has leading slash
+endif()